@@ -0,0 +1,1839 @@
+#include <iostream>
+#include <complex>
+#include <random>
+#include <vkFFT.h>
+#include <vkFFT_multigpu.h>
+#include <vkFFT_kernel.h>
+#include <vkFFT_overlap.h>
+#include <vkFFT_distributed.h>
+#include <vkFFT_streaming.h>
+#include <vkFFT_staging.h>
+#include <vkFFT_hostmemory.h>
+#include <vkFFT_scheduler.h>
+#include <vulkan/vulkan.h>
+#include <string.h>
+#include "VkFFT_utils.h"
+
+//VkFFT accuracy check against double-precision CPU reference.
+//Forward transforms are compared to the exp(-i) reference DFT where the output layout is known (1D C2C, 1D R2C and small 2D C2C, fused and per-axis). Other plans leave the spectrum in VkFFT internal layout, so they are checked with FFT + iFFT round trips
+//and with convolutions, which return to natural layout and are compared to the CPU circular convolution. Sizes cover both transposed and grouped (non-transposed) paths.
+//Reports max and RMS error relative to the reference magnitude, returns non-zero exit code if any case exceeds the tolerance.
+//Multi-GPU slab and pencil decompositions are checked against the 3D reference with several logical devices created on the same physical device,
+//pencil ranks run in threads connected by the loopback transport.
+//No validation layers are enabled, so it can run on software implementations (lavapipe, SwiftShader).
+//Usage: VkFFT_accuracy [-device id] [-tolerance t] [-slab_devices n] [-pencil_grid Pr Pc] [-quick]
+
+typedef std::complex<double> cpx;
+
+typedef struct {
+	const char* name;
+	uint32_t dataVectorDimension;
+	uint32_t kernelVectorDimension;
+	bool symmetricKernel;
+	uint32_t outputVectorDimension;//0 - same as data. Kernel matrix convolutions (set here or more than 3 data systems) write outputs after the inputs
+	bool correlation;
+	uint32_t filterBankSize;//output a is data system a/filterBankSize convolved with kernel a%filterBankSize
+} ConvolutionMode;
+
+const ConvolutionMode convolutionModes[] = {
+	{ "1x1", 1, 1, false, 0, false },
+	{ "symmetric_2x2", 2, 3, true, 0, false },
+	{ "nonsymmetric_2x2", 2, 4, false, 0, false },
+	{ "symmetric_3x3", 3, 6, true, 0, false },
+	{ "nonsymmetric_3x3", 3, 9, false, 0, false },
+	{ "matrix_2to6", 2, 12, false, 6, false },
+	{ "matrix_5x5", 5, 25, false, 0, false },
+	{ "correlation_1x1", 1, 1, false, 0, true },
+	{ "correlation_symmetric_2x2", 2, 3, true, 0, true },
+	{ "correlation_nonsymmetric_2x2", 2, 4, false, 0, true },
+	{ "correlation_symmetric_3x3", 3, 6, true, 0, true },
+	{ "correlation_nonsymmetric_3x3", 3, 9, false, 0, true },
+	{ "correlation_matrix_2to6", 2, 12, false, 6, true },
+	{ "filter_bank_2x3", 2, 3, false, 6, false, 3 },
+};
+
+void submitCopy(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size) {
+	VkCommandBufferAllocateInfo commandBufferAllocateInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
+	commandBufferAllocateInfo.commandPool = commandPool;
+	commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+	commandBufferAllocateInfo.commandBufferCount = 1;
+	VkCommandBuffer commandBuffer = {};
+	vkAllocateCommandBuffers(device, &commandBufferAllocateInfo, &commandBuffer);
+	VkCommandBufferBeginInfo commandBufferBeginInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+	commandBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+	vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo);
+	VkBufferCopy copyRegion = {};
+	copyRegion.size = size;
+	vkCmdCopyBuffer(commandBuffer, srcBuffer, dstBuffer, 1, &copyRegion);
+	vkEndCommandBuffer(commandBuffer);
+	VkSubmitInfo submitInfo = { VK_STRUCTURE_TYPE_SUBMIT_INFO };
+	submitInfo.commandBufferCount = 1;
+	submitInfo.pCommandBuffers = &commandBuffer;
+	vkQueueSubmit(queue, 1, &submitInfo, fence);
+	vkWaitForFences(device, 1, &fence, VK_TRUE, 100000000000);
+	vkResetFences(device, 1, &fence);
+	vkFreeCommandBuffers(device, commandPool, 1, &commandBuffer);
+}
+
+void transferDataFromCPU(float* arr, VkBuffer buffer, VkDeviceSize bufferSize) {
+	VkBuffer stagingBuffer = {};
+	VkDeviceMemory stagingBufferMemory = {};
+	if (allocateFFTBuffer(&stagingBuffer, &stagingBufferMemory, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, bufferSize) != VK_SUCCESS)
+		throw std::runtime_error("buffer allocation failed");
+	void* data;
+	vkMapMemory(device, stagingBufferMemory, 0, bufferSize, 0, &data);
+	memcpy(data, arr, bufferSize);
+	vkUnmapMemory(device, stagingBufferMemory);
+	submitCopy(stagingBuffer, buffer, bufferSize);
+	vkDestroyBuffer(device, stagingBuffer, NULL);
+	vkFreeMemory(device, stagingBufferMemory, NULL);
+}
+
+void transferDataToCPU(float* arr, VkBuffer buffer, VkDeviceSize bufferSize) {
+	VkBuffer stagingBuffer = {};
+	VkDeviceMemory stagingBufferMemory = {};
+	if (allocateFFTBuffer(&stagingBuffer, &stagingBufferMemory, VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, bufferSize) != VK_SUCCESS)
+		throw std::runtime_error("buffer allocation failed");
+	submitCopy(buffer, stagingBuffer, bufferSize);
+	void* data;
+	vkMapMemory(device, stagingBufferMemory, 0, bufferSize, 0, &data);
+	memcpy(arr, data, bufferSize);
+	vkUnmapMemory(device, stagingBufferMemory);
+	vkDestroyBuffer(device, stagingBuffer, NULL);
+	vkFreeMemory(device, stagingBufferMemory, NULL);
+}
+
+void performVulkanFFT(std::vector<VkFFT::VkFFTApplication*> apps) {
+	VkCommandBufferAllocateInfo commandBufferAllocateInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
+	commandBufferAllocateInfo.commandPool = commandPool;
+	commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+	commandBufferAllocateInfo.commandBufferCount = 1;
+	VkCommandBuffer commandBuffer = {};
+	vkAllocateCommandBuffers(device, &commandBufferAllocateInfo, &commandBuffer);
+	VkCommandBufferBeginInfo commandBufferBeginInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+	commandBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+	vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo);
+	VkMemoryBarrier memory_barrier = { VK_STRUCTURE_TYPE_MEMORY_BARRIER, nullptr, VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT };
+	for (uint32_t i = 0; i < apps.size(); i++) {
+		apps[i]->VkFFTAppend(commandBuffer);
+		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
+	}
+	vkEndCommandBuffer(commandBuffer);
+	VkSubmitInfo submitInfo = { VK_STRUCTURE_TYPE_SUBMIT_INFO };
+	submitInfo.commandBufferCount = 1;
+	submitInfo.pCommandBuffers = &commandBuffer;
+	vkQueueSubmit(queue, 1, &submitInfo, fence);
+	vkWaitForFences(device, 1, &fence, VK_TRUE, 100000000000);
+	vkResetFences(device, 1, &fence);
+	vkFreeCommandBuffers(device, commandPool, 1, &commandBuffer);
+}
+
+//CPU reference: radix-2 FFT in double precision along one axis of a size[0]*size[1]*size[2] system, sign -1 - forward, 1 - inverse (not normalized)
+void referenceFFTAxis(cpx* data, uint32_t* size, uint32_t axis, int sign) {
+	uint32_t n = size[axis];
+	uint32_t stride = (axis == 0) ? 1 : ((axis == 1) ? size[0] : size[0] * size[1]);
+	uint32_t lines = size[0] * size[1] * size[2] / n;
+	std::vector<cpx> line(n);
+	for (uint32_t l = 0; l < lines; l++) {
+		uint32_t start = (l % stride) + (l / stride) * stride * n;
+		for (uint32_t i = 0; i < n; i++)
+			line[i] = data[start + i * stride];
+		for (uint32_t i = 1, j = 0; i < n; i++) {
+			uint32_t bit = n >> 1;
+			for (; j & bit; bit >>= 1)
+				j ^= bit;
+			j ^= bit;
+			if (i < j) std::swap(line[i], line[j]);
+		}
+		for (uint32_t len = 2; len <= n; len <<= 1) {
+			double angle = sign * 2 * M_PI / len;
+			for (uint32_t i = 0; i < n; i += len) {
+				for (uint32_t k = 0; k < len / 2; k++) {
+					cpx w = std::polar(1.0, angle * k);
+					cpx u = line[i + k];
+					cpx v = line[i + k + len / 2] * w;
+					line[i + k] = u + v;
+					line[i + k + len / 2] = u - v;
+				}
+			}
+		}
+		for (uint32_t i = 0; i < n; i++)
+			data[start + i * stride] = line[i];
+	}
+}
+
+void referenceFFT(cpx* data, uint32_t* size, uint32_t FFTdim, int sign) {
+	for (uint32_t axis = 0; axis < FFTdim; axis++)
+		referenceFFTAxis(data, size, axis, sign);
+}
+
+//convert between VkFFT buffer layout and natural complex layout. R2C systems store x*y real numbers of each plane followed by 2*y reserved numbers.
+void bufferToComplex(float* buffer, cpx* data, uint32_t* size, bool R2C, uint32_t vectorDimension) {
+	uint64_t systemSize = (uint64_t)size[0] * size[1] * size[2];
+	for (uint32_t v = 0; v < vectorDimension; v++) {
+		for (uint32_t k = 0; k < size[2]; k++) {
+			for (uint32_t j = 0; j < size[1]; j++) {
+				for (uint32_t i = 0; i < size[0]; i++) {
+					uint64_t id = i + j * size[0] + k * size[0] * size[1] + v * systemSize;
+					if (R2C)
+						data[id] = cpx(buffer[i + j * size[0] + k * (size[0] + 2) * size[1] + v * (size[0] + 2) * size[1] * size[2]], 0);
+					else
+						data[id] = cpx(buffer[2 * id], buffer[2 * id + 1]);
+				}
+			}
+		}
+	}
+}
+
+void complexToBuffer(cpx* data, float* buffer, uint32_t* size, bool R2C, uint32_t vectorDimension) {
+	uint64_t systemSize = (uint64_t)size[0] * size[1] * size[2];
+	for (uint32_t v = 0; v < vectorDimension; v++) {
+		for (uint32_t k = 0; k < size[2]; k++) {
+			for (uint32_t j = 0; j < size[1]; j++) {
+				for (uint32_t i = 0; i < size[0]; i++) {
+					uint64_t id = i + j * size[0] + k * size[0] * size[1] + v * systemSize;
+					if (R2C)
+						buffer[i + j * size[0] + k * (size[0] + 2) * size[1] + v * (size[0] + 2) * size[1] * size[2]] = data[id].real();
+					else {
+						buffer[2 * id] = data[id].real();
+						buffer[2 * id + 1] = data[id].imag();
+					}
+				}
+			}
+		}
+	}
+}
+
+void fillRandom(cpx* data, uint64_t elements, bool R2C, std::mt19937* generator) {
+	std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+	for (uint64_t i = 0; i < elements; i++) {
+		double re = distribution(generator[0]);
+		double im = (R2C) ? 0 : distribution(generator[0]);
+		data[i] = cpx(re, im);
+	}
+}
+
+//error relative to the reference magnitude
+void compare(cpx* result, cpx* reference, uint64_t elements, double* maxError, double* rmsError) {
+	double maxDiff = 0, maxReference = 0, sumDiff = 0, sumReference = 0;
+	for (uint64_t i = 0; i < elements; i++) {
+		double diff = std::abs(result[i] - reference[i]);
+		double ref = std::abs(reference[i]);
+		if (diff > maxDiff) maxDiff = diff;
+		if (ref > maxReference) maxReference = ref;
+		sumDiff += diff * diff;
+		sumReference += ref * ref;
+	}
+	maxError[0] = (maxReference > 0) ? maxDiff / maxReference : maxDiff;
+	rmsError[0] = (sumReference > 0) ? sqrt(sumDiff / sumReference) : sqrt(sumDiff);
+}
+
+typedef struct {
+	uint32_t total = 0;
+	uint32_t failed = 0;
+	double tolerance = 1e-4;
+} AccuracyReport;
+
+void report(AccuracyReport* accuracyReport, const char* test, VkFFT::VkFFTConfiguration* configuration, const char* mode, double maxError, double rmsError) {
+	bool passed = (maxError < accuracyReport->tolerance) && (rmsError < accuracyReport->tolerance);
+	accuracyReport->total++;
+	if (!passed) accuracyReport->failed++;
+	printf("%-10s %dD %5dx%5dx%5d %s %-17s max %.3e rms %.3e %s\n", test, configuration->FFTdim, configuration->size[0], configuration->size[1], configuration->size[2], (configuration->performR2C) ? "r2c" : "c2c", mode, maxError, rmsError, (passed) ? "PASS" : "FAIL");
+}
+
+VkDeviceSize bufferSizeOf(VkFFT::VkFFTConfiguration* configuration, uint32_t vectorDimension) {
+	uint32_t sizeX = (configuration->performR2C) ? configuration->size[0] / 2 + 1 : configuration->size[0];
+	return (VkDeviceSize)vectorDimension * sizeof(float) * 2 * sizeX * configuration->size[1] * configuration->size[2];
+}
+
+//1D C2C forward transform against reference DFT. With shift every axis is fftshifted: bin k of the output is bin (k+N/2)%N of the reference
+void testForward(AccuracyReport* accuracyReport, VkFFT::VkFFTConfiguration configuration, bool shift, std::mt19937* generator) {
+	uint64_t elements = (uint64_t)configuration.size[0] * configuration.size[1] * configuration.size[2];
+	VkDeviceSize bufferSize = bufferSizeOf(&configuration, 1);
+	VkBuffer buffer = {};
+	VkDeviceMemory bufferDeviceMemory = {};
+	if (allocateFFTBuffer(&buffer, &bufferDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, bufferSize) != VK_SUCCESS)
+		throw std::runtime_error("buffer allocation failed");
+	configuration.buffer = &buffer;
+	configuration.bufferSize = &bufferSize;
+	configuration.bufferDeviceMemory = &bufferDeviceMemory;
+
+	std::vector<cpx> input(elements), reference(elements), result(elements);
+	std::vector<float> buffer_cpu(bufferSize / sizeof(float));
+	fillRandom(input.data(), elements, false, generator);
+	complexToBuffer(input.data(), buffer_cpu.data(), configuration.size, false, 1);
+	transferDataFromCPU(buffer_cpu.data(), buffer, bufferSize);
+
+	for (uint32_t i = 0; i < configuration.FFTdim; i++)
+		configuration.fftShift[i] = shift;
+	VkFFT::VkFFTApplication app;
+	if (app.initializeVulkanFFT(configuration) != VK_SUCCESS)
+		throw std::runtime_error("plan creation failed");
+	performVulkanFFT({ &app });
+	transferDataToCPU(buffer_cpu.data(), buffer, bufferSize);
+	bufferToComplex(buffer_cpu.data(), result.data(), configuration.size, false, 1);
+
+	//forward transform is exp(-i)
+	reference = input;
+	referenceFFT(reference.data(), configuration.size, configuration.FFTdim, -1);
+	if (shift) {
+		std::vector<cpx> shifted(elements);
+		for (uint32_t k = 0; k < configuration.size[2]; k++)
+			for (uint32_t j = 0; j < configuration.size[1]; j++)
+				for (uint32_t i = 0; i < configuration.size[0]; i++) {
+					uint32_t n[3] = { i, j, k };
+					for (uint32_t a = 0; a < configuration.FFTdim; a++)
+						n[a] = (n[a] + configuration.size[a] / 2) % configuration.size[a];
+					shifted[i + (uint64_t)j * configuration.size[0] + (uint64_t)k * configuration.size[0] * configuration.size[1]] = reference[n[0] + (uint64_t)n[1] * configuration.size[0] + (uint64_t)n[2] * configuration.size[0] * configuration.size[1]];
+				}
+		reference = shifted;
+	}
+	double maxError, rmsError;
+	compare(result.data(), reference.data(), elements, &maxError, &rmsError);
+	report(accuracyReport, "forward", &configuration, (shift) ? "fftshift" : "", maxError, rmsError);
+
+	app.deleteVulkanFFT();
+	vkDestroyBuffer(device, buffer, NULL);
+	vkFreeMemory(device, bufferDeviceMemory, NULL);
+}
+
+//small 2D C2C forward transform done by the fused kernel and by the per-axis path (grouped, natural layout), both against reference DFT and against each other.
+//The fused plan has to show up as one profiled stage and be recorded as fused in wisdom
+void testFused2D(AccuracyReport* accuracyReport, VkFFT::VkFFTConfiguration configuration, std::mt19937* generator) {
+	uint64_t elements = (uint64_t)configuration.size[0] * configuration.size[1] * configuration.size[2];
+	VkDeviceSize bufferSize = bufferSizeOf(&configuration, 1);
+	VkBuffer buffer = {};
+	VkDeviceMemory bufferDeviceMemory = {};
+	if (allocateFFTBuffer(&buffer, &bufferDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, bufferSize) != VK_SUCCESS)
+		throw std::runtime_error("buffer allocation failed");
+	configuration.buffer = &buffer;
+	configuration.bufferSize = &bufferSize;
+	configuration.bufferDeviceMemory = &bufferDeviceMemory;
+	configuration.performProfiling = true;
+
+	std::vector<cpx> input(elements), reference(elements);
+	std::vector<cpx> result[2] = { std::vector<cpx>(elements), std::vector<cpx>(elements) };
+	std::vector<float> buffer_cpu(bufferSize / sizeof(float));
+	fillRandom(input.data(), elements, false, generator);
+	reference = input;
+	referenceFFT(reference.data(), configuration.size, configuration.FFTdim, -1);
+	double maxError, rmsError;
+	for (uint32_t fused = 0; fused < 2; fused++) {
+		complexToBuffer(input.data(), buffer_cpu.data(), configuration.size, false, 1);
+		transferDataFromCPU(buffer_cpu.data(), buffer, bufferSize);
+		VkFFT::VkFFTWisdom wisdom;
+		configuration.performFused2D = fused;
+		configuration.wisdom = &wisdom;
+		VkFFT::VkFFTApplication app;
+		if (app.initializeVulkanFFT(configuration) != VK_SUCCESS)
+			throw std::runtime_error("plan creation failed");
+		if ((wisdom.entries.size() != 1) || (wisdom.entries[0].fused2D != (fused == 1)))
+			throw std::runtime_error("fused 2D choice is not stored in wisdom");
+		performVulkanFFT({ &app });
+		std::vector<VkFFT::VkFFTProfilingStage> stages;
+		if (app.VkFFTGetProfilingResults(&stages)) {
+			bool fusedStage = (stages.size() == 1) && (!strcmp(stages[0].name, "fused axes 0-1"));
+			if (fusedStage != (fused == 1))
+				throw std::runtime_error("fused 2D stage is not profiled");
+		}
+		transferDataToCPU(buffer_cpu.data(), buffer, bufferSize);
+		bufferToComplex(buffer_cpu.data(), result[fused].data(), configuration.size, false, 1);
+		compare(result[fused].data(), reference.data(), elements, &maxError, &rmsError);
+		report(accuracyReport, "forward", &configuration, (fused) ? "fused 2D" : "per-axis 2D", maxError, rmsError);
+		app.deleteVulkanFFT();
+	}
+	compare(result[1].data(), result[0].data(), elements, &maxError, &rmsError);
+	report(accuracyReport, "fused", &configuration, "vs per-axis", maxError, rmsError);
+
+	vkDestroyBuffer(device, buffer, NULL);
+	vkFreeMemory(device, bufferDeviceMemory, NULL);
+}
+
+//wisdom entries with invalid plan parameters are dropped on import, entries that don't fit the device are not used and the plan is chosen as without wisdom.
+//Entries recorded for another convolution layout (filterBankSize) don't match the key
+void testWisdom(AccuracyReport* accuracyReport, VkFFT::VkFFTConfiguration configuration) {
+	VkDeviceSize bufferSize = bufferSizeOf(&configuration, 1);
+	VkBuffer buffer = {};
+	VkDeviceMemory bufferDeviceMemory = {};
+	if (allocateFFTBuffer(&buffer, &bufferDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, bufferSize) != VK_SUCCESS)
+		throw std::runtime_error("buffer allocation failed");
+	configuration.buffer = &buffer;
+	configuration.bufferSize = &bufferSize;
+	configuration.bufferDeviceMemory = &bufferDeviceMemory;
+
+	VkFFT::VkFFTWisdom wisdom;
+	configuration.wisdom = &wisdom;
+	VkFFT::VkFFTApplication app;
+	if (app.initializeVulkanFFT(configuration) != VK_SUCCESS)
+		throw std::runtime_error("plan creation failed");
+	app.deleteVulkanFFT();
+	if (wisdom.entries.size() != 1)
+		throw std::runtime_error("plan is not stored in wisdom");
+	VkFFT::VkFFTWisdomEntry valid = wisdom.entries[0];
+
+	//one valid entry and three edited ones go through a file
+	VkFFT::VkFFTWisdom edited;
+	edited.entries.push_back(valid);
+	edited.entries.push_back(valid);
+	edited.entries.back().radix = 3;
+	edited.entries.push_back(valid);
+	edited.entries.back().groupedBatch[1] = 0;
+	edited.entries.push_back(valid);
+	edited.entries.back().fused2D = false;
+	edited.entries.back().performTranspose[0] = true;
+	edited.entries.back().transposeBlock[0][0] = 0;
+	VkFFT::VkFFTWisdom imported;
+	bool importedValid = (VkFFT::VkFFTExportWisdom(&edited, "VkFFT_accuracy_wisdom.txt")) && (VkFFT::VkFFTImportWisdom(&imported, "VkFFT_accuracy_wisdom.txt")) && (imported.entries.size() == 1) && (imported.entries[0].radix == valid.radix);
+	remove("VkFFT_accuracy_wisdom.txt");
+	report(accuracyReport, "wisdom", &configuration, "invalid dropped", (importedValid) ? 0 : 1, 0);
+
+	//a transpose tile larger than any device allows has to be ignored, the plan then stores its own entry
+	VkFFT::VkFFTWisdom oversized;
+	oversized.entries.push_back(valid);
+	oversized.entries[0].fused2D = false;
+	oversized.entries[0].performTranspose[0] = true;
+	oversized.entries[0].transposeBlock[0][0] = 65536;
+	oversized.entries[0].transposeBlock[0][1] = 65536;
+	configuration.wisdom = &oversized;
+	VkFFT::VkFFTApplication app_oversized;
+	bool fallback = (app_oversized.initializeVulkanFFT(configuration) == VK_SUCCESS);
+	if (fallback) app_oversized.deleteVulkanFFT();
+	fallback = (fallback) && (oversized.entries.size() == 2) && (oversized.entries[1].transposeBlock[0][0] != 65536);
+	report(accuracyReport, "wisdom", &configuration, "over limits", (fallback) ? 0 : 1, 0);
+
+	//filter bank of another size is a different plan
+	VkFFT::VkFFTWisdom keyed;
+	keyed.entries.push_back(valid);
+	keyed.entries[0].filterBankSize = 2;
+	configuration.wisdom = &keyed;
+	VkFFT::VkFFTApplication app_keyed;
+	bool separate = (app_keyed.initializeVulkanFFT(configuration) == VK_SUCCESS);
+	if (separate) app_keyed.deleteVulkanFFT();
+	separate = (separate) && (keyed.entries.size() == 2);
+	report(accuracyReport, "wisdom", &configuration, "key mismatch", (separate) ? 0 : 1, 0);
+
+	vkDestroyBuffer(device, buffer, NULL);
+	vkFreeMemory(device, bufferDeviceMemory, NULL);
+}
+
+//C2C forward transform with the test callbacks of CALLBACK_SHADER_DIR (load doubles the input, store conjugates the output) against reference DFT, natural layout plans only
+void testCallbacks(AccuracyReport* accuracyReport, VkFFT::VkFFTConfiguration configuration, bool loadCallback, bool storeCallback, std::mt19937* generator) {
+	uint64_t elements = (uint64_t)configuration.size[0] * configuration.size[1] * configuration.size[2];
+	VkDeviceSize bufferSize = bufferSizeOf(&configuration, 1);
+	VkBuffer buffer = {};
+	VkDeviceMemory bufferDeviceMemory = {};
+	if (allocateFFTBuffer(&buffer, &bufferDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, bufferSize) != VK_SUCCESS)
+		throw std::runtime_error("buffer allocation failed");
+	configuration.buffer = &buffer;
+	configuration.bufferSize = &bufferSize;
+	configuration.bufferDeviceMemory = &bufferDeviceMemory;
+	configuration.loadCallback = loadCallback;
+	configuration.storeCallback = storeCallback;
+	sprintf(configuration.shaderPath, CALLBACK_SHADER_DIR);
+
+	std::vector<cpx> input(elements), reference(elements), result(elements);
+	std::vector<float> buffer_cpu(bufferSize / sizeof(float));
+	fillRandom(input.data(), elements, false, generator);
+	complexToBuffer(input.data(), buffer_cpu.data(), configuration.size, false, 1);
+	transferDataFromCPU(buffer_cpu.data(), buffer, bufferSize);
+
+	VkFFT::VkFFTApplication app;
+	if (app.initializeVulkanFFT(configuration) != VK_SUCCESS)
+		throw std::runtime_error("plan creation failed");
+	performVulkanFFT({ &app });
+	transferDataToCPU(buffer_cpu.data(), buffer, bufferSize);
+	bufferToComplex(buffer_cpu.data(), result.data(), configuration.size, false, 1);
+
+	reference = input;
+	if (loadCallback)
+		for (uint64_t i = 0; i < elements; i++)
+			reference[i] *= 2.0;
+	referenceFFT(reference.data(), configuration.size, configuration.FFTdim, -1);
+	if (storeCallback)
+		for (uint64_t i = 0; i < elements; i++)
+			reference[i] = std::conj(reference[i]);
+	double maxError, rmsError;
+	compare(result.data(), reference.data(), elements, &maxError, &rmsError);
+	char mode[32];
+	sprintf(mode, "%s%s%s%s", (loadCallback) ? "load" : "", ((loadCallback) && (storeCallback)) ? "+" : "", (storeCallback) ? "store" : "", (configuration.performFused2D) ? " fused" : "");
+	report(accuracyReport, "callback", &configuration, mode, maxError, rmsError);
+
+	app.deleteVulkanFFT();
+	vkDestroyBuffer(device, buffer, NULL);
+	vkFreeMemory(device, bufferDeviceMemory, NULL);
+}
+
+//1D R2C forward transform against reference DFT. Rows are transformed in pairs: pair y stores bins 1..N/2 of row 2y at x = 0..N/2-1 and of row 2y+1 at x = N/2..N-1 of complex row y,
+//the real DC bins of all rows follow as complex row size[1]/2
+void testForwardR2C(AccuracyReport* accuracyReport, VkFFT::VkFFTConfiguration configuration, std::mt19937* generator) {
+	uint32_t N = configuration.size[0];
+	uint32_t rows = configuration.size[1];
+	uint64_t elements = (uint64_t)N * rows;
+	uint64_t bins = (uint64_t)(N / 2 + 1) * rows;
+	VkDeviceSize bufferSize = bufferSizeOf(&configuration, 1);
+	VkBuffer buffer = {};
+	VkDeviceMemory bufferDeviceMemory = {};
+	if (allocateFFTBuffer(&buffer, &bufferDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, bufferSize) != VK_SUCCESS)
+		throw std::runtime_error("buffer allocation failed");
+	configuration.buffer = &buffer;
+	configuration.bufferSize = &bufferSize;
+	configuration.bufferDeviceMemory = &bufferDeviceMemory;
+
+	std::vector<cpx> input(elements), reference(bins), result(bins);
+	std::vector<float> buffer_cpu(bufferSize / sizeof(float));
+	fillRandom(input.data(), elements, true, generator);
+	complexToBuffer(input.data(), buffer_cpu.data(), configuration.size, true, 1);
+	transferDataFromCPU(buffer_cpu.data(), buffer, bufferSize);
+
+	VkFFT::VkFFTApplication app;
+	if (app.initializeVulkanFFT(configuration) != VK_SUCCESS)
+		throw std::runtime_error("plan creation failed");
+	performVulkanFFT({ &app });
+	transferDataToCPU(buffer_cpu.data(), buffer, bufferSize);
+
+	std::vector<cpx> spectrum = input;
+	referenceFFT(spectrum.data(), configuration.size, 1, -1);
+	for (uint32_t j = 0; j < rows; j++) {
+		for (uint32_t k = 0; k <= N / 2; k++) {
+			uint64_t id = (k == 0) ? (uint64_t)(rows / 2) * N + j : (uint64_t)(j / 2) * N + (j % 2) * (N / 2) + k - 1;
+			result[k + (uint64_t)j * (N / 2 + 1)] = cpx(buffer_cpu[2 * id], buffer_cpu[2 * id + 1]);
+			reference[k + (uint64_t)j * (N / 2 + 1)] = spectrum[k + (uint64_t)j * N];
+		}
+	}
+	double maxError, rmsError;
+	compare(result.data(), reference.data(), bins, &maxError, &rmsError);
+	report(accuracyReport, "forward", &configuration, "", maxError, rmsError);
+
+	app.deleteVulkanFFT();
+	vkDestroyBuffer(device, buffer, NULL);
+	vkFreeMemory(device, bufferDeviceMemory, NULL);
+}
+
+//FFT + iFFT, inverse is normalized, so input is expected back
+void testRoundTrip(AccuracyReport* accuracyReport, VkFFT::VkFFTConfiguration configuration, std::mt19937* generator) {
+	uint64_t elements = (uint64_t)configuration.size[0] * configuration.size[1] * configuration.size[2];
+	VkDeviceSize bufferSize = bufferSizeOf(&configuration, 1);
+	VkBuffer buffer = {};
+	VkDeviceMemory bufferDeviceMemory = {};
+	if (allocateFFTBuffer(&buffer, &bufferDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, bufferSize) != VK_SUCCESS)
+		throw std::runtime_error("buffer allocation failed");
+	configuration.buffer = &buffer;
+	configuration.bufferSize = &bufferSize;
+	configuration.bufferDeviceMemory = &bufferDeviceMemory;
+
+	std::vector<cpx> input(elements), result(elements);
+	std::vector<float> buffer_cpu(bufferSize / sizeof(float));
+	fillRandom(input.data(), elements, configuration.performR2C, generator);
+	complexToBuffer(input.data(), buffer_cpu.data(), configuration.size, configuration.performR2C, 1);
+	transferDataFromCPU(buffer_cpu.data(), buffer, bufferSize);
+
+	VkFFT::VkFFTConfiguration inverse_configuration = configuration;
+	inverse_configuration.inverse = true;
+	VkFFT::VkFFTApplication app_forward;
+	VkFFT::VkFFTApplication app_inverse;
+	if (app_forward.initializeVulkanFFT(configuration) != VK_SUCCESS)
+		throw std::runtime_error("plan creation failed");
+	if (app_inverse.initializeVulkanFFT(inverse_configuration) != VK_SUCCESS)
+		throw std::runtime_error("plan creation failed");
+	performVulkanFFT({ &app_forward, &app_inverse });
+	transferDataToCPU(buffer_cpu.data(), buffer, bufferSize);
+	bufferToComplex(buffer_cpu.data(), result.data(), configuration.size, configuration.performR2C, 1);
+
+	double maxError, rmsError;
+	compare(result.data(), input.data(), elements, &maxError, &rmsError);
+	report(accuracyReport, "roundtrip", &configuration, (configuration.fftShift[0]) ? "fftshift" : "", maxError, rmsError);
+
+	app_forward.deleteVulkanFFT();
+	app_inverse.deleteVulkanFFT();
+	vkDestroyBuffer(device, buffer, NULL);
+	vkFreeMemory(device, bufferDeviceMemory, NULL);
+}
+
+//integer samples of inputBuffer scaled to [-1, 1] by inputScale: FFT + iFFT returns the scaled samples, and the same samples given as float inputBuffer give the same result
+void testInputType(AccuracyReport* accuracyReport, VkFFT::VkFFTConfiguration configuration, uint32_t inputType, std::mt19937* generator) {
+	const char* typeNames[] = { "float", "uint8", "uint16", "int16" };
+	char mode[32];
+	uint64_t elements = (uint64_t)configuration.size[0] * configuration.size[1] * configuration.size[2];
+	//complex samples are interleaved pairs, real ones are packed without the R2C padding
+	uint64_t samples = (configuration.performR2C) ? elements : 2 * elements;
+	VkDeviceSize bufferSize = bufferSizeOf(&configuration, 1);
+	VkDeviceSize inputBufferSize = sizeof(float) * samples;
+	VkDeviceSize integerBufferSize = (((inputType == 1) ? samples : 2 * samples) + 3) / 4 * 4;
+	VkBuffer buffer = {}, inputBuffer = {};
+	VkDeviceMemory bufferDeviceMemory = {}, inputBufferDeviceMemory = {};
+	if (allocateFFTBuffer(&buffer, &bufferDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, bufferSize) != VK_SUCCESS)
+		throw std::runtime_error("buffer allocation failed");
+	if (allocateFFTBuffer(&inputBuffer, &inputBufferDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, inputBufferSize) != VK_SUCCESS)
+		throw std::runtime_error("buffer allocation failed");
+	configuration.buffer = &buffer;
+	configuration.bufferSize = &bufferSize;
+	configuration.bufferDeviceMemory = &bufferDeviceMemory;
+	configuration.inputBuffer = &inputBuffer;
+	configuration.inputBufferDeviceMemory = &inputBufferDeviceMemory;
+
+	int32_t minValue = (inputType == 3) ? -32768 : 0;
+	int32_t maxValue = (inputType == 1) ? 255 : ((inputType == 2) ? 65535 : 32767);
+	float scale = (inputType == 3) ? 1.0f / 32768 : 1.0f / maxValue;
+	std::uniform_int_distribution<int32_t> distribution(minValue, maxValue);
+	std::vector<int32_t> values(samples);
+	std::vector<float> input_cpu(inputBufferSize / sizeof(float), 0), buffer_cpu(bufferSize / sizeof(float));
+	for (uint64_t i = 0; i < samples; i++) {
+		values[i] = distribution(generator[0]);
+		if (inputType == 1)
+			((uint8_t*)input_cpu.data())[i] = (uint8_t)values[i];
+		else if (inputType == 2)
+			((uint16_t*)input_cpu.data())[i] = (uint16_t)values[i];
+		else
+			((int16_t*)input_cpu.data())[i] = (int16_t)values[i];
+	}
+	std::vector<cpx> reference(elements), result(elements), floatResult(elements);
+	for (uint64_t i = 0; i < elements; i++)
+		reference[i] = (configuration.performR2C) ? cpx(values[i] * (double)scale, 0) : cpx(values[2 * i] * (double)scale, values[2 * i + 1] * (double)scale);
+
+	//integer input, then the same samples as float
+	for (uint32_t pass = 0; pass < 2; pass++) {
+		VkFFT::VkFFTConfiguration forward_configuration = configuration;
+		forward_configuration.inputType = (pass == 0) ? inputType : 0;
+		forward_configuration.inputScale = (pass == 0) ? scale : 1.0f;
+		forward_configuration.inputBufferSize = (pass == 0) ? &integerBufferSize : &inputBufferSize;
+		if (pass == 1)
+			for (uint64_t i = 0; i < samples; i++)
+				input_cpu[i] = values[i] * scale;
+		transferDataFromCPU(input_cpu.data(), inputBuffer, inputBufferSize);
+		VkFFT::VkFFTConfiguration inverse_configuration = forward_configuration;
+		inverse_configuration.inverse = true;
+		inverse_configuration.inputBuffer = 0;
+		inverse_configuration.inputType = 0;
+		VkFFT::VkFFTApplication app_forward;
+		VkFFT::VkFFTApplication app_inverse;
+		if (app_forward.initializeVulkanFFT(forward_configuration) != VK_SUCCESS)
+			throw std::runtime_error("plan creation failed");
+		if (app_inverse.initializeVulkanFFT(inverse_configuration) != VK_SUCCESS)
+			throw std::runtime_error("plan creation failed");
+		performVulkanFFT({ &app_forward, &app_inverse });
+		transferDataToCPU(buffer_cpu.data(), buffer, bufferSize);
+		bufferToComplex(buffer_cpu.data(), (pass == 0) ? result.data() : floatResult.data(), configuration.size, configuration.performR2C, 1);
+		app_forward.deleteVulkanFFT();
+		app_inverse.deleteVulkanFFT();
+	}
+
+	double maxError, rmsError;
+	compare(result.data(), reference.data(), elements, &maxError, &rmsError);
+	report(accuracyReport, "input", &configuration, typeNames[inputType], maxError, rmsError);
+	sprintf(mode, "%s vs float", typeNames[inputType]);
+	compare(result.data(), floatResult.data(), elements, &maxError, &rmsError);
+	report(accuracyReport, "input", &configuration, mode, maxError, rmsError);
+
+	//integer samples are only read from inputBuffer of a forward transform, other setups have to fail
+	VkFFT::VkFFTConfiguration invalid_configurations[2] = { configuration, configuration };
+	invalid_configurations[0].inputType = inputType;
+	invalid_configurations[0].inputBuffer = 0;
+	invalid_configurations[1].inputType = inputType;
+	invalid_configurations[1].inverse = true;
+	bool rejected = true;
+	for (uint32_t i = 0; i < 2; i++) {
+		VkFFT::VkFFTApplication app_invalid;
+		if (app_invalid.initializeVulkanFFT(invalid_configurations[i]) == VK_SUCCESS) {
+			app_invalid.deleteVulkanFFT();
+			rejected = false;
+		}
+	}
+	sprintf(mode, "%s rejected", typeNames[inputType]);
+	report(accuracyReport, "input", &configuration, mode, (rejected) ? 0 : 1, 0);
+
+	vkDestroyBuffer(device, buffer, NULL);
+	vkFreeMemory(device, bufferDeviceMemory, NULL);
+	vkDestroyBuffer(device, inputBuffer, NULL);
+	vkFreeMemory(device, inputBufferDeviceMemory, NULL);
+}
+
+double besselI0(double x) {
+	double term = 1, sum = 1;
+	for (uint32_t k = 1; k < 64; k++) {
+		term *= x * x / (4.0 * k * k);
+		sum += term;
+	}
+	return sum;
+}
+
+//periodic windows of shaders/vkFFT_window.glsl
+double referenceWindow(uint32_t type, uint32_t n, uint32_t N, double kaiserBeta) {
+	double phase = 2 * 3.14159265358979323846 * n / N;
+	double x = 2.0 * n / N - 1;
+	switch (type) {
+	case 1: return 0.5 - 0.5 * cos(phase);
+	case 2: return 0.54 - 0.46 * cos(phase);
+	case 3: return 0.35875 - 0.48829 * cos(phase) + 0.14128 * cos(2 * phase) - 0.01168 * cos(3 * phase);
+	case 4: return besselI0(kaiserBeta * sqrt(std::max(1 - x * x, 0.0))) / besselI0(kaiserBeta);
+	}
+	return 1;
+}
+
+//windowed R2C followed by the plain inverse returns the input multiplied by the window
+void testWindow(AccuracyReport* accuracyReport, VkFFT::VkFFTConfiguration configuration, std::mt19937* generator) {
+	uint64_t elements = (uint64_t)configuration.size[0] * configuration.size[1] * configuration.size[2];
+	VkDeviceSize bufferSize = bufferSizeOf(&configuration, 1);
+	VkBuffer buffer = {};
+	VkDeviceMemory bufferDeviceMemory = {};
+	if (allocateFFTBuffer(&buffer, &bufferDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, bufferSize) != VK_SUCCESS)
+		throw std::runtime_error("buffer allocation failed");
+	configuration.buffer = &buffer;
+	configuration.bufferSize = &bufferSize;
+	configuration.bufferDeviceMemory = &bufferDeviceMemory;
+
+	std::vector<cpx> input(elements), reference(elements), result(elements);
+	std::vector<float> buffer_cpu(bufferSize / sizeof(float));
+	fillRandom(input.data(), elements, true, generator);
+	complexToBuffer(input.data(), buffer_cpu.data(), configuration.size, true, 1);
+	transferDataFromCPU(buffer_cpu.data(), buffer, bufferSize);
+
+	//every window type is used on some axis
+	VkFFT::VkFFTConfiguration inverse_configuration = configuration;
+	inverse_configuration.inverse = true;
+	for (uint32_t i = 0; i < configuration.FFTdim; i++)
+		configuration.windowType[i] = (configuration.size[0] + i) % 4 + 1;
+	VkFFT::VkFFTApplication app_forward;
+	VkFFT::VkFFTApplication app_inverse;
+	if (app_forward.initializeVulkanFFT(configuration) != VK_SUCCESS)
+		throw std::runtime_error("plan creation failed");
+	if (app_inverse.initializeVulkanFFT(inverse_configuration) != VK_SUCCESS)
+		throw std::runtime_error("plan creation failed");
+	performVulkanFFT({ &app_forward, &app_inverse });
+	transferDataToCPU(buffer_cpu.data(), buffer, bufferSize);
+	bufferToComplex(buffer_cpu.data(), result.data(), configuration.size, true, 1);
+
+	for (uint32_t k = 0; k < configuration.size[2]; k++)
+		for (uint32_t j = 0; j < configuration.size[1]; j++)
+			for (uint32_t i = 0; i < configuration.size[0]; i++) {
+				uint32_t n[3] = { i, j, k };
+				double window = 1;
+				for (uint32_t a = 0; a < 3; a++)
+					window *= referenceWindow(configuration.windowType[a], n[a], configuration.size[a], configuration.kaiserBeta);
+				uint64_t id = i + (uint64_t)j * configuration.size[0] + (uint64_t)k * configuration.size[0] * configuration.size[1];
+				reference[id] = input[id] * window;
+			}
+	double maxError, rmsError;
+	compare(result.data(), reference.data(), elements, &maxError, &rmsError);
+	report(accuracyReport, "window", &configuration, "", maxError, rmsError);
+
+	//windows are applied by the R2C load only, a windowed C2C plan has to fail
+	VkFFT::VkFFTConfiguration c2c_configuration = configuration;
+	c2c_configuration.performR2C = false;
+	VkFFT::VkFFTApplication app_c2c;
+	bool rejected = (app_c2c.initializeVulkanFFT(c2c_configuration) != VK_SUCCESS);
+	if (!rejected) app_c2c.deleteVulkanFFT();
+	report(accuracyReport, "window", &c2c_configuration, "c2c rejected", (rejected) ? 0 : 1, 0);
+
+	app_forward.deleteVulkanFFT();
+	app_inverse.deleteVulkanFFT();
+	vkDestroyBuffer(device, buffer, NULL);
+	vkFreeMemory(device, bufferDeviceMemory, NULL);
+}
+
+//STFT frames read from the signal by the forward R2C, the plain inverse returns every windowed frame. Frames overlap by 3/4
+void testSTFT(AccuracyReport* accuracyReport, VkFFT::VkFFTConfiguration configuration, std::mt19937* generator) {
+	uint64_t elements = (uint64_t)configuration.size[0] * configuration.size[1];
+	configuration.stftHop = (configuration.size[0] / 4 > 1) ? configuration.size[0] / 4 : 1;
+	configuration.windowType[0] = 1;
+	uint32_t signalLength = (configuration.size[1] - 1) * configuration.stftHop + configuration.size[0];
+	VkDeviceSize bufferSize = bufferSizeOf(&configuration, 1);
+	VkDeviceSize inputBufferSize = sizeof(float) * (signalLength + 1);
+	VkBuffer buffer = {}, inputBuffer = {};
+	VkDeviceMemory bufferDeviceMemory = {}, inputBufferDeviceMemory = {};
+	if (allocateFFTBuffer(&buffer, &bufferDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, bufferSize) != VK_SUCCESS)
+		throw std::runtime_error("buffer allocation failed");
+	if (allocateFFTBuffer(&inputBuffer, &inputBufferDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, inputBufferSize) != VK_SUCCESS)
+		throw std::runtime_error("buffer allocation failed");
+	configuration.buffer = &buffer;
+	configuration.bufferSize = &bufferSize;
+	configuration.bufferDeviceMemory = &bufferDeviceMemory;
+	configuration.inputBuffer = &inputBuffer;
+	configuration.inputBufferSize = &inputBufferSize;
+	configuration.inputBufferDeviceMemory = &inputBufferDeviceMemory;
+
+	std::vector<cpx> signal(signalLength), reference(elements), result(elements);
+	std::vector<float> signal_cpu(inputBufferSize / sizeof(float), 0), buffer_cpu(bufferSize / sizeof(float));
+	fillRandom(signal.data(), signalLength, true, generator);
+	for (uint32_t i = 0; i < signalLength; i++)
+		signal_cpu[i] = (float)signal[i].real();
+	transferDataFromCPU(signal_cpu.data(), inputBuffer, inputBufferSize);
+
+	VkFFT::VkFFTConfiguration inverse_configuration = configuration;
+	inverse_configuration.inverse = true;
+	inverse_configuration.inputBuffer = 0;
+	inverse_configuration.stftHop = 0;
+	inverse_configuration.windowType[0] = 0;
+	VkFFT::VkFFTApplication app_forward;
+	VkFFT::VkFFTApplication app_inverse;
+	if (app_forward.initializeVulkanFFT(configuration) != VK_SUCCESS)
+		throw std::runtime_error("plan creation failed");
+	if (app_inverse.initializeVulkanFFT(inverse_configuration) != VK_SUCCESS)
+		throw std::runtime_error("plan creation failed");
+	performVulkanFFT({ &app_forward, &app_inverse });
+	transferDataToCPU(buffer_cpu.data(), buffer, bufferSize);
+	bufferToComplex(buffer_cpu.data(), result.data(), configuration.size, true, 1);
+
+	for (uint32_t j = 0; j < configuration.size[1]; j++)
+		for (uint32_t i = 0; i < configuration.size[0]; i++)
+			reference[i + (uint64_t)j * configuration.size[0]] = signal[j * configuration.stftHop + i] * referenceWindow(1, i, configuration.size[0], configuration.kaiserBeta);
+	double maxError, rmsError;
+	compare(result.data(), reference.data(), elements, &maxError, &rmsError);
+	report(accuracyReport, "stft", &configuration, "hop size[0]/4", maxError, rmsError);
+
+	//frames can only be read by a forward 1D R2C from inputBuffer, other stftHop plans have to fail
+	VkFFT::VkFFTConfiguration invalid_configurations[2] = { configuration, configuration };
+	invalid_configurations[0].inputBuffer = 0;
+	invalid_configurations[1].performR2C = false;
+	invalid_configurations[1].windowType[0] = 0;
+	bool rejected = true;
+	for (uint32_t i = 0; i < 2; i++) {
+		VkFFT::VkFFTApplication app_invalid;
+		if (app_invalid.initializeVulkanFFT(invalid_configurations[i]) == VK_SUCCESS) {
+			app_invalid.deleteVulkanFFT();
+			rejected = false;
+		}
+	}
+	report(accuracyReport, "stft", &configuration, "invalid rejected", (rejected) ? 0 : 1, 0);
+
+	app_forward.deleteVulkanFFT();
+	app_inverse.deleteVulkanFFT();
+	vkDestroyBuffer(device, buffer, NULL);
+	vkFreeMemory(device, bufferDeviceMemory, NULL);
+	vkDestroyBuffer(device, inputBuffer, NULL);
+	vkFreeMemory(device, inputBufferDeviceMemory, NULL);
+}
+
+//power spectrum written by the last pass of a 1D C2C, which is in natural layout. Accumulated spectra average 3 systems with spectrumScale, batched 1D plans must refuse accumulation
+void testSpectrum(AccuracyReport* accuracyReport, VkFFT::VkFFTConfiguration configuration, bool accumulate, std::mt19937* generator) {
+	uint32_t vectorDimension = 3;
+	uint64_t elements = (uint64_t)configuration.size[0] * configuration.size[1] * configuration.size[2];
+	VkDeviceSize bufferSize = bufferSizeOf(&configuration, vectorDimension);
+	VkDeviceSize spectrumSize = ((accumulate) ? elements : vectorDimension * elements) * sizeof(float);
+	VkBuffer buffer = {};
+	VkDeviceMemory bufferDeviceMemory = {};
+	VkBuffer spectrum = {};
+	VkDeviceMemory spectrumDeviceMemory = {};
+	if (allocateFFTBuffer(&buffer, &bufferDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, bufferSize) != VK_SUCCESS)
+		throw std::runtime_error("buffer allocation failed");
+	if (allocateFFTBuffer(&spectrum, &spectrumDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, spectrumSize) != VK_SUCCESS)
+		throw std::runtime_error("buffer allocation failed");
+	configuration.vectorDimension = vectorDimension;
+	configuration.buffer = &buffer;
+	configuration.bufferSize = &bufferSize;
+	configuration.bufferDeviceMemory = &bufferDeviceMemory;
+	configuration.spectrumBuffer = &spectrum;
+	configuration.spectrumBufferSize = &spectrumSize;
+	configuration.spectrumBufferDeviceMemory = &spectrumDeviceMemory;
+	configuration.spectrumOutput = 1;
+	configuration.accumulateSpectrum = accumulate;
+	configuration.spectrumScale = (accumulate) ? 1.0f / vectorDimension : 1.0f;
+
+	std::vector<cpx> input(vectorDimension * elements), result(vectorDimension * elements), reference(vectorDimension * elements);
+	std::vector<float> buffer_cpu(bufferSize / sizeof(float));
+	std::vector<float> spectrum_cpu(spectrumSize / sizeof(float), 0);
+	fillRandom(input.data(), vectorDimension * elements, false, generator);
+	complexToBuffer(input.data(), buffer_cpu.data(), configuration.size, false, vectorDimension);
+	transferDataFromCPU(buffer_cpu.data(), buffer, bufferSize);
+	transferDataFromCPU(spectrum_cpu.data(), spectrum, spectrumSize);
+
+	VkFFT::VkFFTApplication app;
+	VkResult res = app.initializeVulkanFFT(configuration);
+	//systems batched along untransformed axes are not summed by accumulation, such plans have to fail
+	bool batched = ((configuration.FFTdim < 2) && (configuration.size[1] > 1)) || ((configuration.FFTdim < 3) && (configuration.size[2] > 1));
+	if ((accumulate) && (batched)) {
+		if (res == VK_SUCCESS) app.deleteVulkanFFT();
+		report(accuracyReport, "spectrum", &configuration, "accumulated batched rejected", (res != VK_SUCCESS) ? 0 : 1, 0);
+		vkDestroyBuffer(device, buffer, NULL);
+		vkFreeMemory(device, bufferDeviceMemory, NULL);
+		vkDestroyBuffer(device, spectrum, NULL);
+		vkFreeMemory(device, spectrumDeviceMemory, NULL);
+		return;
+	}
+	if (res != VK_SUCCESS)
+		throw std::runtime_error("plan creation failed");
+	performVulkanFFT({ &app });
+	transferDataToCPU(spectrum_cpu.data(), spectrum, spectrumSize);
+
+	for (uint32_t v = 0; v < vectorDimension; v++) {
+		std::vector<cpx> system(input.begin() + v * elements, input.begin() + (v + 1) * elements);
+		referenceFFT(system.data(), configuration.size, configuration.FFTdim, -1);
+		for (uint64_t i = 0; i < elements; i++) {
+			double power = std::norm(system[i]) * configuration.spectrumScale;
+			if (accumulate)
+				reference[i] += power;
+			else
+				reference[i + v * elements] = power;
+		}
+	}
+	uint64_t bins = spectrumSize / sizeof(float);
+	for (uint64_t i = 0; i < bins; i++)
+		result[i] = spectrum_cpu[i];
+	double maxError, rmsError;
+	compare(result.data(), reference.data(), bins, &maxError, &rmsError);
+	report(accuracyReport, "spectrum", &configuration, (accumulate) ? "accumulated" : "power", maxError, rmsError);
+	app.deleteVulkanFFT();
+
+	//spectrum setups that can't be done have to fail instead of writing complex output or power
+	VkFFT::VkFFTConfiguration invalid_configurations[3] = { configuration, configuration, configuration };
+	invalid_configurations[0].spectrumBuffer = 0;
+	invalid_configurations[1].performConvolution = true;
+	invalid_configurations[2].spectrumOutput = 2;
+	invalid_configurations[2].accumulateSpectrum = true;
+	bool rejected = true;
+	for (uint32_t i = 0; i < 3; i++) {
+		VkFFT::VkFFTApplication app_invalid;
+		if (app_invalid.initializeVulkanFFT(invalid_configurations[i]) == VK_SUCCESS) {
+			app_invalid.deleteVulkanFFT();
+			rejected = false;
+		}
+	}
+	report(accuracyReport, "spectrum", &configuration, "invalid rejected", (rejected) ? 0 : 1, 0);
+
+	vkDestroyBuffer(device, buffer, NULL);
+	vkFreeMemory(device, bufferDeviceMemory, NULL);
+	vkDestroyBuffer(device, spectrum, NULL);
+	vkFreeMemory(device, spectrumDeviceMemory, NULL);
+}
+
+uint32_t kernelIndex(const ConvolutionMode* mode, uint32_t a, uint32_t b) {
+	if (mode->filterBankSize > 0)
+		return a % mode->filterBankSize;
+	if (!mode->symmetricKernel)
+		return a * mode->dataVectorDimension + b;
+	//upper triangle: (xx, xy, yy) and (xx, xy, xz, yy, yz, zz)
+	if (a > b) std::swap(a, b);
+	const uint32_t symmetric2[2][2] = { { 0, 1 }, { 1, 2 } };
+	const uint32_t symmetric3[3][3] = { { 0, 1, 2 }, { 1, 3, 4 }, { 2, 4, 5 } };
+	return (mode->dataVectorDimension == 2) ? symmetric2[a][b] : symmetric3[a][b];
+}
+
+//kernel FFT + convolution against CPU circular convolution, the kernel is transformed by VkFFTKernel from the full spatial kernel matrix
+void testConvolution(AccuracyReport* accuracyReport, VkFFT::VkFFTConfiguration configuration, const ConvolutionMode* mode, std::mt19937* generator) {
+	uint64_t elements = (uint64_t)configuration.size[0] * configuration.size[1] * configuration.size[2];
+	uint32_t dataDim = mode->dataVectorDimension;
+	uint32_t kernelDim = mode->kernelVectorDimension;
+	uint32_t outputDim = (mode->outputVectorDimension > 0) ? mode->outputVectorDimension : dataDim;
+	uint32_t outputOffset = ((mode->outputVectorDimension > 0) || (dataDim > 3)) ? dataDim : 0;
+
+	VkFFT::VkFFTConfiguration convolution_configuration = configuration;
+	convolution_configuration.performConvolution = true;
+	convolution_configuration.symmetricKernel = mode->symmetricKernel;
+	convolution_configuration.vectorDimension = dataDim;
+	convolution_configuration.outputChannels = mode->outputVectorDimension;
+	convolution_configuration.performCorrelation = mode->correlation;
+	convolution_configuration.filterBankSize = mode->filterBankSize;
+	VkDeviceSize bufferSize = bufferSizeOf(&convolution_configuration, outputOffset + outputDim);
+	VkBuffer buffer = {};
+	VkDeviceMemory bufferDeviceMemory = {};
+	if (allocateFFTBuffer(&buffer, &bufferDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, bufferSize) != VK_SUCCESS)
+		throw std::runtime_error("buffer allocation failed");
+	convolution_configuration.buffer = &buffer;
+	convolution_configuration.bufferSize = &bufferSize;
+	convolution_configuration.bufferDeviceMemory = &bufferDeviceMemory;
+
+	std::vector<cpx> kernel_input(kernelDim * elements), data_input(dataDim * elements), result((outputOffset + outputDim) * elements), reference(outputDim * elements, 0);
+	fillRandom(kernel_input.data(), kernelDim * elements, configuration.performR2C, generator);
+	fillRandom(data_input.data(), dataDim * elements, configuration.performR2C, generator);
+	//full kernel matrix, symmetric entries repeat the upper triangle
+	uint32_t matrixDim = VkFFT::VkFFTKernel::kernelComponents(&convolution_configuration, false);
+	uint32_t columns = matrixDim / outputDim;
+	uint32_t complexValues = (configuration.performR2C) ? 1 : 2;
+	std::vector<float> kernel_spatial(matrixDim * elements * complexValues);
+	for (uint32_t m = 0; m < matrixDim; m++) {
+		cpx* k = &kernel_input[((mode->filterBankSize > 0) ? m : kernelIndex(mode, m / columns, m % columns)) * elements];
+		for (uint64_t i = 0; i < elements; i++) {
+			kernel_spatial[(m * elements + i) * complexValues] = (float)k[i].real();
+			if (!configuration.performR2C)
+				kernel_spatial[(m * elements + i) * complexValues + 1] = (float)k[i].imag();
+		}
+	}
+	std::vector<float> buffer_cpu(bufferSize / sizeof(float));
+	complexToBuffer(data_input.data(), buffer_cpu.data(), configuration.size, configuration.performR2C, dataDim);
+	transferDataFromCPU(buffer_cpu.data(), buffer, bufferSize);
+
+	VkFFT::VkFFTKernelConfiguration kernel_configuration = {};
+	kernel_configuration.configuration = convolution_configuration;
+	kernel_configuration.queue = &queue;
+	kernel_configuration.queueFamilyIndex = queueFamilyIndex;
+	VkFFT::VkFFTKernel kernel;
+	if (kernel.initializeKernel(kernel_configuration, kernel_spatial.data()) != VK_SUCCESS)
+		throw std::runtime_error("kernel creation failed");
+	if (kernel.attach(&convolution_configuration) != VK_SUCCESS)
+		throw std::runtime_error("kernel does not match the convolution plan");
+	VkFFT::VkFFTApplication app_convolution;
+	if (app_convolution.initializeVulkanFFT(convolution_configuration) != VK_SUCCESS)
+		throw std::runtime_error("plan creation failed");
+	performVulkanFFT({ &app_convolution });
+	transferDataToCPU(buffer_cpu.data(), buffer, bufferSize);
+	bufferToComplex(buffer_cpu.data(), result.data(), configuration.size, configuration.performR2C, outputOffset + outputDim);
+
+	//reference: out_a = iFFT(sum_b FFT(kernel_ab) * FFT(data_b)), conj(FFT(kernel_ab)) for correlation
+	for (uint32_t v = 0; v < kernelDim; v++)
+		referenceFFT(&kernel_input[v * elements], configuration.size, configuration.FFTdim, -1);
+	for (uint32_t v = 0; v < dataDim; v++)
+		referenceFFT(&data_input[v * elements], configuration.size, configuration.FFTdim, -1);
+	for (uint32_t a = 0; a < outputDim; a++) {
+		for (uint32_t b = 0; b < dataDim; b++) {
+			if ((mode->filterBankSize > 0) && (a / mode->filterBankSize != b)) continue;
+			cpx* k = &kernel_input[kernelIndex(mode, a, b) * elements];
+			for (uint64_t i = 0; i < elements; i++)
+				reference[a * elements + i] += ((mode->correlation) ? std::conj(k[i]) : k[i]) * data_input[b * elements + i];
+		}
+		referenceFFT(&reference[a * elements], configuration.size, configuration.FFTdim, 1);
+		for (uint64_t i = 0; i < elements; i++)
+			reference[a * elements + i] /= (double)elements;
+	}
+
+	double maxError, rmsError;
+	compare(&result[outputOffset * elements], reference.data(), outputDim * elements, &maxError, &rmsError);
+	report(accuracyReport, "convolve", &configuration, mode->name, maxError, rmsError);
+	app_convolution.deleteVulkanFFT();
+
+	//convolutions don't shift, the plan has to fail instead of ignoring fftShift
+	VkFFT::VkFFTConfiguration shift_configuration = convolution_configuration;
+	shift_configuration.fftShift[0] = true;
+	VkFFT::VkFFTApplication app_shift;
+	bool rejected = (app_shift.initializeVulkanFFT(shift_configuration) != VK_SUCCESS);
+	if (!rejected) app_shift.deleteVulkanFFT();
+	report(accuracyReport, "convolve", &configuration, "fftshift rejected", (rejected) ? 0 : 1, 0);
+
+	kernel.deleteKernel();
+	vkDestroyBuffer(device, buffer, NULL);
+	vkFreeMemory(device, bufferDeviceMemory, NULL);
+}
+
+//analytic kernel of shaders/vkFFT_analytic_kernel.glsl (Gaussian blur with sigma of 2 grid points) against CPU FFT times exp(-2 pi^2 sigma^2 |k/n|^2)
+void testAnalyticConvolution(AccuracyReport* accuracyReport, VkFFT::VkFFTConfiguration configuration, std::mt19937* generator) {
+	uint64_t elements = (uint64_t)configuration.size[0] * configuration.size[1] * configuration.size[2];
+	const uint32_t dataDim = 2;
+	const double sigma = 2.0;
+
+	VkFFT::VkFFTConfiguration convolution_configuration = configuration;
+	convolution_configuration.performConvolution = true;
+	convolution_configuration.analyticKernel = true;
+	convolution_configuration.vectorDimension = dataDim;
+	VkDeviceSize bufferSize = bufferSizeOf(&convolution_configuration, 2 * dataDim);
+	VkBuffer buffer = {};
+	VkDeviceMemory bufferDeviceMemory = {};
+	if (allocateFFTBuffer(&buffer, &bufferDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, bufferSize) != VK_SUCCESS)
+		throw std::runtime_error("buffer allocation failed");
+	convolution_configuration.buffer = &buffer;
+	convolution_configuration.bufferSize = &bufferSize;
+	convolution_configuration.bufferDeviceMemory = &bufferDeviceMemory;
+
+	std::vector<cpx> data_input(dataDim * elements), result(2 * dataDim * elements);
+	fillRandom(data_input.data(), dataDim * elements, configuration.performR2C, generator);
+	std::vector<float> buffer_cpu(bufferSize / sizeof(float));
+	complexToBuffer(data_input.data(), buffer_cpu.data(), configuration.size, configuration.performR2C, dataDim);
+	transferDataFromCPU(buffer_cpu.data(), buffer, bufferSize);
+
+	VkFFT::VkFFTApplication app_convolution;
+	if (app_convolution.initializeVulkanFFT(convolution_configuration) != VK_SUCCESS)
+		throw std::runtime_error("plan creation failed");
+	performVulkanFFT({ &app_convolution });
+	transferDataToCPU(buffer_cpu.data(), buffer, bufferSize);
+	bufferToComplex(buffer_cpu.data(), result.data(), configuration.size, configuration.performR2C, 2 * dataDim);
+
+	for (uint32_t v = 0; v < dataDim; v++) {
+		cpx* d = &data_input[v * elements];
+		referenceFFT(d, configuration.size, configuration.FFTdim, -1);
+		for (uint64_t i = 0; i < elements; i++) {
+			uint64_t k[3] = { i % configuration.size[0], (i / configuration.size[0]) % configuration.size[1], i / configuration.size[0] / configuration.size[1] };
+			double f2 = 0;
+			for (uint32_t j = 0; j < 3; j++) {
+				double f = ((k[j] > configuration.size[j] / 2) ? (double)k[j] - configuration.size[j] : (double)k[j]) / configuration.size[j];
+				f2 += f * f;
+			}
+			d[i] *= exp(-2.0 * M_PI * M_PI * sigma * sigma * f2) / (double)elements;
+		}
+		referenceFFT(d, configuration.size, configuration.FFTdim, 1);
+	}
+
+	double maxError, rmsError;
+	compare(&result[dataDim * elements], data_input.data(), dataDim * elements, &maxError, &rmsError);
+	report(accuracyReport, "convolve", &configuration, "analytic_gaussian", maxError, rmsError);
+
+	app_convolution.deleteVulkanFFT();
+	vkDestroyBuffer(device, buffer, NULL);
+	vkFreeMemory(device, bufferDeviceMemory, NULL);
+}
+
+//1D convolutions are done by vkFFT_overlap.h, the core has to refuse them instead of running a plain transform
+void testConvolution1D(AccuracyReport* accuracyReport, VkFFT::VkFFTConfiguration configuration) {
+	configuration.performConvolution = true;
+	VkFFT::VkFFTApplication app;
+	bool rejected = (app.initializeVulkanFFT(configuration) != VK_SUCCESS);
+	if (!rejected) app.deleteVulkanFFT();
+	report(accuracyReport, "conv_1d", &configuration, "rejected", (rejected) ? 0 : 1, 0);
+}
+
+//streamed FIR filtering with overlap-save or overlap-add, input is pushed in blocks of irregular length and compared to direct linear convolution
+void testOverlap(AccuracyReport* accuracyReport, uint32_t fftSize, uint32_t kernelLength, bool overlapAdd, std::mt19937* generator) {
+	VkFFT::VkFFTOverlapConfiguration configuration = {};
+	configuration.configuration.device = &device;
+	configuration.configuration.physicalDevice = &physicalDevice;
+	configuration.configuration.size[0] = fftSize;
+	sprintf(configuration.configuration.shaderPath, SHADER_DIR);
+	configuration.kernelLength = kernelLength;
+	configuration.maxBlocks = 4;
+	configuration.overlapAdd = overlapAdd;
+	configuration.queue = &queue;
+	configuration.queueFamilyIndex = queueFamilyIndex;
+
+	const uint64_t pushSizes[] = { 37, 1, 5 * fftSize + 3, fftSize - 1, 700, 2 * fftSize };
+	uint64_t total = 0;
+	for (uint32_t i = 0; i < sizeof(pushSizes) / sizeof(pushSizes[0]); i++)
+		total += pushSizes[i];
+	std::vector<cpx> signal(total), taps(kernelLength);
+	fillRandom(signal.data(), total, true, generator);
+	fillRandom(taps.data(), kernelLength, true, generator);
+	std::vector<float> input(total), kernel(kernelLength), output(total + fftSize);
+	for (uint64_t i = 0; i < total; i++)
+		input[i] = (float)signal[i].real();
+	for (uint32_t i = 0; i < kernelLength; i++)
+		kernel[i] = (float)taps[i].real();
+
+	VkFFT::VkFFTOverlapConvolution convolution;
+	if (convolution.initializeOverlapConvolution(configuration, kernel.data()) != VK_SUCCESS) {
+		throw std::runtime_error("overlap convolution creation failed");
+	}
+	uint64_t pushed = 0, produced = 0;
+	for (uint32_t i = 0; i < sizeof(pushSizes) / sizeof(pushSizes[0]); i++) {
+		uint64_t outputCount = 0;
+		convolution.push(&input[pushed], pushSizes[i], &output[produced], &outputCount);
+		pushed += pushSizes[i];
+		produced += outputCount;
+	}
+	convolution.deleteOverlapConvolution();
+
+	std::vector<cpx> result(produced), reference(produced, 0);
+	for (uint64_t n = 0; n < produced; n++) {
+		result[n] = output[n];
+		for (uint32_t k = 0; (k < kernelLength) && (k <= n); k++)
+			reference[n] += taps[k] * signal[n - k];
+	}
+	VkFFT::VkFFTConfiguration reportConfiguration = {};
+	reportConfiguration.FFTdim = 1;
+	reportConfiguration.size[0] = fftSize;
+	reportConfiguration.size[1] = configuration.maxBlocks;
+	reportConfiguration.size[2] = 1;
+	reportConfiguration.performR2C = true;
+	char mode[32];
+	sprintf(mode, "%s_%d_taps", (overlapAdd) ? "add" : "save", kernelLength);
+	double maxError, rmsError;
+	compare(result.data(), reference.data(), produced, &maxError, &rmsError);
+	report(accuracyReport, "overlap", &reportConfiguration, mode, maxError, rmsError);
+}
+
+//uniformly partitioned convolution: one prerecorded block is resubmitted for every input block, output is compared to direct FIR filtering
+void testPartitioned(AccuracyReport* accuracyReport, uint32_t blockLength, uint32_t impulseLength, uint32_t blockCount, std::mt19937* generator) {
+	VkDeviceSize blockSize = blockLength * sizeof(float);
+	VkBuffer buffers[2] = {};
+	VkDeviceMemory bufferMemory[2] = {};
+	for (uint32_t i = 0; i < 2; i++)
+		if (allocateFFTBuffer(&buffers[i], &bufferMemory[i], VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, blockSize) != VK_SUCCESS)
+			throw std::runtime_error("buffer allocation failed");
+	VkFFT::VkFFTPartitionedConfiguration configuration = {};
+	configuration.configuration.device = &device;
+	configuration.configuration.physicalDevice = &physicalDevice;
+	sprintf(configuration.configuration.shaderPath, SHADER_DIR);
+	configuration.blockLength = blockLength;
+	configuration.impulseLength = impulseLength;
+	configuration.inputBuffer = &buffers[0];
+	configuration.outputBuffer = &buffers[1];
+	configuration.queue = &queue;
+	configuration.queueFamilyIndex = queueFamilyIndex;
+
+	uint64_t total = (uint64_t)blockLength * blockCount;
+	std::vector<cpx> signal(total), impulse(impulseLength);
+	fillRandom(signal.data(), total, true, generator);
+	fillRandom(impulse.data(), impulseLength, true, generator);
+	std::vector<float> input(total), impulseResponse(impulseLength), output(total);
+	for (uint64_t i = 0; i < total; i++)
+		input[i] = (float)signal[i].real();
+	for (uint32_t i = 0; i < impulseLength; i++)
+		impulseResponse[i] = (float)impulse[i].real();
+
+	VkFFT::VkFFTPartitionedConvolution convolution;
+	if (convolution.initializePartitionedConvolution(configuration, impulseResponse.data()) != VK_SUCCESS) {
+		throw std::runtime_error("partitioned convolution creation failed");
+	}
+	VkCommandBufferAllocateInfo commandBufferAllocateInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
+	commandBufferAllocateInfo.commandPool = commandPool;
+	commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+	commandBufferAllocateInfo.commandBufferCount = 1;
+	VkCommandBuffer commandBuffer = {};
+	vkAllocateCommandBuffers(device, &commandBufferAllocateInfo, &commandBuffer);
+	VkCommandBufferBeginInfo commandBufferBeginInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+	vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo);
+	convolution.VkFFTAppend(commandBuffer);
+	vkEndCommandBuffer(commandBuffer);
+	for (uint32_t b = 0; b < blockCount; b++) {
+		transferDataFromCPU(&input[(uint64_t)b * blockLength], buffers[0], blockSize);
+		VkSubmitInfo submitInfo = { VK_STRUCTURE_TYPE_SUBMIT_INFO };
+		submitInfo.commandBufferCount = 1;
+		submitInfo.pCommandBuffers = &commandBuffer;
+		vkQueueSubmit(queue, 1, &submitInfo, fence);
+		vkWaitForFences(device, 1, &fence, VK_TRUE, 100000000000);
+		vkResetFences(device, 1, &fence);
+		transferDataToCPU(&output[(uint64_t)b * blockLength], buffers[1], blockSize);
+	}
+	vkFreeCommandBuffers(device, commandPool, 1, &commandBuffer);
+	convolution.deletePartitionedConvolution();
+
+	std::vector<cpx> result(total), reference(total, 0);
+	for (uint64_t n = 0; n < total; n++) {
+		result[n] = output[n];
+		for (uint32_t k = 0; (k < impulseLength) && (k <= n); k++)
+			reference[n] += impulse[k] * signal[n - k];
+	}
+	VkFFT::VkFFTConfiguration reportConfiguration = {};
+	reportConfiguration.FFTdim = 1;
+	reportConfiguration.size[0] = 2 * blockLength;
+	reportConfiguration.size[1] = 2;
+	reportConfiguration.size[2] = 1;
+	reportConfiguration.performR2C = true;
+	char mode[32];
+	sprintf(mode, "%d_partitions", convolution.getPartitionCount());
+	double maxError, rmsError;
+	compare(result.data(), reference.data(), total, &maxError, &rmsError);
+	report(accuracyReport, "partition", &reportConfiguration, mode, maxError, rmsError);
+	for (uint32_t i = 0; i < 2; i++) {
+		vkDestroyBuffer(device, buffers[i], NULL);
+		vkFreeMemory(device, bufferMemory[i], NULL);
+	}
+}
+
+//batches pushed through a stream of 3 slots come back in push order and match the reference DFT of each batch. Pops are interleaved with pushes, so slots are reused.
+//A plan the core rejects must fail the stream initialization and leave nothing behind, the same stream object is initialized again afterwards
+void testStream(AccuracyReport* accuracyReport, VkFFT::VkFFTConfiguration configuration, uint32_t batchCount, std::mt19937* generator) {
+	uint64_t elements = (uint64_t)configuration.size[0] * configuration.size[1] * configuration.size[2];
+	VkFFT::VkFFTStreamConfiguration streamConfiguration = {};
+	streamConfiguration.configuration = configuration;
+	streamConfiguration.bufferSize = bufferSizeOf(&configuration, 1);
+	streamConfiguration.numSlots = 3;
+	streamConfiguration.computeQueue = &queue;
+	streamConfiguration.computeQueueFamilyIndex = queueFamilyIndex;
+	VkFFT::VkFFTStream stream;
+
+	VkFFT::VkFFTStreamConfiguration failedConfiguration = streamConfiguration;
+	failedConfiguration.configuration.FFTdim = 1;
+	failedConfiguration.configuration.performConvolution = true;
+	bool rejected = (stream.initializeVulkanFFTStream(failedConfiguration) != VK_SUCCESS);
+	report(accuracyReport, "stream", &configuration, "failed plan", (rejected) ? 0 : 1, 0);
+	stream.deleteVulkanFFTStream();
+
+	if (stream.initializeVulkanFFTStream(streamConfiguration) != VK_SUCCESS)
+		throw std::runtime_error("stream creation failed");
+	std::vector<std::vector<cpx>> inputs(batchCount, std::vector<cpx>(elements));
+	std::vector<float> buffer_cpu(streamConfiguration.bufferSize / sizeof(float));
+	std::vector<cpx> result(elements);
+	double maxError = 0, rmsError = 0;
+	uint32_t pushed = 0, popped = 0;
+	while (popped < batchCount) {
+		VkResult res = VK_NOT_READY;
+		if (pushed < batchCount) {
+			fillRandom(inputs[pushed].data(), elements, false, generator);
+			complexToBuffer(inputs[pushed].data(), buffer_cpu.data(), configuration.size, false, 1);
+			res = stream.push(buffer_cpu.data());
+			if (res == VK_SUCCESS) pushed++;
+			else if (res != VK_NOT_READY) throw std::runtime_error("stream push failed");
+		}
+		//pop when the ring is full or everything was pushed
+		if (res == VK_NOT_READY) {
+			if (stream.pop(buffer_cpu.data()) != VK_SUCCESS)
+				throw std::runtime_error("stream pop failed");
+			bufferToComplex(buffer_cpu.data(), result.data(), configuration.size, false, 1);
+			referenceFFT(inputs[popped].data(), configuration.size, configuration.FFTdim, -1);
+			double batchMaxError, batchRmsError;
+			compare(result.data(), inputs[popped].data(), elements, &batchMaxError, &batchRmsError);
+			if (batchMaxError > maxError) maxError = batchMaxError;
+			if (batchRmsError > rmsError) rmsError = batchRmsError;
+			popped++;
+		}
+	}
+	stream.deleteVulkanFFTStream();
+	char mode[32];
+	sprintf(mode, "%d batches 3 slots", batchCount);
+	report(accuracyReport, "stream", &configuration, mode, maxError, rmsError);
+}
+
+//transfers through a staging pool of small chunks: sizes below, at and above the chunk size and multiples of the ring, at unaligned offsets, have to come back bit exact.
+//The pool is deleted and initialized again between the passes
+void testStaging(AccuracyReport* accuracyReport, VkDeviceSize chunkSize, uint32_t numChunks, std::mt19937* generator) {
+	const VkDeviceSize transferSizes[] = { 4, chunkSize - 4, chunkSize, chunkSize + 4, numChunks * chunkSize, 5 * numChunks * chunkSize + 12 };
+	const VkDeviceSize offset = 20;
+	VkDeviceSize bufferSize = offset + 5 * numChunks * chunkSize + 12;
+	VkBuffer buffer = {};
+	VkDeviceMemory bufferDeviceMemory = {};
+	if (allocateFFTBuffer(&buffer, &bufferDeviceMemory, VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, bufferSize) != VK_SUCCESS)
+		throw std::runtime_error("buffer allocation failed");
+	VkFFT::VkFFTStagingPoolConfiguration configuration = {};
+	configuration.physicalDevice = &physicalDevice;
+	configuration.device = &device;
+	configuration.queue = &queue;
+	configuration.queueFamilyIndex = queueFamilyIndex;
+	configuration.chunkSize = chunkSize;
+	configuration.numChunks = numChunks;
+	VkFFT::VkFFTStagingPool stagingPool;
+	std::uniform_real_distribution<float> distribution(-1.0, 1.0);
+	double maxError = 0;
+	for (uint32_t pass = 0; pass < 2; pass++) {
+		if (stagingPool.initializeStagingPool(configuration) != VK_SUCCESS)
+			throw std::runtime_error("staging pool creation failed");
+		for (uint32_t i = 0; i < sizeof(transferSizes) / sizeof(transferSizes[0]); i++) {
+			std::vector<float> input(transferSizes[i] / sizeof(float)), output(transferSizes[i] / sizeof(float), 0);
+			for (uint64_t j = 0; j < input.size(); j++)
+				input[j] = distribution(generator[0]);
+			if ((stagingPool.upload(input.data(), buffer, transferSizes[i], offset) != VK_SUCCESS) || (stagingPool.download(output.data(), buffer, transferSizes[i], offset) != VK_SUCCESS))
+				throw std::runtime_error("staging transfer failed");
+			for (uint64_t j = 0; j < input.size(); j++)
+				if (fabs(input[j] - output[j]) > maxError) maxError = fabs(input[j] - output[j]);
+		}
+		stagingPool.deleteStagingPool();
+	}
+	VkFFT::VkFFTConfiguration reportConfiguration = {};
+	reportConfiguration.FFTdim = 1;
+	reportConfiguration.size[0] = (uint32_t)(chunkSize / sizeof(float));
+	reportConfiguration.size[1] = numChunks;
+	reportConfiguration.size[2] = 1;
+	char mode[32];
+	sprintf(mode, "%d chunks of %d B", numChunks, (uint32_t)chunkSize);
+	report(accuracyReport, "staging", &reportConfiguration, mode, maxError, 0);
+	vkDestroyBuffer(device, buffer, NULL);
+	vkFreeMemory(device, bufferDeviceMemory, NULL);
+}
+
+//1D C2C forward transform done in imported host memory, the result is read from the same allocation without any copy. An import of a misaligned pointer has to fail and leave no handles
+void testHostMemory(AccuracyReport* accuracyReport, VkFFT::VkFFTConfiguration configuration, std::mt19937* generator) {
+	uint64_t elements = (uint64_t)configuration.size[0] * configuration.size[1] * configuration.size[2];
+	VkDeviceSize alignment = VkFFT::VkFFTGetHostPointerAlignment(physicalDevice);
+	VkDeviceSize bufferSize = bufferSizeOf(&configuration, 1);
+	VkDeviceSize importSize = (bufferSize + alignment - 1) / alignment * alignment;
+	std::vector<char> allocation(importSize + alignment);
+	char* hostPointer = (char*)(((uint64_t)allocation.data() + alignment - 1) / alignment * alignment);
+
+	VkFFT::VkFFTHostBuffer hostBuffer = {};
+	bool rejected = (VkFFT::VkFFTImportHostMemory(physicalDevice, device, hostPointer + 4, importSize, &hostBuffer) != VK_SUCCESS) && (hostBuffer.buffer == VK_NULL_HANDLE) && (hostBuffer.deviceMemory == VK_NULL_HANDLE);
+	report(accuracyReport, "hostmemory", &configuration, "misaligned", (rejected) ? 0 : 1, 0);
+
+	if (VkFFT::VkFFTImportHostMemory(physicalDevice, device, hostPointer, importSize, &hostBuffer) != VK_SUCCESS)
+		throw std::runtime_error("host memory import failed");
+	std::vector<cpx> input(elements), result(elements);
+	fillRandom(input.data(), elements, false, generator);
+	complexToBuffer(input.data(), (float*)hostPointer, configuration.size, false, 1);
+	configuration.buffer = &hostBuffer.buffer;
+	configuration.bufferSize = &hostBuffer.bufferSize;
+	configuration.bufferDeviceMemory = &hostBuffer.deviceMemory;
+	VkFFT::VkFFTApplication app;
+	if (app.initializeVulkanFFT(configuration) != VK_SUCCESS)
+		throw std::runtime_error("plan creation failed");
+
+	VkCommandBufferAllocateInfo commandBufferAllocateInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
+	commandBufferAllocateInfo.commandPool = commandPool;
+	commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+	commandBufferAllocateInfo.commandBufferCount = 1;
+	VkCommandBuffer commandBuffer = {};
+	vkAllocateCommandBuffers(device, &commandBufferAllocateInfo, &commandBuffer);
+	VkCommandBufferBeginInfo commandBufferBeginInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+	commandBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+	vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo);
+	app.VkFFTAppend(commandBuffer);
+	VkFFT::VkFFTHostMemoryBarrier(commandBuffer);
+	vkEndCommandBuffer(commandBuffer);
+	VkSubmitInfo submitInfo = { VK_STRUCTURE_TYPE_SUBMIT_INFO };
+	submitInfo.commandBufferCount = 1;
+	submitInfo.pCommandBuffers = &commandBuffer;
+	vkQueueSubmit(queue, 1, &submitInfo, fence);
+	vkWaitForFences(device, 1, &fence, VK_TRUE, 100000000000);
+	vkResetFences(device, 1, &fence);
+	vkFreeCommandBuffers(device, commandPool, 1, &commandBuffer);
+
+	bufferToComplex((float*)hostPointer, result.data(), configuration.size, false, 1);
+	referenceFFT(input.data(), configuration.size, configuration.FFTdim, -1);
+	double maxError, rmsError;
+	compare(result.data(), input.data(), elements, &maxError, &rmsError);
+	report(accuracyReport, "hostmemory", &configuration, "in place", maxError, rmsError);
+	app.deleteVulkanFFT();
+	VkFFT::VkFFTReleaseHostMemory(device, &hostBuffer);
+}
+
+//independent 1D C2C plans distributed between the compute queues (one queue is used twice if the family has only one), started by one binary semaphore and signaling one
+//semaphore per queue. Two frames are submitted, so every semaphore is signaled and waited twice, results of each frame are compared to the reference DFT
+void testScheduler(AccuracyReport* accuracyReport, VkFFT::VkFFTConfiguration configuration, uint32_t planCount, std::mt19937* generator) {
+	uint64_t elements = (uint64_t)configuration.size[0] * configuration.size[1] * configuration.size[2];
+	VkDeviceSize bufferSize = bufferSizeOf(&configuration, 1);
+	std::vector<VkQueue> schedulerQueues = computeQueues;
+	if (schedulerQueues.size() < 2) schedulerQueues.push_back(queue);
+	VkFFT::VkFFTSchedulerConfiguration schedulerConfiguration = {};
+	schedulerConfiguration.device = &device;
+	schedulerConfiguration.queues = schedulerQueues.data();
+	schedulerConfiguration.queueCount = (uint32_t)schedulerQueues.size();
+	schedulerConfiguration.queueFamilyIndex = queueFamilyIndex;
+	VkFFT::VkFFTScheduler scheduler;
+	if (scheduler.initializeScheduler(schedulerConfiguration) != VK_SUCCESS)
+		throw std::runtime_error("scheduler creation failed");
+
+	std::vector<VkBuffer> buffers(planCount);
+	std::vector<VkDeviceMemory> bufferDeviceMemory(planCount);
+	std::vector<VkFFT::VkFFTApplication> apps(planCount);
+	std::vector<bool> queueUsed(schedulerQueues.size(), false);
+	for (uint32_t i = 0; i < planCount; i++) {
+		if (allocateFFTBuffer(&buffers[i], &bufferDeviceMemory[i], VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, bufferSize) != VK_SUCCESS)
+			throw std::runtime_error("buffer allocation failed");
+		VkFFT::VkFFTConfiguration planConfiguration = configuration;
+		planConfiguration.buffer = &buffers[i];
+		planConfiguration.bufferSize = &bufferSize;
+		planConfiguration.bufferDeviceMemory = &bufferDeviceMemory[i];
+		if (apps[i].initializeVulkanFFT(planConfiguration) != VK_SUCCESS)
+			throw std::runtime_error("plan creation failed");
+		queueUsed[scheduler.addApplication(&apps[i], bufferSize)] = true;
+	}
+	VkSemaphoreCreateInfo semaphoreCreateInfo = { VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO };
+	VkSemaphore startSemaphore = {};
+	std::vector<VkSemaphore> doneSemaphores(schedulerQueues.size());
+	std::vector<VkSemaphore> usedDoneSemaphores;
+	vkCreateSemaphore(device, &semaphoreCreateInfo, NULL, &startSemaphore);
+	for (uint32_t q = 0; q < schedulerQueues.size(); q++) {
+		vkCreateSemaphore(device, &semaphoreCreateInfo, NULL, &doneSemaphores[q]);
+		if (queueUsed[q]) usedDoneSemaphores.push_back(doneSemaphores[q]);
+	}
+	std::vector<VkPipelineStageFlags> waitStages(usedDoneSemaphores.size(), VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+
+	std::vector<std::vector<cpx>> inputs(planCount, std::vector<cpx>(elements));
+	std::vector<float> buffer_cpu(bufferSize / sizeof(float));
+	std::vector<cpx> result(elements);
+	double maxError = 0, rmsError = 0;
+	for (uint32_t frame = 0; frame < 2; frame++) {
+		for (uint32_t i = 0; i < planCount; i++) {
+			fillRandom(inputs[i].data(), elements, false, generator);
+			complexToBuffer(inputs[i].data(), buffer_cpu.data(), configuration.size, false, 1);
+			transferDataFromCPU(buffer_cpu.data(), buffers[i], bufferSize);
+		}
+		//the start semaphore stands for the work of the frame before the transforms
+		VkSubmitInfo startSubmitInfo = { VK_STRUCTURE_TYPE_SUBMIT_INFO };
+		startSubmitInfo.signalSemaphoreCount = 1;
+		startSubmitInfo.pSignalSemaphores = &startSemaphore;
+		vkQueueSubmit(queue, 1, &startSubmitInfo, VK_NULL_HANDLE);
+		if (scheduler.submit(startSemaphore, doneSemaphores.data()) != VK_SUCCESS)
+			throw std::runtime_error("scheduler submit failed");
+		//and the done semaphores for the work after them
+		VkSubmitInfo doneSubmitInfo = { VK_STRUCTURE_TYPE_SUBMIT_INFO };
+		doneSubmitInfo.waitSemaphoreCount = (uint32_t)usedDoneSemaphores.size();
+		doneSubmitInfo.pWaitSemaphores = usedDoneSemaphores.data();
+		doneSubmitInfo.pWaitDstStageMask = waitStages.data();
+		vkQueueSubmit(queue, 1, &doneSubmitInfo, fence);
+		vkWaitForFences(device, 1, &fence, VK_TRUE, 100000000000);
+		vkResetFences(device, 1, &fence);
+		if (scheduler.wait() != VK_SUCCESS)
+			throw std::runtime_error("scheduler wait failed");
+		for (uint32_t i = 0; i < planCount; i++) {
+			transferDataToCPU(buffer_cpu.data(), buffers[i], bufferSize);
+			bufferToComplex(buffer_cpu.data(), result.data(), configuration.size, false, 1);
+			referenceFFT(inputs[i].data(), configuration.size, configuration.FFTdim, -1);
+			double planMaxError, planRmsError;
+			compare(result.data(), inputs[i].data(), elements, &planMaxError, &planRmsError);
+			if (planMaxError > maxError) maxError = planMaxError;
+			if (planRmsError > rmsError) rmsError = planRmsError;
+		}
+	}
+	char mode[32];
+	sprintf(mode, "%d plans %d queues", planCount, (uint32_t)schedulerQueues.size());
+	report(accuracyReport, "scheduler", &configuration, mode, maxError, rmsError);
+
+	//a plan added after a submit goes to a queue that wasn't submitted, waiting must only cover the submitted queues
+	VkFFT::VkFFTScheduler lateScheduler;
+	bool lateDone = (lateScheduler.initializeScheduler(schedulerConfiguration) == VK_SUCCESS);
+	if (lateDone) {
+		lateScheduler.addApplication(&apps[0], bufferSize);
+		lateDone = (lateScheduler.execute() == VK_SUCCESS) && (lateScheduler.submit() == VK_SUCCESS);
+		lateScheduler.addApplication(&apps[1], bufferSize);
+		lateDone = (lateDone) && (lateScheduler.wait() == VK_SUCCESS) && (lateScheduler.execute() == VK_SUCCESS);
+		lateScheduler.deleteScheduler();
+	}
+	report(accuracyReport, "scheduler", &configuration, "plan after submit", (lateDone) ? 0 : 1, 0);
+
+	scheduler.deleteScheduler();
+	vkDestroySemaphore(device, startSemaphore, NULL);
+	for (uint32_t q = 0; q < schedulerQueues.size(); q++)
+		vkDestroySemaphore(device, doneSemaphores[q], NULL);
+	for (uint32_t i = 0; i < planCount; i++) {
+		apps[i].deleteVulkanFFT();
+		vkDestroyBuffer(device, buffers[i], NULL);
+		vkFreeMemory(device, bufferDeviceMemory[i], NULL);
+	}
+}
+
+//additional logical devices on the same physical device, each stands for one GPU of a distributed plan
+void createLogicalDevices(uint32_t deviceCount, VkDevice* devices, VkQueue* queues) {
+	for (uint32_t i = 0; i < deviceCount; i++) {
+		VkDeviceQueueCreateInfo queueCreateInfo = { VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO };
+		queueCreateInfo.queueFamilyIndex = queueFamilyIndex;
+		queueCreateInfo.queueCount = 1;
+		float queuePriorities = 1.0;
+		queueCreateInfo.pQueuePriorities = &queuePriorities;
+		VkDeviceCreateInfo deviceCreateInfo = { VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO };
+		VkPhysicalDeviceFeatures deviceFeatures = {};
+		deviceCreateInfo.pQueueCreateInfos = &queueCreateInfo;
+		deviceCreateInfo.queueCreateInfoCount = 1;
+		deviceCreateInfo.pEnabledFeatures = &deviceFeatures;
+		if (vkCreateDevice(physicalDevice, &deviceCreateInfo, NULL, &devices[i]) != VK_SUCCESS) {
+			throw std::runtime_error("device creation failed");
+		}
+		vkGetDeviceQueue(devices[i], queueFamilyIndex, 0, &queues[i]);
+	}
+}
+
+//3D C2C slab decomposition between deviceCount logical devices against reference DFT, then inverse back to the input
+void testSlab(AccuracyReport* accuracyReport, uint32_t* size, uint32_t deviceCount, std::mt19937* generator) {
+	std::vector<VkDevice> devices(deviceCount);
+	std::vector<VkQueue> queues(deviceCount);
+	std::vector<VkPhysicalDevice> physicalDevices(deviceCount, physicalDevice);
+	std::vector<uint32_t> queueFamilyIndices(deviceCount, queueFamilyIndex);
+	createLogicalDevices(deviceCount, devices.data(), queues.data());
+	VkFFT::VkFFTConfiguration reportConfiguration = {};
+	reportConfiguration.FFTdim = 3;
+	for (uint32_t i = 0; i < 3; i++)
+		reportConfiguration.size[i] = size[i];
+	uint64_t elements = (uint64_t)size[0] * size[1] * size[2];
+	std::vector<cpx> input(elements), reference(elements), result(elements);
+	std::vector<float> data(2 * elements);
+	fillRandom(input.data(), elements, false, generator);
+	complexToBuffer(input.data(), data.data(), size, false, 1);
+
+	VkFFT::VkFFTSlabApplication app[2];
+	for (uint32_t inverse = 0; inverse < 2; inverse++) {
+		VkFFT::VkFFTSlabConfiguration configuration = {};
+		for (uint32_t i = 0; i < 3; i++)
+			configuration.size[i] = size[i];
+		configuration.inverse = inverse;
+		configuration.deviceCount = deviceCount;
+		configuration.physicalDevices = physicalDevices.data();
+		configuration.devices = devices.data();
+		configuration.queues = queues.data();
+		configuration.queueFamilyIndices = queueFamilyIndices.data();
+		sprintf(configuration.shaderPath, SHADER_DIR);
+		if (app[inverse].initializeVulkanFFTSlab(configuration) != VK_SUCCESS) {
+			throw std::runtime_error("slab plan creation failed");
+		}
+	}
+	char mode[32];
+	if (app[0].performVulkanFFTSlab(data.data()) != VK_SUCCESS) {
+		throw std::runtime_error("slab transform failed");
+	}
+	bufferToComplex(data.data(), result.data(), size, false, 1);
+	double maxError, rmsError;
+	reference = input;
+	referenceFFT(reference.data(), size, 3, -1);
+	compare(result.data(), reference.data(), elements, &maxError, &rmsError);
+	sprintf(mode, "%d devices", deviceCount);
+	report(accuracyReport, "slab", &reportConfiguration, mode, maxError, rmsError);
+
+	if (app[1].performVulkanFFTSlab(data.data()) != VK_SUCCESS) {
+		throw std::runtime_error("slab transform failed");
+	}
+	bufferToComplex(data.data(), result.data(), size, false, 1);
+	compare(result.data(), input.data(), elements, &maxError, &rmsError);
+	sprintf(mode, "%d devices", deviceCount);
+	report(accuracyReport, "slab_rt", &reportConfiguration, mode, maxError, rmsError);
+
+	for (uint32_t inverse = 0; inverse < 2; inverse++)
+		app[inverse].deleteVulkanFFTSlab();
+	for (uint32_t i = 0; i < deviceCount; i++)
+		vkDestroyDevice(devices[i], NULL);
+}
+//3D C2C pencil decomposition on a Pr x Pc grid of ranks in threads with loopback transport, forward against reference DFT, then inverse back to the input
+void testPencil(AccuracyReport* accuracyReport, uint32_t* size, uint32_t* processGrid, std::mt19937* generator) {
+	uint32_t ranks = processGrid[0] * processGrid[1];
+	std::vector<VkDevice> devices(ranks);
+	std::vector<VkQueue> queues(ranks);
+	createLogicalDevices(ranks, devices.data(), queues.data());
+	std::vector<VkFFT::VkFFTLoopbackTransport*> transports = VkFFT::VkFFTLoopbackTransport::create(ranks);
+	VkFFT::VkFFTConfiguration reportConfiguration = {};
+	reportConfiguration.FFTdim = 3;
+	for (uint32_t i = 0; i < 3; i++)
+		reportConfiguration.size[i] = size[i];
+	uint64_t elements = (uint64_t)size[0] * size[1] * size[2];
+	std::vector<cpx> input(elements), reference(elements), result(elements), roundTrip(elements);
+	fillRandom(input.data(), elements, false, generator);
+
+	//rank (r, c): x pencil [z][y][x] with y block r and z block c, z pencil [x][y][z] with x block r and y block c
+	uint32_t nx = size[0] / processGrid[0], ny = size[1] / processGrid[0], ny2 = size[1] / processGrid[1], nz = size[2] / processGrid[1];
+	std::vector<VkResult> results(ranks, VK_SUCCESS);
+	std::vector<std::thread> threads;
+	for (uint32_t rank = 0; rank < ranks; rank++) {
+		threads.push_back(std::thread([&, rank]() {
+			uint32_t r = rank % processGrid[0];
+			uint32_t c = rank / processGrid[0];
+			std::vector<float> data(2 * elements / ranks);
+			for (uint64_t z = 0; z < nz; z++)
+				for (uint64_t y = 0; y < ny; y++)
+					for (uint64_t x = 0; x < size[0]; x++) {
+						cpx value = input[((c * nz + z) * size[1] + r * ny + y) * size[0] + x];
+						data[2 * ((z * ny + y) * size[0] + x)] = value.real();
+						data[2 * ((z * ny + y) * size[0] + x) + 1] = value.imag();
+					}
+			VkFFT::VkFFTPencilApplication app[2];
+			for (uint32_t inverse = 0; (inverse < 2) && (results[rank] == VK_SUCCESS); inverse++) {
+				VkFFT::VkFFTPencilConfiguration configuration = {};
+				for (uint32_t i = 0; i < 3; i++)
+					configuration.size[i] = size[i];
+				configuration.processGrid[0] = processGrid[0];
+				configuration.processGrid[1] = processGrid[1];
+				configuration.inverse = inverse;
+				configuration.physicalDevice = &physicalDevice;
+				configuration.device = &devices[rank];
+				configuration.queue = &queues[rank];
+				configuration.queueFamilyIndex = queueFamilyIndex;
+				configuration.transport = transports[rank];
+				sprintf(configuration.shaderPath, SHADER_DIR);
+				results[rank] = app[inverse].initializeVulkanFFTPencil(configuration);
+			}
+			if (results[rank] == VK_SUCCESS)
+				results[rank] = app[0].performVulkanFFTPencil(data.data());
+			for (uint64_t x = 0; x < nx; x++)
+				for (uint64_t y = 0; y < ny2; y++)
+					for (uint64_t z = 0; z < size[2]; z++) {
+						uint64_t id = 2 * ((x * ny2 + y) * size[2] + z);
+						result[(z * size[1] + c * ny2 + y) * size[0] + r * nx + x] = cpx(data[id], data[id + 1]);
+					}
+			if (results[rank] == VK_SUCCESS)
+				results[rank] = app[1].performVulkanFFTPencil(data.data());
+			for (uint64_t z = 0; z < nz; z++)
+				for (uint64_t y = 0; y < ny; y++)
+					for (uint64_t x = 0; x < size[0]; x++) {
+						uint64_t id = 2 * ((z * ny + y) * size[0] + x);
+						roundTrip[((c * nz + z) * size[1] + r * ny + y) * size[0] + x] = cpx(data[id], data[id + 1]);
+					}
+			for (uint32_t inverse = 0; inverse < 2; inverse++)
+				app[inverse].deleteVulkanFFTPencil();
+		}));
+	}
+	for (uint32_t rank = 0; rank < ranks; rank++)
+		threads[rank].join();
+	for (uint32_t rank = 0; rank < ranks; rank++) {
+		if (results[rank] != VK_SUCCESS) {
+			throw std::runtime_error("pencil plan failed");
+		}
+	}
+	char mode[32];
+	double maxError, rmsError;
+	reference = input;
+	referenceFFT(reference.data(), size, 3, -1);
+	compare(result.data(), reference.data(), elements, &maxError, &rmsError);
+	sprintf(mode, "%dx%d ranks", processGrid[0], processGrid[1]);
+	report(accuracyReport, "pencil", &reportConfiguration, mode, maxError, rmsError);
+	compare(roundTrip.data(), input.data(), elements, &maxError, &rmsError);
+	report(accuracyReport, "pencil_rt", &reportConfiguration, mode, maxError, rmsError);
+
+	for (uint32_t rank = 0; rank < ranks; rank++) {
+		delete transports[rank];
+		vkDestroyDevice(devices[rank], NULL);
+	}
+}
+int main(int argc, char* argv[])
+{
+	uint32_t deviceID = 0;
+	bool quick = false;
+	uint32_t slabDevices = 2;
+	uint32_t pencilGrid[2] = { 2, 2 };
+	AccuracyReport accuracyReport;
+	for (int i = 1; i < argc; i++) {
+		if ((strcmp(argv[i], "-device") == 0) && (i + 1 < argc))
+			deviceID = atoi(argv[++i]);
+		else if ((strcmp(argv[i], "-tolerance") == 0) && (i + 1 < argc))
+			accuracyReport.tolerance = atof(argv[++i]);
+		else if ((strcmp(argv[i], "-slab_devices") == 0) && (i + 1 < argc))
+			slabDevices = atoi(argv[++i]);
+		else if ((strcmp(argv[i], "-pencil_grid") == 0) && (i + 2 < argc)) {
+			pencilGrid[0] = atoi(argv[++i]);
+			pencilGrid[1] = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "-quick") == 0)
+			quick = true;
+		else {
+			printf("Usage: VkFFT_accuracy [-device id] [-tolerance t] [-slab_devices n] [-pencil_grid Pr Pc] [-quick]\n");
+			return 1;
+		}
+	}
+
+	createInstance("VkFFT_accuracy");
+	findPhysicalDevice(deviceID);
+	createDevice();
+
+	//systems below 512 along y and z use grouped strided access, larger ones are transposed
+	const uint32_t sizes1D[][3] = { { 8, 4, 1 }, { 64, 16, 1 }, { 512, 8, 1 }, { 4096, 2, 1 } };
+	const uint32_t sizes2D[][3] = { { 16, 16, 1 }, { 64, 32, 1 }, { 256, 256, 1 }, { 1024, 512, 1 } };
+	const uint32_t sizes3D[][3] = { { 8, 8, 8 }, { 32, 32, 16 }, { 64, 64, 64 }, { 512, 512, 4 } };
+	const uint32_t(*sizes[3])[3] = { sizes1D, sizes2D, sizes3D };
+	uint32_t sizeCount = (quick) ? 2 : 4;
+	std::mt19937 generator(1);
+
+	for (uint32_t dim = 1; dim <= 3; dim++) {
+		for (uint32_t s = 0; s < sizeCount; s++) {
+			for (uint32_t r2c = 0; r2c < 2; r2c++) {
+				VkFFT::VkFFTConfiguration configuration = {};
+				configuration.FFTdim = dim;
+				for (uint32_t i = 0; i < 3; i++)
+					configuration.size[i] = sizes[dim - 1][s][i];
+				configuration.performR2C = r2c;
+				configuration.device = &device;
+				configuration.physicalDevice = &physicalDevice;
+				sprintf(configuration.shaderPath, SHADER_DIR);
+				//small 2D C2C systems are done by the fused kernel, which also writes natural layout
+				if (((dim == 1) || ((dim == 2) && (configuration.size[0] <= 64) && (configuration.size[1] <= 64))) && (!r2c)) {
+					VkFFT::VkFFTConfiguration fused_configuration = configuration;
+					fused_configuration.performFused2D = true;
+					for (uint32_t shift = 0; shift < 2; shift++)
+						testForward(&accuracyReport, fused_configuration, shift, &generator);
+					for (uint32_t accumulate = 0; accumulate < 2; accumulate++)
+						testSpectrum(&accuracyReport, fused_configuration, accumulate, &generator);
+				}
+				if ((dim == 1) && (r2c))
+					testForwardR2C(&accuracyReport, configuration, &generator);
+				testRoundTrip(&accuracyReport, configuration, &generator);
+				//fftshift of the forward and ifftshift of the inverse transform cancel
+				VkFFT::VkFFTConfiguration shift_configuration = configuration;
+				for (uint32_t i = 0; i < dim; i++)
+					shift_configuration.fftShift[i] = true;
+				testRoundTrip(&accuracyReport, shift_configuration, &generator);
+				if (r2c)
+					testWindow(&accuracyReport, configuration, &generator);
+				if ((r2c) && (dim == 1))
+					testSTFT(&accuracyReport, configuration, &generator);
+				//convolution is embedded in the last axis of 2D and 3D systems
+				if (dim == 1)
+					testConvolution1D(&accuracyReport, configuration);
+				if (dim > 1)
+					for (uint32_t m = 0; m < sizeof(convolutionModes) / sizeof(convolutionModes[0]); m++)
+						testConvolution(&accuracyReport, configuration, &convolutionModes[m], &generator);
+				if (dim > 1)
+					testAnalyticConvolution(&accuracyReport, configuration, &generator);
+			}
+		}
+	}
+	//fused 2D kernel against the per-axis path, single systems and batches
+	const uint32_t sizesFused[][3] = { { 4, 4, 1 }, { 8, 32, 1 }, { 64, 16, 3 }, { 32, 32, 2 }, { 64, 64, 1 } };
+	for (uint32_t s = 0; s < ((quick) ? 2 : 5); s++) {
+		VkFFT::VkFFTConfiguration configuration = {};
+		configuration.FFTdim = 2;
+		for (uint32_t i = 0; i < 3; i++)
+			configuration.size[i] = sizesFused[s][i];
+		configuration.device = &device;
+		configuration.physicalDevice = &physicalDevice;
+		sprintf(configuration.shaderPath, SHADER_DIR);
+		testFused2D(&accuracyReport, configuration, &generator);
+	}
+	//fused batch of more systems than workgroups in z, dispatched in chunks
+	VkPhysicalDeviceProperties deviceProperties;
+	vkGetPhysicalDeviceProperties(physicalDevice, &deviceProperties);
+	if ((!quick) && (deviceProperties.limits.maxComputeWorkGroupCount[2] < (1 << 20))) {
+		VkFFT::VkFFTConfiguration configuration = {};
+		configuration.FFTdim = 2;
+		configuration.size[0] = 4;
+		configuration.size[1] = 4;
+		configuration.size[2] = deviceProperties.limits.maxComputeWorkGroupCount[2] + 3;
+		configuration.device = &device;
+		configuration.physicalDevice = &physicalDevice;
+		sprintf(configuration.shaderPath, SHADER_DIR);
+		testFused2D(&accuracyReport, configuration, &generator);
+	}
+	//wisdom validation on a transposed and a grouped 2D plan
+	const uint32_t sizesWisdom[][3] = { { 1024, 512, 1 }, { 64, 32, 1 } };
+	for (uint32_t s = 0; s < 2; s++) {
+		VkFFT::VkFFTConfiguration configuration = {};
+		configuration.FFTdim = 2;
+		for (uint32_t i = 0; i < 3; i++)
+			configuration.size[i] = sizesWisdom[s][i];
+		configuration.device = &device;
+		configuration.physicalDevice = &physicalDevice;
+		sprintf(configuration.shaderPath, SHADER_DIR);
+		testWisdom(&accuracyReport, configuration);
+	}
+	//load and store callbacks of the first and last pass: 1D, 2D per-axis (grouped) and 2D fused
+	const uint32_t sizesCallbacks[][3] = { { 64, 16, 1 }, { 512, 8, 1 }, { 16, 16, 1 }, { 64, 32, 1 } };
+	for (uint32_t s = 0; s < 4; s++) {
+		for (uint32_t fused = 0; fused < ((s < 2) ? 1 : 2); fused++) {
+			VkFFT::VkFFTConfiguration configuration = {};
+			configuration.FFTdim = (s < 2) ? 1 : 2;
+			for (uint32_t i = 0; i < 3; i++)
+				configuration.size[i] = sizesCallbacks[s][i];
+			configuration.performFused2D = fused;
+			configuration.device = &device;
+			configuration.physicalDevice = &physicalDevice;
+			for (uint32_t callbacks = 1; callbacks < 4; callbacks++)
+				testCallbacks(&accuracyReport, configuration, callbacks & 1, callbacks & 2, &generator);
+		}
+	}
+	//integer input read by the first pass of 1D and 2D forward transforms, R2C and C2C
+	const uint32_t sizesInput[][3] = { { 64, 16, 1 }, { 32, 32, 1 } };
+	for (uint32_t s = 0; s < 2; s++) {
+		for (uint32_t r2c = 0; r2c < 2; r2c++) {
+			VkFFT::VkFFTConfiguration configuration = {};
+			configuration.FFTdim = s + 1;
+			for (uint32_t i = 0; i < 3; i++)
+				configuration.size[i] = sizesInput[s][i];
+			configuration.performR2C = r2c;
+			configuration.device = &device;
+			configuration.physicalDevice = &physicalDevice;
+			sprintf(configuration.shaderPath, SHADER_DIR);
+			for (uint32_t inputType = 1; inputType < 4; inputType++) {
+				if ((inputType == 1) ? storage8BitSupported : storage16BitSupported)
+					testInputType(&accuracyReport, configuration, inputType, &generator);
+				else
+					printf("input %s skipped, device has no %d-bit storage buffer access\n", (inputType == 1) ? "uint8" : ((inputType == 2) ? "uint16" : "int16"), (inputType == 1) ? 8 : 16);
+			}
+		}
+	}
+	//streamed 1D convolution, short and long filters, uniformly partitioned impulse responses
+	for (uint32_t overlapAdd = 0; overlapAdd < 2; overlapAdd++) {
+		testOverlap(&accuracyReport, 256, 17, overlapAdd, &generator);
+		if (!quick) testOverlap(&accuracyReport, 1024, 513, overlapAdd, &generator);
+	}
+	testPartitioned(&accuracyReport, 64, 1000, 24, &generator);
+	if (!quick) testPartitioned(&accuracyReport, 256, 10000, 48, &generator);
+	testStaging(&accuracyReport, 4096, 3, &generator);
+	testStaging(&accuracyReport, 256, 1, &generator);
+	//streamed batches and zero-copy host memory, 1D C2C output is in natural layout
+	VkFFT::VkFFTConfiguration helperConfiguration = {};
+	helperConfiguration.FFTdim = 1;
+	helperConfiguration.size[0] = 1024;
+	helperConfiguration.size[1] = 4;
+	helperConfiguration.size[2] = 1;
+	helperConfiguration.device = &device;
+	helperConfiguration.physicalDevice = &physicalDevice;
+	sprintf(helperConfiguration.shaderPath, SHADER_DIR);
+	if (timelineSemaphoreSupported)
+		testStream(&accuracyReport, helperConfiguration, (quick) ? 5 : 16, &generator);
+	else
+		printf("stream skipped, device has no timeline semaphores\n");
+	if (externalMemoryHostSupported)
+		testHostMemory(&accuracyReport, helperConfiguration, &generator);
+	else
+		printf("hostmemory skipped, device has no VK_EXT_external_memory_host\n");
+	testScheduler(&accuracyReport, helperConfiguration, 5, &generator);
+	//slab decomposed 3D systems, 0 disables
+	if (slabDevices > 0) {
+		uint32_t slabSizes[][3] = { { 32, 16, 32 }, { 128, 32, 128 } };
+		for (uint32_t s = 0; s < ((quick) ? 1 : 2); s++) {
+			if ((slabSizes[s][1] % slabDevices) || (slabSizes[s][2] % slabDevices))
+				printf("slab %dx%dx%d can't be split between %d devices, skipped\n", slabSizes[s][0], slabSizes[s][1], slabSizes[s][2], slabDevices);
+			else
+				testSlab(&accuracyReport, slabSizes[s], slabDevices, &generator);
+		}
+	}
+	//pencil decomposed 3D systems, 0 disables
+	if (pencilGrid[0] * pencilGrid[1] > 0) {
+		uint32_t pencilSizes[][3] = { { 32, 16, 32 }, { 128, 64, 64 } };
+		for (uint32_t s = 0; s < ((quick) ? 1 : 2); s++) {
+			if ((pencilSizes[s][0] % pencilGrid[0]) || (pencilSizes[s][1] % pencilGrid[0]) || (pencilSizes[s][1] % pencilGrid[1]) || (pencilSizes[s][2] % pencilGrid[1]))
+				printf("pencil %dx%dx%d can't be split between %dx%d ranks, skipped\n", pencilSizes[s][0], pencilSizes[s][1], pencilSizes[s][2], pencilGrid[0], pencilGrid[1]);
+			else
+				testPencil(&accuracyReport, pencilSizes[s], pencilGrid, &generator);
+		}
+	}
+	printf("%d of %d cases failed (tolerance %.1e)\n", accuracyReport.failed, accuracyReport.total, accuracyReport.tolerance);
+
+	destroyDevice();
+	return (accuracyReport.failed > 0) ? 1 : 0;
+}
@@ -0,0 +1,285 @@
+#include <iostream>
+#include <algorithm>
+#include <vkFFT.h>
+#include <vulkan/vulkan.h>
+#include <string.h>
+#include "VkFFT_utils.h"
+
+//VkFFT benchmark. Sweeps FFT dimensionality, sizes, C2C/R2C, direction, convolution variants and batch counts.
+//Batch is the number of systems transformed by one plan (1D systems along y, 2D along z, 3D as vectorDimension). Every plan is warmed up, then submitted repeatedly.
+//Reported time is GPU time of one VkFFTAppend of the whole batch, from timestamps written around it: median and 99th percentile of the submits.
+//Effective bandwidth assumes one read and one write of the whole buffer per FFT axis.
+//No validation layers are enabled, so it can run on software implementations (lavapipe, SwiftShader) in CI.
+//Usage: VkFFT_benchmark [-device id] [-dim 1|2|3] [-warmup n] [-repeat n] [-batch n] [-max_size n] [-max_elements n] [-quick] [-json] [-o file]
+
+typedef struct {
+	uint32_t deviceID = 0;
+	uint32_t dim = 0;//0 - all
+	uint32_t warmup = 3;
+	uint32_t repeat = 20;
+	uint32_t batch[3] = { 1, 16, 256 };//systems per plan
+	uint32_t batchCount = 3;
+	uint32_t maxSize = 4096;
+	uint64_t maxElements = 1 << 24;//complex numbers per plan (system size times batch), limits memory
+	bool json = false;
+	FILE* output = stdout;
+} BenchmarkParameters;
+
+typedef struct {
+	const char* name;
+	bool convolution;
+	uint32_t dataVectorDimension;
+	uint32_t kernelVectorDimension;
+	bool symmetricKernel;
+} BenchmarkMode;
+
+const BenchmarkMode modes[] = {
+	{ "fft", false, 1, 1, false },
+	{ "convolution_1x1", true, 1, 1, false },
+	{ "convolution_symmetric_2x2", true, 2, 3, true },
+	{ "convolution_nonsymmetric_2x2", true, 2, 4, false },
+	{ "convolution_symmetric_3x3", true, 3, 6, true },
+	{ "convolution_nonsymmetric_3x3", true, 3, 9, false },
+};
+
+//command buffer with VkFFTAppend between two timestamps, recorded once and resubmitted
+VkResult recordVulkanFFT(VkFFT::VkFFTApplication* app, VkQueryPool queryPool, VkCommandBuffer* commandBuffer) {
+	VkCommandBufferAllocateInfo commandBufferAllocateInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
+	commandBufferAllocateInfo.commandPool = commandPool;
+	commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+	commandBufferAllocateInfo.commandBufferCount = 1;
+	VkResult res = vkAllocateCommandBuffers(device, &commandBufferAllocateInfo, commandBuffer);
+	if (res != VK_SUCCESS) return res;
+	VkCommandBufferBeginInfo commandBufferBeginInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+	vkBeginCommandBuffer(commandBuffer[0], &commandBufferBeginInfo);
+	vkCmdResetQueryPool(commandBuffer[0], queryPool, 0, 2);
+	vkCmdWriteTimestamp(commandBuffer[0], VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, queryPool, 0);
+	app->VkFFTAppend(commandBuffer[0]);
+	vkCmdWriteTimestamp(commandBuffer[0], VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, queryPool, 1);
+	return vkEndCommandBuffer(commandBuffer[0]);
+}
+
+//GPU time of one submit in ms, negative if it failed
+double submitVulkanFFT(VkCommandBuffer commandBuffer, VkQueryPool queryPool, uint64_t timestampMask) {
+	VkSubmitInfo submitInfo = { VK_STRUCTURE_TYPE_SUBMIT_INFO };
+	submitInfo.commandBufferCount = 1;
+	submitInfo.pCommandBuffers = &commandBuffer;
+	if (vkQueueSubmit(queue, 1, &submitInfo, fence) != VK_SUCCESS) return -1;
+	vkWaitForFences(device, 1, &fence, VK_TRUE, 100000000000);
+	vkResetFences(device, 1, &fence);
+	uint64_t timestamps[2];
+	if (vkGetQueryPoolResults(device, queryPool, 0, 2, sizeof(timestamps), timestamps, sizeof(uint64_t), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT) != VK_SUCCESS) return -1;
+	return (double)((timestamps[1] - timestamps[0]) & timestampMask) * physicalDeviceProperties.limits.timestampPeriod * 0.000001;
+}
+
+//timestamps must be supported by the compute queue family the benchmark submits to
+uint64_t getTimestampMask() {
+	uint32_t queueFamilyCount;
+	vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, NULL);
+	std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+	vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, queueFamilies.data());
+	uint32_t validBits = queueFamilies[queueFamilyIndex].timestampValidBits;
+	if ((validBits == 0) && (!physicalDeviceProperties.limits.timestampComputeAndGraphics)) {
+		throw std::runtime_error("compute queue doesn't support timestamps");
+	}
+	return ((validBits > 0) && (validBits < 64)) ? (((uint64_t)1 << validBits) - 1) : ~(uint64_t)0;
+}
+
+void printHeader(BenchmarkParameters* parameters) {
+	if (parameters->json)
+		fprintf(parameters->output, "{\n\"device\": \"%s\",\n\"results\": [\n", physicalDeviceProperties.deviceName);
+	else
+		fprintf(parameters->output, "device,dim,size_x,size_y,size_z,type,direction,mode,batch,median_ms,p99_ms,bandwidth_GB_s\n");
+}
+
+void printResult(BenchmarkParameters* parameters, VkFFT::VkFFTConfiguration* configuration, const char* mode, uint32_t batch, double median, double p99, double bandwidth, bool first) {
+	const char* type = (configuration->performR2C) ? "r2c" : "c2c";
+	const char* direction = (configuration->performConvolution) ? "forward+inverse" : ((configuration->inverse) ? "inverse" : "forward");
+	if (parameters->json)
+		fprintf(parameters->output, "%s{\"dim\": %d, \"size\": [%d, %d, %d], \"type\": \"%s\", \"direction\": \"%s\", \"mode\": \"%s\", \"batch\": %d, \"median_ms\": %.6f, \"p99_ms\": %.6f, \"bandwidth_GB_s\": %.3f}", (first) ? "" : ",\n", configuration->FFTdim, configuration->size[0], configuration->size[1], configuration->size[2], type, direction, mode, batch, median, p99, bandwidth);
+	else
+		fprintf(parameters->output, "\"%s\",%d,%d,%d,%d,%s,%s,%s,%d,%.6f,%.6f,%.3f\n", physicalDeviceProperties.deviceName, configuration->FFTdim, configuration->size[0], configuration->size[1], configuration->size[2], type, direction, mode, batch, median, p99, bandwidth);
+	fflush(parameters->output);
+}
+
+void printFooter(BenchmarkParameters* parameters) {
+	if (parameters->json)
+		fprintf(parameters->output, "\n]\n}\n");
+}
+
+bool runBenchmark(BenchmarkParameters* parameters, VkFFT::VkFFTConfiguration configuration, const BenchmarkMode* mode, uint32_t batch, uint64_t timestampMask, bool first) {
+	uint32_t sizeX = (configuration.performR2C) ? configuration.size[0] / 2 + 1 : configuration.size[0];
+	VkDeviceSize bufferSize = configuration.vectorDimension * sizeof(float) * 2 * sizeX * configuration.size[1] * configuration.size[2];
+	VkDeviceSize kernelSize = mode->kernelVectorDimension * sizeof(float) * 2 * sizeX * configuration.size[1] * configuration.size[2];
+	VkBuffer buffer = {};
+	VkDeviceMemory bufferDeviceMemory = {};
+	VkBuffer kernel = {};
+	VkDeviceMemory kernelDeviceMemory = {};
+	if (allocateFFTBuffer(&buffer, &bufferDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, bufferSize) != VK_SUCCESS)
+		return false;
+	configuration.buffer = &buffer;
+	configuration.bufferSize = &bufferSize;
+	configuration.bufferDeviceMemory = &bufferDeviceMemory;
+	if (mode->convolution) {
+		if (allocateFFTBuffer(&kernel, &kernelDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, kernelSize) != VK_SUCCESS) {
+			vkDestroyBuffer(device, buffer, NULL);
+			vkFreeMemory(device, bufferDeviceMemory, NULL);
+			return false;
+		}
+		configuration.kernel = &kernel;
+		configuration.kernelSize = &kernelSize;
+		configuration.kernelDeviceMemory = &kernelDeviceMemory;
+	}
+	//Buffer contents are not initialized - timing does not depend on data.
+	VkFFT::VkFFTApplication app;
+	if (app.initializeVulkanFFT(configuration) != VK_SUCCESS)
+		throw std::runtime_error("plan creation failed");
+	VkQueryPool queryPool = {};
+	VkQueryPoolCreateInfo queryPoolCreateInfo = { VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO };
+	queryPoolCreateInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+	queryPoolCreateInfo.queryCount = 2;
+	if (vkCreateQueryPool(device, &queryPoolCreateInfo, NULL, &queryPool) != VK_SUCCESS)
+		throw std::runtime_error("query pool creation failed");
+	VkCommandBuffer commandBuffer = {};
+	if (recordVulkanFFT(&app, queryPool, &commandBuffer) != VK_SUCCESS)
+		throw std::runtime_error("command buffer recording failed");
+	for (uint32_t i = 0; i < parameters->warmup; i++)
+		submitVulkanFFT(commandBuffer, queryPool, timestampMask);
+	std::vector<double> times(parameters->repeat);
+	for (uint32_t i = 0; i < parameters->repeat; i++) {
+		times[i] = submitVulkanFFT(commandBuffer, queryPool, timestampMask);
+		if (times[i] < 0)
+			throw std::runtime_error("submit failed");
+	}
+	std::sort(times.begin(), times.end());
+	double median = (times.size() % 2) ? times[times.size() / 2] : 0.5 * (times[times.size() / 2 - 1] + times[times.size() / 2]);
+	double p99 = times[(uint32_t)ceil(0.99 * times.size()) - 1];
+	//convolution performs forward and inverse FFT in one append, the buffer holds the whole batch
+	uint32_t passes = (configuration.performConvolution) ? 2 * configuration.FFTdim : configuration.FFTdim;
+	double bandwidth = (median > 0) ? 2.0 * bufferSize * passes / (median * 1000000.0) : 0;
+	printResult(parameters, &configuration, mode->name, batch, median, p99, bandwidth, first);
+
+	vkFreeCommandBuffers(device, commandPool, 1, &commandBuffer);
+	vkDestroyQueryPool(device, queryPool, NULL);
+	app.deleteVulkanFFT();
+	vkDestroyBuffer(device, buffer, NULL);
+	vkFreeMemory(device, bufferDeviceMemory, NULL);
+	if (mode->convolution) {
+		vkDestroyBuffer(device, kernel, NULL);
+		vkFreeMemory(device, kernelDeviceMemory, NULL);
+	}
+	return true;
+}
+
+bool parseArguments(int argc, char* argv[], BenchmarkParameters* parameters) {
+	for (int i = 1; i < argc; i++) {
+		bool hasValue = (i + 1 < argc);
+		if ((strcmp(argv[i], "-device") == 0) && hasValue)
+			parameters->deviceID = atoi(argv[++i]);
+		else if ((strcmp(argv[i], "-dim") == 0) && hasValue)
+			parameters->dim = atoi(argv[++i]);
+		else if ((strcmp(argv[i], "-warmup") == 0) && hasValue)
+			parameters->warmup = atoi(argv[++i]);
+		else if ((strcmp(argv[i], "-repeat") == 0) && hasValue)
+			parameters->repeat = atoi(argv[++i]);
+		else if ((strcmp(argv[i], "-batch") == 0) && hasValue) {
+			parameters->batch[0] = atoi(argv[++i]);
+			parameters->batchCount = 1;
+			//batch is a dimension of the plan, which supports only powers of two
+			if ((parameters->batch[0] == 0) || (parameters->batch[0] & (parameters->batch[0] - 1))) {
+				printf("Batch must be a power of two: %s\n", argv[i]);
+				return false;
+			}
+		}
+		else if ((strcmp(argv[i], "-max_size") == 0) && hasValue)
+			parameters->maxSize = atoi(argv[++i]);
+		else if ((strcmp(argv[i], "-max_elements") == 0) && hasValue)
+			parameters->maxElements = atoll(argv[++i]);
+		else if (strcmp(argv[i], "-quick") == 0) {
+			//small sweep for software implementations
+			parameters->warmup = 1;
+			parameters->repeat = 5;
+			parameters->batch[0] = 1;
+			parameters->batchCount = 1;
+			parameters->maxSize = 256;
+			parameters->maxElements = 1 << 16;
+		}
+		else if (strcmp(argv[i], "-json") == 0)
+			parameters->json = true;
+		else if ((strcmp(argv[i], "-o") == 0) && hasValue) {
+			parameters->output = fopen(argv[++i], "w");
+			if (parameters->output == NULL) {
+				printf("Could not open output file: %s\n", argv[i]);
+				return false;
+			}
+		}
+		else {
+			printf("Unknown argument: %s\n", argv[i]);
+			printf("Usage: VkFFT_benchmark [-device id] [-dim 1|2|3] [-warmup n] [-repeat n] [-batch n] [-max_size n] [-max_elements n] [-quick] [-json] [-o file]\n");
+			return false;
+		}
+	}
+	if (parameters->repeat == 0) parameters->repeat = 1;
+	return true;
+}
+
+int main(int argc, char* argv[])
+{
+	BenchmarkParameters parameters;
+	if (!parseArguments(argc, argv, &parameters))
+		return 1;
+
+	createInstance("VkFFT_benchmark");
+	findPhysicalDevice(parameters.deviceID);
+	createDevice();
+	uint64_t timestampMask = getTimestampMask();
+
+	printHeader(&parameters);
+	bool first = true;
+	for (uint32_t dim = 1; dim <= 3; dim++) {
+		if ((parameters.dim != 0) && (parameters.dim != dim)) continue;
+		//1D, square 2D and cubic 3D systems. Batches of 1D systems are stacked along y, of 2D systems along z and of 3D systems as separate systems of vectorDimension
+		for (uint32_t size = 8; size <= parameters.maxSize; size *= 2) {
+			uint64_t elements = (dim == 1) ? size : ((dim == 2) ? (uint64_t)size * size : (uint64_t)size * size * size);
+			for (uint32_t b = 0; b < parameters.batchCount; b++) {
+				uint32_t batch = parameters.batch[b];
+				if (elements * batch > parameters.maxElements) continue;
+				for (uint32_t m = 0; m < sizeof(modes) / sizeof(modes[0]); m++) {
+					//vectorDimension of convolutions holds the data vector, so 3D convolutions are not batched
+					if ((dim == 3) && (modes[m].convolution) && (batch > 1)) continue;
+					for (uint32_t r2c = 0; r2c < 2; r2c++) {
+						//1D R2C transforms rows in pairs
+						if ((dim == 1) && (r2c) && (batch < 2)) continue;
+						for (uint32_t inverse = 0; inverse < 2; inverse++) {
+							//convolution always performs forward FFT, kernel multiplication and inverse FFT
+							if ((modes[m].convolution) && (inverse)) continue;
+							VkFFT::VkFFTConfiguration configuration = {};
+							configuration.FFTdim = dim;
+							configuration.size[0] = size;
+							configuration.size[1] = (dim > 1) ? size : batch;
+							configuration.size[2] = (dim > 2) ? size : ((dim == 2) ? batch : 1);
+							configuration.performR2C = r2c;
+							configuration.inverse = inverse;
+							configuration.performConvolution = modes[m].convolution;
+							configuration.vectorDimension = (modes[m].convolution) ? modes[m].dataVectorDimension : ((dim == 3) ? batch : 1);
+							configuration.symmetricKernel = modes[m].symmetricKernel;
+							configuration.device = &device;
+							configuration.physicalDevice = &physicalDevice;
+							sprintf(configuration.shaderPath, SHADER_DIR);
+							if (runBenchmark(&parameters, configuration, &modes[m], batch, timestampMask, first))
+								first = false;
+							else
+								fprintf(stderr, "Could not allocate buffers for %dD %dx%dx%d %s\n", dim, configuration.size[0], configuration.size[1], configuration.size[2], modes[m].name);
+						}
+					}
+				}
+			}
+		}
+	}
+	printFooter(&parameters);
+	if (parameters.output != stdout)
+		fclose(parameters.output);
+
+	destroyDevice();
+	return 0;
+}
@@ -0,0 +1,181 @@
+#pragma once
+#include <vector>
+#include <stdexcept>
+#include <string.h>
+#include <vulkan/vulkan.h>
+
+//Device setup shared by VkFFT_benchmark and VkFFT_accuracy: one instance without validation layers, one physical device, one logical device with up to 4 queues of one compute family,
+//a resettable command pool and a fence. Each executable is a single translation unit, so the Vulkan objects are kept as globals like in Vulkan_FFT.cpp.
+
+VkInstance instance = {};
+VkPhysicalDevice physicalDevice = {};
+VkPhysicalDeviceProperties physicalDeviceProperties = {};
+VkDevice device = {};
+uint32_t queueFamilyIndex = {};
+VkQueue queue = {};//first of computeQueues, used for everything but the multi-queue scheduler
+std::vector<VkQueue> computeQueues;
+VkCommandPool commandPool = {};
+VkFence fence = {};
+bool timelineSemaphoreSupported = false;//optional features are enabled when the device has them, tests of helpers that need them are skipped otherwise
+bool externalMemoryHostSupported = false;
+bool storage8BitSupported = false;//8 and 16-bit storage buffer access of the integer input
+bool storage16BitSupported = false;
+
+void createInstance(const char* applicationName) {
+	VkApplicationInfo applicationInfo = { VK_STRUCTURE_TYPE_APPLICATION_INFO };
+	applicationInfo.pApplicationName = applicationName;
+	applicationInfo.applicationVersion = 1.0;
+	applicationInfo.pEngineName = "VkFFT";
+	applicationInfo.engineVersion = 1.0;
+	applicationInfo.apiVersion = VK_API_VERSION_1_2;
+
+	VkInstanceCreateInfo createInfo = { VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO };
+	createInfo.pApplicationInfo = &applicationInfo;
+	if (vkCreateInstance(&createInfo, nullptr, &instance) != VK_SUCCESS) {
+		throw std::runtime_error("instance creation failed");
+	}
+}
+
+void findPhysicalDevice(uint32_t deviceID) {
+	uint32_t deviceCount;
+	vkEnumeratePhysicalDevices(instance, &deviceCount, NULL);
+	if (deviceCount == 0) {
+		throw std::runtime_error("device with vulkan support not found");
+	}
+	std::vector<VkPhysicalDevice> devices(deviceCount);
+	vkEnumeratePhysicalDevices(instance, &deviceCount, devices.data());
+	if (deviceID >= deviceCount) {
+		throw std::runtime_error("device id is out of range");
+	}
+	physicalDevice = devices[deviceID];
+	vkGetPhysicalDeviceProperties(physicalDevice, &physicalDeviceProperties);
+}
+
+uint32_t getComputeQueueFamilyIndex() {
+	uint32_t queueFamilyCount;
+	vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, NULL);
+	std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+	vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, queueFamilies.data());
+	uint32_t i = 0;
+	for (; i < queueFamilies.size(); ++i) {
+		if (queueFamilies[i].queueCount > 0 && (queueFamilies[i].queueFlags & VK_QUEUE_COMPUTE_BIT))
+			break;
+	}
+	if (i == queueFamilies.size()) {
+		throw std::runtime_error("queue family creation failed");
+	}
+	return i;
+}
+
+//also creates the command pool and the fence used for submits
+void createDevice() {
+	VkDeviceQueueCreateInfo queueCreateInfo = { VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO };
+	queueFamilyIndex = getComputeQueueFamilyIndex();
+	queueCreateInfo.queueFamilyIndex = queueFamilyIndex;
+	uint32_t queueFamilyCount;
+	vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, NULL);
+	std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+	vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, queueFamilies.data());
+	queueCreateInfo.queueCount = (queueFamilies[queueFamilyIndex].queueCount < 4) ? queueFamilies[queueFamilyIndex].queueCount : 4;
+	std::vector<float> queuePriorities(queueCreateInfo.queueCount, 1.0);
+	queueCreateInfo.pQueuePriorities = queuePriorities.data();
+	VkDeviceCreateInfo deviceCreateInfo = { VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO };
+	VkPhysicalDeviceFeatures deviceFeatures = {};
+	deviceCreateInfo.pQueueCreateInfos = &queueCreateInfo;
+	deviceCreateInfo.queueCreateInfoCount = 1;
+	deviceCreateInfo.pEnabledFeatures = &deviceFeatures;
+	//host pointer import of the zero-copy helper
+	uint32_t extensionCount = 0;
+	vkEnumerateDeviceExtensionProperties(physicalDevice, NULL, &extensionCount, NULL);
+	std::vector<VkExtensionProperties> extensions(extensionCount);
+	vkEnumerateDeviceExtensionProperties(physicalDevice, NULL, &extensionCount, extensions.data());
+	std::vector<const char*> enabledExtensions;
+	for (uint32_t i = 0; i < extensionCount; i++) {
+		if (!strcmp(extensions[i].extensionName, VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME)) {
+			externalMemoryHostSupported = true;
+			enabledExtensions.push_back(VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME);
+		}
+	}
+	deviceCreateInfo.enabledExtensionCount = (uint32_t)enabledExtensions.size();
+	deviceCreateInfo.ppEnabledExtensionNames = enabledExtensions.data();
+	//timeline semaphores of the streaming helper and 8-bit storage of the integer input are core in Vulkan 1.2, 16-bit storage in 1.1
+	VkPhysicalDeviceTimelineSemaphoreFeatures timelineSemaphoreFeatures = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES };
+	VkPhysicalDevice8BitStorageFeatures storage8BitFeatures = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_8BIT_STORAGE_FEATURES };
+	VkPhysicalDevice16BitStorageFeatures storage16BitFeatures = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_16BIT_STORAGE_FEATURES };
+	if (physicalDeviceProperties.apiVersion >= VK_API_VERSION_1_2) {
+		timelineSemaphoreFeatures.pNext = &storage8BitFeatures;
+		storage8BitFeatures.pNext = &storage16BitFeatures;
+		VkPhysicalDeviceFeatures2 features2 = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2 };
+		features2.pNext = &timelineSemaphoreFeatures;
+		vkGetPhysicalDeviceFeatures2(physicalDevice, &features2);
+		timelineSemaphoreSupported = timelineSemaphoreFeatures.timelineSemaphore;
+		storage8BitSupported = storage8BitFeatures.storageBuffer8BitAccess;
+		storage16BitSupported = storage16BitFeatures.storageBuffer16BitAccess;
+		//the supported features of the chain are enabled as reported
+		storage16BitFeatures.pNext = (void*)deviceCreateInfo.pNext;
+		deviceCreateInfo.pNext = &timelineSemaphoreFeatures;
+	}
+	if (vkCreateDevice(physicalDevice, &deviceCreateInfo, NULL, &device) != VK_SUCCESS) {
+		throw std::runtime_error("device creation failed");
+	}
+	computeQueues.resize(queueCreateInfo.queueCount);
+	for (uint32_t i = 0; i < queueCreateInfo.queueCount; i++)
+		vkGetDeviceQueue(device, queueFamilyIndex, i, &computeQueues[i]);
+	queue = computeQueues[0];
+	VkFenceCreateInfo fenceCreateInfo = { VK_STRUCTURE_TYPE_FENCE_CREATE_INFO };
+	if (vkCreateFence(device, &fenceCreateInfo, NULL, &fence) != VK_SUCCESS) {
+		throw std::runtime_error("fence creation failed");
+	}
+	VkCommandPoolCreateInfo commandPoolCreateInfo = { VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO };
+	commandPoolCreateInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+	commandPoolCreateInfo.queueFamilyIndex = queueFamilyIndex;
+	if (vkCreateCommandPool(device, &commandPoolCreateInfo, NULL, &commandPool) != VK_SUCCESS) {
+		throw std::runtime_error("command pool creation failed");
+	}
+}
+
+void destroyDevice() {
+	vkDestroyFence(device, fence, NULL);
+	vkDestroyCommandPool(device, commandPool, NULL);
+	vkDestroyDevice(device, NULL);
+	vkDestroyInstance(instance, NULL);
+}
+
+//returns -1 if no memory type has the properties
+uint32_t findMemoryType(uint32_t memoryTypeBits, VkMemoryPropertyFlags properties) {
+	VkPhysicalDeviceMemoryProperties memoryProperties = {};
+	vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memoryProperties);
+	for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; ++i) {
+		if ((memoryTypeBits & (1 << i)) && ((memoryProperties.memoryTypes[i].propertyFlags & properties) == properties))
+			return i;
+	}
+	return -1;
+}
+
+//nothing is left allocated if it fails
+VkResult allocateFFTBuffer(VkBuffer* buffer, VkDeviceMemory* deviceMemory, VkBufferUsageFlags usageFlags, VkMemoryPropertyFlags propertyFlags, VkDeviceSize size) {
+	VkBufferCreateInfo bufferCreateInfo = { VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
+	bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+	bufferCreateInfo.queueFamilyIndexCount = 1;
+	bufferCreateInfo.pQueueFamilyIndices = &queueFamilyIndex;
+	bufferCreateInfo.size = size;
+	bufferCreateInfo.usage = usageFlags;
+	VkResult res = vkCreateBuffer(device, &bufferCreateInfo, NULL, buffer);
+	if (res != VK_SUCCESS) return res;
+	VkMemoryRequirements memoryRequirements = {};
+	vkGetBufferMemoryRequirements(device, buffer[0], &memoryRequirements);
+	VkMemoryAllocateInfo memoryAllocateInfo = { VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO };
+	memoryAllocateInfo.allocationSize = memoryRequirements.size;
+	memoryAllocateInfo.memoryTypeIndex = findMemoryType(memoryRequirements.memoryTypeBits, propertyFlags);
+	res = (memoryAllocateInfo.memoryTypeIndex == (uint32_t)-1) ? VK_ERROR_OUT_OF_DEVICE_MEMORY : vkAllocateMemory(device, &memoryAllocateInfo, NULL, deviceMemory);
+	if (res != VK_SUCCESS) {
+		vkDestroyBuffer(device, buffer[0], NULL);
+		return res;
+	}
+	res = vkBindBufferMemory(device, buffer[0], deviceMemory[0], 0);
+	if (res != VK_SUCCESS) {
+		vkDestroyBuffer(device, buffer[0], NULL);
+		vkFreeMemory(device, deviceMemory[0], NULL);
+	}
+	return res;
+}
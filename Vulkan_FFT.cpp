@@ -1,5 +1,6 @@
 ﻿#include <iostream>
 #include <vkFFT.h>
+#include <vkFFT_staging.h>
 #include <vulkan/vulkan.h>
 #include <string.h>
 #ifdef NDEBUG
@@ -20,6 +21,7 @@ std::vector<const char*> enabledLayers;
 VkQueue queue = {};
 VkCommandPool commandPool = {};
 VkFence fence = {};
+VkFFT::VkFFTStagingPool stagingPool;
 
 const std::vector<const char*> validationLayers = {
 	"VK_LAYER_KHRONOS_validation"
@@ -249,75 +251,11 @@ void allocateFFTBuffer(VkBuffer* buffer, VkDeviceMemory* deviceMemory, VkBufferU
 
 }
 void transferDataFromCPU(float* arr, VkFFT::VkFFTConfiguration configuration) {
-	VkDeviceSize stagingBufferSize = configuration.bufferSize[0];
-	VkBuffer stagingBuffer = {};
-	VkDeviceMemory stagingBufferMemory = {};
-	allocateFFTBuffer(&stagingBuffer, &stagingBufferMemory, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, stagingBufferSize);
-
-	void* data;
-	vkMapMemory(device, stagingBufferMemory, 0, stagingBufferSize, 0, &data);
-	memcpy(data, arr, stagingBufferSize);
-	vkUnmapMemory(device, stagingBufferMemory);
-	VkCommandBufferAllocateInfo commandBufferAllocateInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
-	commandBufferAllocateInfo.commandPool = commandPool;
-	commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-	commandBufferAllocateInfo.commandBufferCount = 1;
-	VkCommandBuffer commandBuffer = {};
-	vkAllocateCommandBuffers(device, &commandBufferAllocateInfo, &commandBuffer);
-	VkCommandBufferBeginInfo commandBufferBeginInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
-	commandBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-	vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo);
-	VkBufferCopy copyRegion = {};
-	copyRegion.srcOffset = 0;
-	copyRegion.dstOffset = 0;
-	copyRegion.size = stagingBufferSize;
-	vkCmdCopyBuffer(commandBuffer, stagingBuffer, configuration.buffer[0], 1, &copyRegion);
-	vkEndCommandBuffer(commandBuffer);
-	VkSubmitInfo submitInfo = { VK_STRUCTURE_TYPE_SUBMIT_INFO };
-	submitInfo.commandBufferCount = 1;
-	submitInfo.pCommandBuffers = &commandBuffer;
-	vkQueueSubmit(queue, 1, &submitInfo, fence);
-	vkWaitForFences(device, 1, &fence, VK_TRUE, 100000000000);
-	vkResetFences(device, 1, &fence);
-	vkFreeCommandBuffers(device, commandPool, 1, &commandBuffer);
-	vkDestroyBuffer(device, stagingBuffer, NULL);
-	vkFreeMemory(device, stagingBufferMemory, NULL);
+	//Data goes through the persistently mapped chunks of the staging pool, so no staging memory is allocated per transfer.
+	stagingPool.upload(arr, configuration.buffer[0], configuration.bufferSize[0]);
 }
 void transferDataToCPU(float* arr, VkFFT::VkFFTConfiguration configuration) {
-	VkDeviceSize stagingBufferSize = configuration.bufferSize[0];
-	VkBuffer stagingBuffer = {};
-	VkDeviceMemory stagingBufferMemory = {};
-	allocateFFTBuffer(&stagingBuffer, &stagingBufferMemory, VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, stagingBufferSize);
-
-
-	VkCommandBufferAllocateInfo commandBufferAllocateInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
-	commandBufferAllocateInfo.commandPool = commandPool;
-	commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-	commandBufferAllocateInfo.commandBufferCount = 1;
-	VkCommandBuffer commandBuffer = {};
-	vkAllocateCommandBuffers(device, &commandBufferAllocateInfo, &commandBuffer);
-	VkCommandBufferBeginInfo commandBufferBeginInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
-	commandBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-	vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo);
-	VkBufferCopy copyRegion = {};
-	copyRegion.srcOffset = 0;
-	copyRegion.dstOffset = 0;
-	copyRegion.size = stagingBufferSize;
-	vkCmdCopyBuffer(commandBuffer, configuration.buffer[0], stagingBuffer, 1, &copyRegion);
-	vkEndCommandBuffer(commandBuffer);
-	VkSubmitInfo submitInfo = { VK_STRUCTURE_TYPE_SUBMIT_INFO };
-	submitInfo.commandBufferCount = 1;
-	submitInfo.pCommandBuffers = &commandBuffer;
-	vkQueueSubmit(queue, 1, &submitInfo, fence);
-	vkWaitForFences(device, 1, &fence, VK_TRUE, 100000000000);
-	vkResetFences(device, 1, &fence);
-	vkFreeCommandBuffers(device, commandPool, 1, &commandBuffer);
-	void* data;
-	vkMapMemory(device, stagingBufferMemory, 0, stagingBufferSize, 0, &data);
-	memcpy(arr, data, stagingBufferSize);
-	vkUnmapMemory(device, stagingBufferMemory);
-	vkDestroyBuffer(device, stagingBuffer, NULL);
-	vkFreeMemory(device, stagingBufferMemory, NULL);
+	stagingPool.download(arr, configuration.buffer[0], configuration.bufferSize[0]);
 }
 
 void performVulkanFFT(VkFFT::VkFFTApplication* app, uint32_t batch) {
@@ -390,6 +328,16 @@ int main()
 	commandPoolCreateInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
 	commandPoolCreateInfo.queueFamilyIndex = queueFamilyIndex;
 	vkCreateCommandPool(device, &commandPoolCreateInfo, NULL, &commandPool);
+	//Staging pool for host<->GPU copies. Buffers of any size are streamed through numChunks host-visible chunks of chunkSize bytes.
+	//Memory is mapped once and reused by every transfer. Two chunks let the host fill one chunk while the GPU copies the other.
+	VkFFT::VkFFTStagingPoolConfiguration stagingPoolConfiguration = {};
+	stagingPoolConfiguration.physicalDevice = &physicalDevice;
+	stagingPoolConfiguration.device = &device;
+	stagingPoolConfiguration.queue = &queue;
+	stagingPoolConfiguration.queueFamilyIndex = queueFamilyIndex;
+	stagingPoolConfiguration.chunkSize = 1 << 24;
+	stagingPoolConfiguration.numChunks = 2;
+	stagingPool.initializeStagingPool(stagingPoolConfiguration);
 	vkGetPhysicalDeviceProperties(physicalDevice, &physicalDeviceProperties);
 	vkGetPhysicalDeviceMemoryProperties(physicalDevice, &physicalDeviceMemoryProperties);
 
@@ -413,10 +361,17 @@ int main()
 		forward_configuration.performR2C = true; //Perform R2C/C2R transform. Can be combined with all other options. Reduces memory requirements by a factor of 2. Requires special input data alignment: for x*y*z system pad x*y plane to (x+2)*y with last 2*y elements reserved, total array dimensions are (x*y+2y)*z. Memory layout after R2C and before C2R can be found on github.
 		forward_configuration.vectorDimension = 1; //Specify dimensionality of the input data vector (default 1). Each component is stored not as a vector, but as a separate system and padded on it's own according to other options (i.e. for x*y system of 3-vector, first x*y elements correspond to the first dimension, then goes x*y for the second, etc). 
 		forward_configuration.inverse = false; //Direction of FFT. false - forward, true - inverse.
+		forward_configuration.performProfiling = false; //Set to true to write GPU timestamps around every dispatch VkFFT records. Per-stage times and achieved bandwidth of the last executed VkFFTAppend can be obtained with VkFFTGetProfilingResults. Timestamps add a small overhead to each dispatch.
+		forward_configuration.queueFamilyIndex = queueFamilyIndex; //Queue family VkFFTAppend command buffers are submitted to, profiling checks that it supports timestamps.
 		//After this, configuration file contains pointers to Vulkan objects needed to work with the GPU: VkDevice* device - created device, [VkDeviceSize *bufferSize, VkBuffer *buffer, VkDeviceMemory* bufferDeviceMemory] - allocated GPU memory FFT is performed on. [VkDeviceSize *kernelSize, VkBuffer *kernel, VkDeviceMemory* kernelDeviceMemory] - allocated GPU memory, where kernel for convolution is stored.
 		forward_configuration.device = &device;
+		forward_configuration.physicalDevice = &physicalDevice; //Physical device is used to query workgroup and shared memory limits the plan is sized from, and as wisdom key. If not set, desktop GPU limits are assumed.
 		//Custom path to the floder with shaders, default is "shaders/");
 		sprintf(forward_configuration.shaderPath, SHADER_DIR);
+		//Wisdom stores the plan parameters chosen for this device and driver. If a matching entry is found, it is used instead of the default parameter selection, otherwise the chosen parameters are added to it and can be exported.
+		VkFFT::VkFFTWisdom wisdom;
+		VkFFT::VkFFTImportWisdom(&wisdom, "VkFFT_wisdom.txt");
+		forward_configuration.wisdom = &wisdom;
 
 		//Allocate buffer for the input data.
 		VkDeviceSize bufferSize = forward_configuration.vectorDimension * sizeof(float) * 2 * (forward_configuration.size[0] / 2 + 1) * forward_configuration.size[1] * forward_configuration.size[2];;
@@ -449,10 +404,21 @@ int main()
 		//Sample buffer transfer tool. Uses staging buffer of the same size as destination buffer, which can be reduced if transfer is done sequentially in small buffers.
 		transferDataFromCPU(buffer_input, forward_configuration);
 		//Initialize applications. This function loads shaders, creates pipeline and configures FFT based on configuration file. No buffer allocations inside VkFFT library.  
-		app_forward.initializeVulkanFFT(forward_configuration);
-		app_inverse.initializeVulkanFFT(inverse_configuration);
+		if (app_forward.initializeVulkanFFT(forward_configuration) != VK_SUCCESS)
+			throw std::runtime_error("plan creation failed");
+		if (app_inverse.initializeVulkanFFT(inverse_configuration) != VK_SUCCESS)
+			throw std::runtime_error("plan creation failed");
+		VkFFT::VkFFTExportWisdom(&wisdom, "VkFFT_wisdom.txt");
 		//Submit FFT+iFFT.
 		performVulkanFFTiFFT(&app_forward, &app_inverse, 500);
+		//Print GPU time spent in each stage of the last FFT + iFFT pair, if profiling is enabled.
+		std::vector<VkFFT::VkFFTProfilingStage> stages;
+		if ((forward_configuration.performProfiling) && (app_forward.VkFFTGetProfilingResults(&stages)))
+			for (uint32_t i = 0; i < stages.size(); i++)
+				printf("FFT %s: %.3f ms %.1f GB/s\n", stages[i].name, stages[i].time * 1e-6, stages[i].bandwidth);
+		if ((inverse_configuration.performProfiling) && (app_inverse.VkFFTGetProfilingResults(&stages)))
+			for (uint32_t i = 0; i < stages.size(); i++)
+				printf("iFFT %s: %.3f ms %.1f GB/s\n", stages[i].name, stages[i].time * 1e-6, stages[i].bandwidth);
 		float* buffer_output = (float*)malloc(bufferSize);
 		//Transfer data from GPU using staging buffer.
 		transferDataToCPU(buffer_output, inverse_configuration);
@@ -469,6 +435,9 @@ int main()
 				}
 			}
 		}*/
+		//Release pipelines and descriptors created by VkFFT. Buffers are owned by the user.
+		app_forward.deleteVulkanFFT();
+		app_inverse.deleteVulkanFFT();
 		vkDestroyBuffer(device, buffer, NULL);
 		vkFreeMemory(device, bufferDeviceMemory, NULL);
 		break;
@@ -482,6 +451,7 @@ int main()
 		VkFFT::VkFFTApplication app_convolution;
 		VkFFT::VkFFTApplication app_kernel;
 		//Convolution sample code
+		//Here the kernel is transformed by hand with app_kernel. VkFFT::VkFFTKernel from vkFFT_kernel.h does padding, FFT and compressed storage of a spatial kernel in one call and can be attached to several convolution plans, see VkFFT_accuracy.cpp.
 		//Setting up FFT configuration. FFT is performed in-place with no performance loss. 
 		forward_configuration.FFTdim = 2; //FFT dimension, 1D, 2D or 3D (default 1).
 		forward_configuration.size[0] = 4096; //Multidimensional FFT dimensions sizes (default 1). For best performance (and stability), order dimensions in descendant size order as: x>y>z. 
@@ -495,6 +465,7 @@ int main()
 		forward_configuration.inverse = false; //Direction of FFT. false - forward, true - inverse.
 		//After this, configuration file contains pointers to Vulkan objects needed to work with the GPU: VkDevice* device - created device, [VkDeviceSize *bufferSize, VkBuffer *buffer, VkDeviceMemory* bufferDeviceMemory] - allocated GPU memory FFT is performed on. [VkDeviceSize *kernelSize, VkBuffer *kernel, VkDeviceMemory* kernelDeviceMemory] - allocated GPU memory, where kernel for convolution is stored.
 		forward_configuration.device = &device;
+		forward_configuration.physicalDevice = &physicalDevice;
 		sprintf(forward_configuration.shaderPath, SHADER_DIR);
 		//In this example, we perform a convolution for a real vectorfield (3vector) with a symmetric kernel (6 values). We use forward_configuration to initialize convolution kernel first from real data, then we create convolution_configuration for convolution. The buffer object from forward_configuration is passed to convolution_configuration as kernel object.
 		//1. Kernel forward FFT.
@@ -536,7 +507,8 @@ int main()
 		//Sample buffer transfer tool. Uses staging buffer of the same size as destination buffer, which can be reduced if transfer is done sequentially in small buffers.
 		transferDataFromCPU(kernel_input, forward_configuration);
 		//Initialize application responsible for the kernel. This function loads shaders, creates pipeline and configures FFT based on configuration file. No buffer allocations inside VkFFT library.  
-		app_kernel.initializeVulkanFFT(forward_configuration);
+		if (app_kernel.initializeVulkanFFT(forward_configuration) != VK_SUCCESS)
+			throw std::runtime_error("plan creation failed");
 		//Sample forward FFT command buffer allocation + execution performed on kernel. Second number determines how many times perform application in one submit. FFT can also be appended to user defined command buffers.
 		
 		//Uncomment the line below if you want to perform kernel FFT. In this sample we use predefined identitiy kernel.
@@ -582,7 +554,8 @@ int main()
 		transferDataFromCPU(buffer_input, convolution_configuration);
 
 		//Initialize application responsible for the convolution.
-		app_convolution.initializeVulkanFFT(convolution_configuration);
+		if (app_convolution.initializeVulkanFFT(convolution_configuration) != VK_SUCCESS)
+			throw std::runtime_error("plan creation failed");
 		//Sample forward FFT command buffer allocation + execution performed on kernel. FFT can also be appended to user defined command buffers.
 		performVulkanFFT(&app_convolution, 100);
 		//The kernel has been trasnformed.
@@ -603,6 +576,8 @@ int main()
 				}
 			}
 		}*/
+		app_kernel.deleteVulkanFFT();
+		app_convolution.deleteVulkanFFT();
 		vkDestroyBuffer(device, buffer, NULL);
 		vkFreeMemory(device, bufferDeviceMemory, NULL);
 		vkDestroyBuffer(device, kernel, NULL);
@@ -610,4 +585,5 @@ int main()
 		break;
 	}
 	}
+	stagingPool.deleteStagingPool();
 }
@@ -1,3 +1,4 @@
+#pragma once
 #include <vector>
 #include <memory>
 #include <string>
@@ -5,6 +6,7 @@
 #include <thread>
 #include <iostream>
 #include <cmath>
+#include <cstring>
 #include <vulkan/vulkan.h>
 typedef float scalar;
 using FFT_real_type = scalar;
@@ -13,6 +15,49 @@ using FFT_cpx_type = scalar[2];
 
 namespace VkFFT
 {
+	typedef struct {
+		//device the parameters were chosen on
+		uint8_t deviceUUID[VK_UUID_SIZE];
+		uint32_t driverVersion;
+		//configuration the parameters belong to
+		uint32_t size[3];
+		uint32_t FFTdim;
+		uint32_t vectorDimension;
+		bool performR2C;
+		bool performConvolution;
+		bool inverse;
+		bool performZeropadding;
+		bool symmetricKernel;
+		uint32_t inputChannels;
+		uint32_t outputChannels;
+		bool analyticKernel;
+		uint32_t filterBankSize;
+		//plan parameters
+		uint32_t radix;
+		bool performTranspose[2];
+		uint32_t groupedBatch[3];
+		uint32_t transposeBlock[2][2];
+		bool fused2D;
+	} VkFFTWisdomEntry;
+
+	typedef struct {
+		std::vector<VkFFTWisdomEntry> entries;
+	} VkFFTWisdom;
+
+	//checks of plan parameters that don't depend on the device, device limits are checked when the entry is looked up
+	inline bool VkFFTCheckWisdomEntry(VkFFTWisdomEntry* entry) {
+		if ((entry->radix != 2) && (entry->radix != 4) && (entry->radix != 8))
+			return false;
+		for (uint32_t i = 0; i < 3; i++)
+			if (entry->groupedBatch[i] == 0)
+				return false;
+		//transposes are planned for axes 1 and 2 of per-axis plans
+		for (uint32_t i = 0; i < 2; i++)
+			if ((!entry->fused2D) && (entry->performTranspose[i]) && (entry->FFTdim > i + 1) && ((entry->transposeBlock[i][0] == 0) || (entry->transposeBlock[i][1] == 0)))
+				return false;
+		return true;
+	}
+
 	typedef struct {
 
 		uint32_t size[3] = { 1,1,1 };
@@ -21,20 +66,50 @@ namespace VkFFT
 		uint32_t radix = 8;
 		bool performZeropadding = false;
 		bool performTranspose[2] = { true, true };
+		bool omitDimension[3] = { false, false, false };//axis is not transformed, the systems are only batched along it. Plans that omit an axis keep the natural layout (grouped strided access, no transposes) and are C2C without convolution
 		bool performConvolution = false;
 		bool performR2C = false;
 		bool inverse = false;
 		bool symmetricKernel=false;
+		uint32_t inputChannels = 0;//convolution with a kernel matrix: number of input systems, 0 - vectorDimension. Used when outputChannels is set or vectorDimension > 3
+		uint32_t outputChannels = 0;//number of output systems, 0 - inputChannels. They are written after the input ones, kernel entry (out, in) is system out*inputChannels+in
+		uint32_t filterBankSize = 0;//filter bank convolution: every input system is forward transformed once and convolved with each of filterBankSize kernels (systems 0..filterBankSize-1). Output c*filterBankSize+k is written after the inputs, outputChannels is ignored
+		bool analyticKernel = false;//kernel spectrum is computed in the convolution stage by analyticKernel() of shaders/vkFFT_analytic_kernel.glsl, compiled into vkFFT_convolution_analytic.spv of shaderPath (one analytic kernel per shader directory). Done as a kernel matrix convolution on the grouped (non-transposed) layout, no kernel buffer is needed
+		bool performCorrelation = false;//with performConvolution: data spectrum is multiplied by conj(kernel spectrum) in the convolution stage, giving cross-correlation with the kernel
+		bool performFused2D = false;//power of 2 2D C2C systems of up to 64x64 that fit in shared memory are done by one kernel per system, output is in natural layout
+		uint32_t windowType[3] = { 0,0,0 };//window of each axis applied to the real input while it is loaded by the forward R2C, no separate pass (C2C plans with a window fail): 0 - none, 1 - Hann, 2 - Hamming, 3 - Blackman-Harris, 4 - Kaiser. Windows are periodic, the window of a system is their product
+		float kaiserBeta = 8.6f;//shape of the Kaiser window
+		uint32_t spectrumOutput = 0;//last pass of the forward transform writes one float per bin to spectrumBuffer instead of the complex spectrum, in the same layout: 0 - off, 1 - power |X|^2, 2 - log-magnitude 10*log10(|X|^2) dB. Plans without spectrumBuffer or with convolution fail
+		bool accumulateSpectrum = false;//power is added to spectrumBuffer, which holds one system: the vectorDimension systems and consecutive VkFFTAppend calls are summed without a reduction pass (Welch PSD). Clear it before the first call. Plans batched along untransformed axes (size[1] or size[2] > 1 beyond FFTdim) fail, use vectorDimension for the segments. Only power is accumulated, log-magnitude plans fail
+		float spectrumScale = 1.0f;//power is multiplied by it, e.g. 1 / (segments * sum of squared window)
+		bool loadCallback = false;//loadCallback() of shaders/vkFFT_callbacks.glsl (compiled into the FFT shaders of shaderPath, one set per shader directory) is applied to every value read by the first pass of VkFFTAppend, in place of a separate pre-processing pass
+		bool storeCallback = false;//storeCallback() is applied to every value written by the last pass. Convolutions apply them to the data and to the result
+		bool fftShift[3] = { false, false, false };//per axis: forward transforms write the spectrum with zero frequency in the center (fftshift), inverse ones expect it there (ifftshift). Done as (-1)^n modulation of the spatial side by the pass that reads or writes it, no extra pass or memory. Convolution plans with fftShift fail
+		uint32_t inputType = 0;//samples of inputBuffer: 0 - float, 1 - uint8, 2 - uint16, 3 - int16 (complex samples are interleaved pairs for C2C). Integer samples are converted to float and multiplied by inputScale in registers by the first pass. Needs storageBuffer8BitAccess or storageBuffer16BitAccess (VK_KHR_8bit_storage/VK_KHR_16bit_storage) enabled on the device. Integer types without inputBuffer fail
+		float inputScale = 1.0f;
+		uint32_t stftHop = 0;//short-time Fourier transform: forward 1D R2C reads its size[1] frames of size[0] samples from inputBuffer, frame f starts at sample f*stftHop, so overlapping frames are not copied. windowType[0] windows each frame, the output is the time-frequency matrix in buffer (or spectrumBuffer). Other plans with stftHop fail
+		bool performProfiling = false;//write GPU timestamps around every dispatch recorded by VkFFTAppend, read them with VkFFTGetProfilingResults. Needs physicalDevice and a queue family with timestamp support, otherwise it is disabled
+		uint32_t queueFamilyIndex = 0;//queue family VkFFTAppend command buffers are submitted to, used to check its timestampValidBits
 		char shaderPath[256] = "shaders/";
+		VkPhysicalDevice* physicalDevice = 0;
 		VkDevice* device;
+		VkFFTWisdom* wisdom = 0;//plan parameters are taken from wisdom if it has a matching entry, otherwise the chosen ones are added to it
 
 		VkDeviceSize* bufferSize;
 		VkBuffer* buffer;
 		VkDeviceMemory* bufferDeviceMemory;
 
-		VkDeviceSize* kernelSize;
-		VkBuffer* kernel;
-		VkDeviceMemory* kernelDeviceMemory;
+		VkDeviceSize* spectrumBufferSize = 0;
+		VkBuffer* spectrumBuffer = 0;//spectrumOutput target, not used by convolutions
+		VkDeviceMemory* spectrumBufferDeviceMemory = 0;
+
+		VkDeviceSize* inputBufferSize = 0;
+		VkBuffer* inputBuffer = 0;//optional input of the forward transform, read by its first pass: systems of inputType samples packed one after another (no R2C padding), or the stftHop signal - vectorDimension signals of (size[1]-1)*stftHop+size[0] samples, each starts at an even offset. Output is written to buffer. Inverse plans with inputBuffer fail
+		VkDeviceMemory* inputBufferDeviceMemory = 0;
+
+		VkDeviceSize* kernelSize = 0;
+		VkBuffer* kernel = 0;//optional with analyticKernel, the buffer is then bound as parameters of analyticKernel()
+		VkDeviceMemory* kernelDeviceMemory = 0;
 
 	} VkFFTConfiguration;
 
@@ -50,6 +125,7 @@ namespace VkFFT
 		uint32_t inputOffset;
 		uint32_t outputOffset;
 		uint32_t coordinate;
+		uint32_t zOffset = 0;//z coordinate of the first invocation, set by VkFFTDispatchAxis for each chunk of a split dispatch
 	} VkFFTPushConstantsLayout;
 	typedef struct {
 		uint32_t inputStride[4];
@@ -60,6 +136,7 @@ namespace VkFFT
 	typedef struct {
 		uint32_t axisBlock[4];
 		uint32_t groupedBatch=16;
+		uint32_t offsetScale[2] = { 1,1 };//input/output buffer elements per complex number in z-stride units, 2 for the real side of r2c/c2r
 		VkFFTPushConstantsLayout pushConstants;
 		VkDescriptorPool descriptorPool;
 		VkDescriptorSetLayout descriptorSetLayout;
@@ -78,154 +155,628 @@ namespace VkFFT
 		VkPipeline pipeline;
 		VkShaderModule shaderModule;
 	} VkFFTTranspose;
+	typedef struct {
+		char name[64];
+		VkDeviceSize bytes;//estimated memory traffic of the dispatch, read + write
+		double time;//ns
+		double bandwidth;//GB/s
+	} VkFFTProfilingStage;
 	typedef struct {
 
 		VkFFTAxis axes[3];
 		VkFFTAxis supportAxes[2];//Nx/2+1 for r2c/c2r
 		VkFFTTranspose transpose[2];
+		VkFFTAxis fusedAxis;//both axes of a small 2D system in one kernel
 
 	} VkFFTPlan;
 
+	//buffer allocation shared by the helper headers
+	//index of the first memory type with all properties, -1 if the device has none
+	inline uint32_t VkFFTFindMemoryType(VkPhysicalDevice physicalDevice, uint32_t memoryTypeBits, VkMemoryPropertyFlags properties) {
+		VkPhysicalDeviceMemoryProperties memoryProperties = {};
+		vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memoryProperties);
+		for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; ++i) {
+			if ((memoryTypeBits & (1 << i)) && ((memoryProperties.memoryTypes[i].propertyFlags & properties) == properties))
+				return i;
+		}
+		return -1;
+	}
+	//creates the buffer and binds it to its own memory, nothing is left allocated if it fails
+	inline VkResult VkFFTAllocateBuffer(VkPhysicalDevice physicalDevice, VkDevice device, const VkBufferCreateInfo* bufferCreateInfo, VkMemoryPropertyFlags propertyFlags, VkBuffer* buffer, VkDeviceMemory* deviceMemory) {
+		VkResult res = vkCreateBuffer(device, bufferCreateInfo, NULL, buffer);
+		if (res != VK_SUCCESS) {
+			buffer[0] = VK_NULL_HANDLE;
+			return res;
+		}
+		VkMemoryRequirements memoryRequirements = {};
+		vkGetBufferMemoryRequirements(device, buffer[0], &memoryRequirements);
+		VkMemoryAllocateInfo memoryAllocateInfo = { VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO };
+		memoryAllocateInfo.allocationSize = memoryRequirements.size;
+		memoryAllocateInfo.memoryTypeIndex = VkFFTFindMemoryType(physicalDevice, memoryRequirements.memoryTypeBits, propertyFlags);
+		if (memoryAllocateInfo.memoryTypeIndex == (uint32_t)-1) {
+			printf("VkFFT found no memory type with properties 0x%x for a buffer\n", propertyFlags);
+			res = VK_ERROR_OUT_OF_DEVICE_MEMORY;
+		}
+		else
+			res = vkAllocateMemory(device, &memoryAllocateInfo, NULL, deviceMemory);
+		if (res != VK_SUCCESS) {
+			vkDestroyBuffer(device, buffer[0], NULL);
+			buffer[0] = VK_NULL_HANDLE;
+			deviceMemory[0] = VK_NULL_HANDLE;
+			return res;
+		}
+		res = vkBindBufferMemory(device, buffer[0], deviceMemory[0], 0);
+		if (res != VK_SUCCESS) {
+			vkDestroyBuffer(device, buffer[0], NULL);
+			vkFreeMemory(device, deviceMemory[0], NULL);
+			buffer[0] = VK_NULL_HANDLE;
+			deviceMemory[0] = VK_NULL_HANDLE;
+		}
+		return res;
+	}
+	//releases a buffer of VkFFTAllocateBuffer, null handles of a partial initialization are skipped
+	inline void VkFFTFreeBuffer(VkDevice device, VkBuffer* buffer, VkDeviceMemory* deviceMemory) {
+		if (buffer[0] != VK_NULL_HANDLE) vkDestroyBuffer(device, buffer[0], NULL);
+		if (deviceMemory[0] != VK_NULL_HANDLE) vkFreeMemory(device, deviceMemory[0], NULL);
+		buffer[0] = VK_NULL_HANDLE;
+		deviceMemory[0] = VK_NULL_HANDLE;
+	}
+	//reads shaderPath + shaderName, fails if the SPIR-V file is missing or unreadable (shaders are built by the VkFFT_shaders target)
+	inline VkResult VkFFTCreateShaderModule(VkDevice device, const char* shaderPath, const char* shaderName, VkShaderModule* shaderModule) {
+		char filename[512];
+		sprintf(filename, "%s%s", shaderPath, shaderName);
+		FILE* fp = fopen(filename, "rb");
+		if (fp == NULL) {
+			printf("Could not find or open file: %s\n", filename);
+			return VK_ERROR_INITIALIZATION_FAILED;
+		}
+		fseek(fp, 0, SEEK_END);
+		long filesize = ftell(fp);
+		fseek(fp, 0, SEEK_SET);
+		if ((filesize <= 0) || (filesize % 4 != 0)) {
+			printf("Not a SPIR-V file: %s\n", filename);
+			fclose(fp);
+			return VK_ERROR_INITIALIZATION_FAILED;
+		}
+		std::vector<uint32_t> code(filesize / 4);
+		size_t read = fread(code.data(), 1, filesize, fp);
+		fclose(fp);
+		if (read != (size_t)filesize) {
+			printf("Could not read file: %s\n", filename);
+			return VK_ERROR_INITIALIZATION_FAILED;
+		}
+		VkShaderModuleCreateInfo createInfo = { VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO };
+		createInfo.pCode = code.data();
+		createInfo.codeSize = filesize;
+		return vkCreateShaderModule(device, &createInfo, NULL, shaderModule);
+	}
+
 	class VkFFTApplication {
 	private:
 		VkFFTConfiguration configuration = {};
 		VkFFTPlan localFFTPlan = {};
 		VkFFTPlan localFFTPlan_inverse_convolution = {}; //additional inverse plan for convolution.
-		uint32_t* VkFFTReadShader(uint32_t& length, const char* filename) {
-
-			FILE* fp = fopen(filename, "rb");
-			if (fp == NULL) {
-				printf("Could not find or open file: %s\n", filename);
-			}
-
-			// get file size.
-			fseek(fp, 0, SEEK_END);
-			long filesize = ftell(fp);
-			fseek(fp, 0, SEEK_SET);
-
-			long filesizepadded = long(ceil(filesize / 4.0)) * 4;
-
-			char* str = new char[filesizepadded];
-			fread(str, filesize, sizeof(char), fp);
-			fclose(fp);
-
-			for (long i = filesize; i < filesizepadded; i++) {
-				str[i] = 0;
-			}
-
-			length = filesizepadded;
-			return (uint32_t*)str;
-		}
-		void VkFFTInitShader(uint32_t shader_id, VkShaderModule* shaderModule) {
-
-			char filename[256];
+		VkFFTWisdomEntry wisdomEntry = {};
+		bool useWisdom = false;
+		bool fused2D = false;
+		bool matrixConvolution = false;
+		uint32_t convolutionOutputs[2] = { 0, 1 };//first system and number of systems written by the convolution, inverse transforms are done on them
+		//device limits, defaults are the minimum guaranteed by the Vulkan specification
+		uint32_t maxComputeWorkGroupInvocations = 128;
+		uint32_t maxComputeSharedMemorySize = 16384;
+		uint32_t maxComputeWorkGroupCount[3] = { 65535,65535,65535 };
+		uint32_t maxSharedComplexNumbers = 2048;//largest power of 2 of complex numbers a workgroup can hold in shared memory
+		//profiling
+		VkQueryPool queryPool = VK_NULL_HANDLE;
+		uint32_t maxProfilingStages = 256;
+		float timestampPeriod = 1;
+		uint64_t timestampMask = ~(uint64_t)0;
+		std::vector<VkFFTProfilingStage> profilingStages;
+		VkResult VkFFTInitShader(uint32_t shader_id, VkShaderModule* shaderModule) {
+
+			const char* shaderName = NULL;
 			switch (shader_id) {
 			case 0:
 				//printf("vkFFT_single_c2c\n");
-				sprintf(filename, "%s%s", configuration.shaderPath, "vkFFT_single_c2c.spv");
+				shaderName = "vkFFT_single_c2c.spv";
 				break;
 			case 1:
 				//printf("vkFFT_single_c2r\n");
-				sprintf(filename, "%s%s", configuration.shaderPath, "vkFFT_single_c2r.spv");
+				shaderName = "vkFFT_single_c2r.spv";
 				break; 
 			case 2:
 				//printf("vkFFT_single_c2r_zp\n");
-				sprintf(filename, "%s%s", configuration.shaderPath, "vkFFT_single_c2r_zp.spv");
+				shaderName = "vkFFT_single_c2r_zp.spv";
 				break; 
 			case 3:
 				//printf("vkFFT_single_r2c\n");
-				sprintf(filename, "%s%s", configuration.shaderPath, "vkFFT_single_r2c.spv");
+				shaderName = "vkFFT_single_r2c.spv";
 				break;
 			case 4:
 				//printf("vkFFT_single_r2c_zp\n");
-				sprintf(filename, "%s%s", configuration.shaderPath, "vkFFT_single_r2c_zp.spv");
+				shaderName = "vkFFT_single_r2c_zp.spv";
 				break;
 			case 5:
 				//printf("vkFFT_single_c2c_afterR2C\n");
-				sprintf(filename, "%s%s", configuration.shaderPath, "vkFFT_single_c2c_afterR2C.spv");
+				shaderName = "vkFFT_single_c2c_afterR2C.spv";
 				break;
 			case 6:
 				//printf("vkFFT_single_c2c_beforeC2R\n");
-				sprintf(filename, "%s%s", configuration.shaderPath, "vkFFT_single_c2c_beforeC2R.spv");
+				shaderName = "vkFFT_single_c2c_beforeC2R.spv";
 				break;
 			case 7:
 				//printf("vkFFT_grouped_c2c\n");
-				sprintf(filename, "%s%s", configuration.shaderPath, "vkFFT_grouped_c2c.spv");
+				shaderName = "vkFFT_grouped_c2c.spv";
 				break;
 			case 8:
 				//printf("vkFFT_grouped_convolution_1x1\n");
-				sprintf(filename, "%s%s", configuration.shaderPath, "vkFFT_grouped_convolution_1x1.spv");
+				shaderName = "vkFFT_grouped_convolution_1x1.spv";
 				break;
 			case 9:
 				//printf("vkFFT_single_convolution_1x1\n");
-				sprintf(filename, "%s%s", configuration.shaderPath, "vkFFT_single_convolution_1x1.spv");
+				shaderName = "vkFFT_single_convolution_1x1.spv";
 				break;
 			case 10:
 				//printf("vkFFT_single_convolution_afterR2C_1x1\n");
-				sprintf(filename, "%s%s", configuration.shaderPath, "vkFFT_single_convolution_afterR2C_1x1.spv");
+				shaderName = "vkFFT_single_convolution_afterR2C_1x1.spv";
 				break;
 			case 11:
 				//printf("vkFFT_grouped_convolution_symmetric_2x2\n");
-				sprintf(filename, "%s%s", configuration.shaderPath, "vkFFT_grouped_convolution_symmetric_2x2.spv");
+				shaderName = "vkFFT_grouped_convolution_symmetric_2x2.spv";
 				break;
 			case 12:
 				//printf("vkFFT_single_convolution_symmetric_2x2\n");
-				sprintf(filename, "%s%s", configuration.shaderPath, "vkFFT_single_convolution_symmetric_2x2.spv");
+				shaderName = "vkFFT_single_convolution_symmetric_2x2.spv";
 				break;
 			case 13:
 				//printf("vkFFT_single_convolution_afterR2C_symmetric_2x2\n");
-				sprintf(filename, "%s%s", configuration.shaderPath, "vkFFT_single_convolution_afterR2C_symmetric_2x2.spv");
+				shaderName = "vkFFT_single_convolution_afterR2C_symmetric_2x2.spv";
 				break;
 			case 14:
 				//printf("vkFFT_grouped_convolution_nonsymmetric_2x2\n");
-				sprintf(filename, "%s%s", configuration.shaderPath, "vkFFT_grouped_convolution_nonsymmetric_2x2.spv");
+				shaderName = "vkFFT_grouped_convolution_nonsymmetric_2x2.spv";
 				break;
 			case 15:
 				//printf("vkFFT_single_convolution_nonsymmetric_2x2\n");
-				sprintf(filename, "%s%s", configuration.shaderPath, "vkFFT_single_convolution_nonsymmetric_2x2.spv");
+				shaderName = "vkFFT_single_convolution_nonsymmetric_2x2.spv";
 				break;
 			case 16:
 				//printf("vkFFT_single_convolution_afterR2C_nonsymmetric_2x2\n");
-				sprintf(filename, "%s%s", configuration.shaderPath, "vkFFT_single_convolution_afterR2C_nonsymmetric_2x2.spv");
+				shaderName = "vkFFT_single_convolution_afterR2C_nonsymmetric_2x2.spv";
 				break;
 			case 17:
 				//printf("vkFFT_grouped_convolution_symmetric_3x3\n");
-				sprintf(filename, "%s%s", configuration.shaderPath, "vkFFT_grouped_convolution_symmetric_3x3.spv");
+				shaderName = "vkFFT_grouped_convolution_symmetric_3x3.spv";
 				break;
 			case 18:
 				//printf("vkFFT_single_convolution_symmetric_3x3\n");
-				sprintf(filename, "%s%s", configuration.shaderPath, "vkFFT_single_convolution_symmetric_3x3.spv");
+				shaderName = "vkFFT_single_convolution_symmetric_3x3.spv";
 				break;
 			case 19:
 				//printf("vkFFT_single_convolution_afterR2C_symmetric_3x3\n");
-				sprintf(filename, "%s%s", configuration.shaderPath, "vkFFT_single_convolution_afterR2C_symmetric_3x3.spv");
+				shaderName = "vkFFT_single_convolution_afterR2C_symmetric_3x3.spv";
 				break;
 			case 20:
 				//printf("vkFFT_grouped_convolution_nonsymmetric_3x3\n");
-				sprintf(filename, "%s%s", configuration.shaderPath, "vkFFT_grouped_convolution_nonsymmetric_3x3.spv");
+				shaderName = "vkFFT_grouped_convolution_nonsymmetric_3x3.spv";
 				break;
 			case 21:
 				//printf("vkFFT_single_convolution_nonsymmetric_3x3\n");
-				sprintf(filename, "%s%s", configuration.shaderPath, "vkFFT_single_convolution_nonsymmetric_3x3.spv");
+				shaderName = "vkFFT_single_convolution_nonsymmetric_3x3.spv";
 				break;
 			case 22:
 				//printf("vkFFT_single_convolution_afterR2C_nonsymmetric_3x3\n");
-				sprintf(filename, "%s%s", configuration.shaderPath, "vkFFT_single_convolution_afterR2C_nonsymmetric_3x3.spv");
+				shaderName = "vkFFT_single_convolution_afterR2C_nonsymmetric_3x3.spv";
+				break;
+			case 23:
+				//printf("vkFFT_fused_2d_c2c\n");
+				shaderName = "vkFFT_fused_2d_c2c.spv";
+				break;
+			case 24:
+				//printf("vkFFT_convolution_matrix\n");
+				shaderName = "vkFFT_convolution_matrix.spv";
+				break;
+			case 25:
+				//printf("vkFFT_convolution_analytic\n");
+				shaderName = "vkFFT_convolution_analytic.spv";
+				break;
+			case 26:
+				//printf("vkFFT_single_c2c_int8\n");
+				shaderName = "vkFFT_single_c2c_int8.spv";
+				break;
+			case 27:
+				//printf("vkFFT_single_c2c_int16\n");
+				shaderName = "vkFFT_single_c2c_int16.spv";
+				break;
+			case 28:
+				//printf("vkFFT_single_r2c_int8\n");
+				shaderName = "vkFFT_single_r2c_int8.spv";
+				break;
+			case 29:
+				//printf("vkFFT_single_r2c_int16\n");
+				shaderName = "vkFFT_single_r2c_int16.spv";
 				break;
 
 			}
 
 			
-			uint32_t filelength;
-			uint32_t* code = VkFFTReadShader(filelength, filename);
-			VkShaderModuleCreateInfo createInfo = { VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO };
-			createInfo.pCode = code;
-			createInfo.codeSize = filelength;
-			vkCreateShaderModule(configuration.device[0], &createInfo, NULL, shaderModule);
-			delete[] code;
+			return VkFFTCreateShaderModule(configuration.device[0], configuration.shaderPath, shaderName, shaderModule);
+		}
+		void VkFFTPlanParameters(VkFFTPlan* FFTPlan) {
+			//choose between transposition and grouped strided access for axes 1 and 2
+			if (useWisdom) {
+				configuration.radix = wisdomEntry.radix;
+				for (uint32_t i = 0; i < 2; i++)
+					configuration.performTranspose[i] = wisdomEntry.performTranspose[i];
+				for (uint32_t i = 0; i < 3; i++)
+					FFTPlan->axes[i].groupedBatch = wisdomEntry.groupedBatch[i];
+				VkFFTForceGroupedLayout(FFTPlan);
+				return;
+			}
+			if (maxSharedComplexNumbers / configuration.size[1] > 8) {
+				configuration.performTranspose[0] = false;
+				FFTPlan->axes[1].groupedBatch = maxSharedComplexNumbers / configuration.size[1];
+			}
+			else {
+				configuration.performTranspose[0] = true;
+			}
 
+			if (maxSharedComplexNumbers / configuration.size[2] > 8) {
+				configuration.performTranspose[1] = false;
+				FFTPlan->axes[2].groupedBatch = maxSharedComplexNumbers / configuration.size[2];
+			}
+			else {
+				configuration.performTranspose[1] = true;
+			}
+			VkFFTForceGroupedLayout(FFTPlan);
+		}
+		bool VkFFTOmitsAxes() {
+			return (configuration.omitDimension[0]) || (configuration.omitDimension[1]) || (configuration.omitDimension[2]);
+		}
+		//analytic kernels get frequency indices from the grouped layout, where lines of the last axis are batched along x in natural order
+		//so do plans that omit an axis, their output is read in natural layout
+		void VkFFTForceGroupedLayout(VkFFTPlan* FFTPlan) {
+			if (!(((configuration.performConvolution) && (configuration.analyticKernel)) || (VkFFTOmitsAxes()))) return;
+			for (uint32_t i = 0; i < 2; i++) {
+				if (configuration.performTranspose[i]) {
+					configuration.performTranspose[i] = false;
+					FFTPlan->axes[i + 1].groupedBatch = (maxSharedComplexNumbers / configuration.size[i + 1] > 1) ? maxSharedComplexNumbers / configuration.size[i + 1] : 1;
+				}
+			}
+		}
+		void VkFFTGetDeviceLimits() {
+			if (configuration.physicalDevice != 0) {
+				VkPhysicalDeviceProperties properties;
+				vkGetPhysicalDeviceProperties(configuration.physicalDevice[0], &properties);
+				maxComputeWorkGroupInvocations = properties.limits.maxComputeWorkGroupInvocations;
+				maxComputeSharedMemorySize = properties.limits.maxComputeSharedMemorySize;
+				for (uint32_t i = 0; i < 3; i++)
+					maxComputeWorkGroupCount[i] = properties.limits.maxComputeWorkGroupCount[i];
+				timestampPeriod = properties.limits.timestampPeriod;
+			}
+			//without physicalDevice the member defaults, minimum limits of the Vulkan specification, are used
+			//each invocation processes 8 complex numbers
+			uint32_t sharedComplexNumbers = (maxComputeSharedMemorySize / (2 * sizeof(float)) < 8 * maxComputeWorkGroupInvocations) ? maxComputeSharedMemorySize / (2 * sizeof(float)) : 8 * maxComputeWorkGroupInvocations;
+			maxSharedComplexNumbers = pow(2, floor(log2(sharedComplexNumbers)));
+		}
+		//profiling is disabled if timestamps can't be written on the queue family VkFFTAppend is submitted to
+		void VkFFTCheckTimestamps() {
+			if (!configuration.performProfiling) return;
+			if (configuration.physicalDevice == 0) {
+				printf("VkFFT profiling needs configuration.physicalDevice to check timestamp support, profiling is disabled\n");
+				configuration.performProfiling = false;
+				return;
+			}
+			VkPhysicalDeviceProperties properties;
+			vkGetPhysicalDeviceProperties(configuration.physicalDevice[0], &properties);
+			uint32_t queueFamilyCount = 0;
+			vkGetPhysicalDeviceQueueFamilyProperties(configuration.physicalDevice[0], &queueFamilyCount, NULL);
+			std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+			vkGetPhysicalDeviceQueueFamilyProperties(configuration.physicalDevice[0], &queueFamilyCount, queueFamilies.data());
+			bool computeFamily = (configuration.queueFamilyIndex < queueFamilyCount) && (queueFamilies[configuration.queueFamilyIndex].queueFlags & VK_QUEUE_COMPUTE_BIT);
+			uint32_t validBits = (computeFamily) ? queueFamilies[configuration.queueFamilyIndex].timestampValidBits : 0;
+			//timestampComputeAndGraphics guarantees timestamps on every compute queue, otherwise the family has to report timestampValidBits
+			if ((!computeFamily) || ((!properties.limits.timestampComputeAndGraphics) && (validBits == 0))) {
+				printf("VkFFT profiling: queue family %d doesn't support timestamps, profiling is disabled\n", configuration.queueFamilyIndex);
+				configuration.performProfiling = false;
+				return;
+			}
+			timestampMask = ((validBits > 0) && (validBits < 64)) ? (((uint64_t)1 << validBits) - 1) : ~(uint64_t)0;
+		}
+		//8 and 16-bit storage must also be enabled when the device is created, VkFFT can only check that it is supported. Without physicalDevice the check is skipped
+		VkResult VkFFTCheckInputType() {
+			if (configuration.inputType > 3) {
+				printf("VkFFT inputType %u is not one of 0 - float, 1 - uint8, 2 - uint16, 3 - int16\n", configuration.inputType);
+				return VK_ERROR_INITIALIZATION_FAILED;
+			}
+			if ((configuration.inputType == 0) || (configuration.physicalDevice == 0)) return VK_SUCCESS;
+			VkPhysicalDevice16BitStorageFeatures storage16 = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_16BIT_STORAGE_FEATURES };
+			VkPhysicalDevice8BitStorageFeatures storage8 = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_8BIT_STORAGE_FEATURES };
+			storage8.pNext = &storage16;
+			VkPhysicalDeviceFeatures2 features = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2 };
+			features.pNext = &storage8;
+			vkGetPhysicalDeviceFeatures2(configuration.physicalDevice[0], &features);
+			if ((configuration.inputType == 1) && (!storage8.storageBuffer8BitAccess)) {
+				printf("VkFFT uint8 input needs storageBuffer8BitAccess, which the device doesn't support\n");
+				return VK_ERROR_INITIALIZATION_FAILED;
+			}
+			if ((configuration.inputType > 1) && (!storage16.storageBuffer16BitAccess)) {
+				printf("VkFFT 16-bit input needs storageBuffer16BitAccess, which the device doesn't support\n");
+				return VK_ERROR_INITIALIZATION_FAILED;
+			}
+			return VK_SUCCESS;
+		}
+		//axisBlock follows from the system size and the layout of the transposes, a plan whose workgroups don't fit the device is not created
+		VkResult VkFFTCheckAxisLimits(VkFFTAxis* axis, uint32_t axis_id) {
+			uint32_t invocations = axis->axisBlock[0] * axis->axisBlock[1] * axis->axisBlock[2];
+			if (invocations > maxComputeWorkGroupInvocations) {
+				printf("VkFFT axis %d needs %d invocations per workgroup, device limit is %d\n", axis_id, invocations, maxComputeWorkGroupInvocations);
+				return VK_ERROR_INITIALIZATION_FAILED;
+			}
+			if (8 * invocations * 2 * sizeof(float) > maxComputeSharedMemorySize) {
+				printf("VkFFT axis %d needs %d bytes of shared memory, device limit is %d\n", axis_id, (uint32_t)(8 * invocations * 2 * sizeof(float)), maxComputeSharedMemorySize);
+				return VK_ERROR_INITIALIZATION_FAILED;
+			}
+			return VK_SUCCESS;
+		}
+		//VkFFTDispatchAxis splits the z workgroup count of FFT passes. x and y counts are sizes of the other axes divided by the workgroup batch
+		//(bounded here by the sizes themselves) and the transposes are dispatched whole, so they must fit the device as planned
+		VkResult VkFFTCheckGridLimits(VkFFTPlan* FFTPlan) {
+			uint32_t gridXY = 0;
+			uint32_t gridZ = 0;
+			if (configuration.FFTdim == 1)
+				gridXY = ((configuration.performR2C) ? configuration.size[1] / 2 : configuration.size[1]) / FFTPlan->axes[0].axisBlock[1];
+			else {
+				gridXY = (configuration.performR2C) ? configuration.size[0] / 2 + 1 : configuration.size[0];
+				for (uint32_t i = 1; i < configuration.FFTdim; i++)
+					if (configuration.size[i] > gridXY) gridXY = configuration.size[i];
+				if (configuration.performTranspose[0])
+					gridZ = configuration.size[2];
+				if ((configuration.FFTdim > 2) && (configuration.performTranspose[1]) && (configuration.size[0] > gridZ))
+					gridZ = configuration.size[0];
+			}
+			uint32_t maxXY = (maxComputeWorkGroupCount[0] < maxComputeWorkGroupCount[1]) ? maxComputeWorkGroupCount[0] : maxComputeWorkGroupCount[1];
+			if ((gridXY > maxXY) || (gridZ > maxComputeWorkGroupCount[2])) {
+				printf("VkFFT dispatches need up to %d workgroups in x or y and %d in z of the transposes, device limit is %dx%dx%d\n", gridXY, gridZ, maxComputeWorkGroupCount[0], maxComputeWorkGroupCount[1], maxComputeWorkGroupCount[2]);
+				return VK_ERROR_INITIALIZATION_FAILED;
+			}
+			return VK_SUCCESS;
+		}
+		//user callbacks are compiled into every pass and enabled only in the one that reads the input of VkFFTAppend and the one that writes its output.
+		//Convolutions read the input in the forward plan and write the output in the inverse one, the convolution stage between them has no callbacks
+		uint32_t VkFFTLoadCallback(uint32_t axis_id, bool inverse) {
+			if (configuration.performConvolution)
+				return (configuration.loadCallback) && (!inverse) && (axis_id == 0);
+			return (configuration.loadCallback) && (axis_id == ((inverse) ? configuration.FFTdim - 1 : 0));
+		}
+		uint32_t VkFFTStoreCallback(uint32_t axis_id, bool inverse) {
+			if (configuration.performConvolution)
+				return (configuration.storeCallback) && (inverse) && (axis_id == 0);
+			return (configuration.storeCallback) && (axis_id == ((inverse) ? 0 : configuration.FFTdim - 1));
+		}
+		//windows are applied by the r2c shader of the forward axis 0, which reads the real input: types of the transformed axes, Kaiser beta as float bits and system size
+		void VkFFTWindowConstants(uint32_t axis_id, bool inverse, uint32_t* constants) {
+			bool windowed = (configuration.performR2C) && (!inverse) && (axis_id == 0);
+			for (uint32_t i = 0; i < 3; i++)
+				constants[i] = ((windowed) && (i < configuration.FFTdim)) ? configuration.windowType[i] : 0;
+			memcpy(&constants[3], &configuration.kaiserBeta, sizeof(float));
+			constants[4] = configuration.size[1];
+			constants[5] = configuration.size[2];
+		}
+		//spectrum output is written by the last pass of a forward transform: mode, accumulation, scale as float bits and the size of one system in the buffer
+		void VkFFTSpectrumConstants(uint32_t axis_id, bool inverse, uint32_t* constants) {
+			bool lastPass = (!inverse) && (!configuration.performConvolution) && (axis_id == configuration.FFTdim - 1);
+			constants[0] = (lastPass) ? configuration.spectrumOutput : 0;
+			constants[1] = configuration.accumulateSpectrum;
+			memcpy(&constants[2], &configuration.spectrumScale, sizeof(float));
+			constants[3] = ((configuration.performR2C) ? configuration.size[0] / 2 + 1 : configuration.size[0]) * configuration.size[1] * configuration.size[2];
+		}
+		//fftshift is a sign of the spatial side, applied by axis 0 that reads the input of a forward and writes the output of an inverse transform
+		void VkFFTShiftConstants(uint32_t axis_id, uint32_t* constants) {
+			for (uint32_t i = 0; i < 3; i++)
+				constants[i] = (configuration.fftShift[i]) && (i < configuration.FFTdim) && (axis_id == 0) && (!configuration.performConvolution);
+		}
+		//inputBuffer is bound instead of buffer as input of the forward axis 0. Short-time Fourier transform frames are read straight from the signal, row f
+		//of the r2c load starts at f*stftHop. Signals of vectorDimension are spaced by the even-rounded signal length, in complex numbers as the coordinate stride of the r2c shader
+		bool VkFFTReadsInputBuffer(uint32_t axis_id, bool inverse) {
+			return (configuration.inputBuffer != 0) && (axis_id == 0) && (!inverse);
+		}
+		uint32_t VkFFTSignalStride() {
+			return ((configuration.size[1] - 1) * configuration.stftHop + configuration.size[0] + 1) / 2;
 		}
-		void VkFFTPlanAxis(VkFFTPlan* FFTPlan, uint32_t axis_id, bool inverse) {
+		//integer samples are read by the _int8 or _int16 variant of the forward axis 0 shader, converted and scaled by it
+		uint32_t VkFFTFirstPassShader(uint32_t shader_id) {
+			if (configuration.inputType == 0)
+				return shader_id;
+			return ((shader_id == 3) ? 28 : 26) + ((configuration.inputType > 1) ? 1 : 0);
+		}
+		void VkFFTInputConstants(uint32_t axis_id, bool inverse, uint32_t* constants) {
+			constants[0] = (VkFFTReadsInputBuffer(axis_id, inverse)) ? configuration.inputType : 0;
+			memcpy(&constants[1], &configuration.inputScale, sizeof(float));
+		}
+		//binding 2: kernel of the convolution stage or spectrum output, the data buffer if the pipeline doesn't use it
+		void VkFFTBindingTwo(VkDescriptorBufferInfo* descriptorBufferInfo) {
+			descriptorBufferInfo->buffer = configuration.buffer[0];
+			descriptorBufferInfo->offset = 0;
+			descriptorBufferInfo->range = configuration.bufferSize[0];
+			if (configuration.kernel) {
+				descriptorBufferInfo->buffer = configuration.kernel[0];
+				descriptorBufferInfo->range = configuration.kernelSize[0];
+			}
+			else if (configuration.spectrumBuffer) {
+				descriptorBufferInfo->buffer = configuration.spectrumBuffer[0];
+				descriptorBufferInfo->range = configuration.spectrumBufferSize[0];
+			}
+		}
+		VkResult VkFFTInitMatrixConvolutionShader(VkFFTAxis* axis, bool grouped, bool afterR2C, bool supportLine, VkSpecializationInfo* specializationInfo, uint32_t* specializationData, VkSpecializationMapEntry* specializationMapEntries, VkShaderModule* shaderModule) {
+			//output channels are done in tiles of up to 4, so accumulators take at most 32 complex registers per invocation
+			uint32_t channelTile = (configuration.outputChannels < 4) ? configuration.outputChannels : 4;
+			//constants 11-15 place the line in the system for analytic kernels
+			uint32_t data[16] = { axis->axisBlock[0], axis->axisBlock[1], axis->axisBlock[2], axis->axisBlock[3], grouped, afterR2C, configuration.inputChannels, configuration.outputChannels, channelTile, configuration.performCorrelation,
+				supportLine, configuration.FFTdim, configuration.size[0], configuration.size[1], configuration.size[2], configuration.filterBankSize };
+			for (uint32_t i = 0; i < 16; i++) {
+				specializationData[i] = data[i];
+				specializationMapEntries[i].constantID = i + 1;
+				specializationMapEntries[i].size = sizeof(uint32_t);
+				specializationMapEntries[i].offset = i * sizeof(uint32_t);
+			}
+			specializationInfo->dataSize = 16 * sizeof(uint32_t);
+			specializationInfo->mapEntryCount = 16;
+			specializationInfo->pMapEntries = specializationMapEntries;
+			specializationInfo->pData = specializationData;
+			return VkFFTInitShader((configuration.analyticKernel) ? 25 : 24, shaderModule);
+		}
+		void VkFFTStageName(void* stage, char* name) {
+			VkFFTPlan* FFTPlans[2] = { &localFFTPlan, &localFFTPlan_inverse_convolution };
+			const char* planNames[2] = { "", "inverse " };
+			sprintf(name, "unknown");
+			for (uint32_t p = 0; p < 2; p++) {
+				for (uint32_t i = 0; i < 3; i++) {
+					if (stage == &FFTPlans[p]->axes[i]) {
+						if ((p == 0) && (configuration.performConvolution) && (i == configuration.FFTdim - 1))
+							sprintf(name, "axis %d + convolution", i);
+						else
+							sprintf(name, "%saxis %d", planNames[p], i);
+					}
+				}
+				for (uint32_t i = 0; i < 2; i++) {
+					if (stage == &FFTPlans[p]->supportAxes[i])
+						sprintf(name, "%ssupport axis %d", planNames[p], i);
+					if (stage == &FFTPlans[p]->transpose[i])
+						sprintf(name, "%stranspose %d", planNames[p], i);
+				}
+				if (stage == &FFTPlans[p]->fusedAxis)
+					sprintf(name, "%sfused axes 0-1", planNames[p]);
+			}
+		}
+		bool VkFFTProfilingBegin(VkCommandBuffer commandBuffer, void* stage, VkDeviceSize bytes) {
+			if ((!configuration.performProfiling) || (profilingStages.size() >= maxProfilingStages)) return false;
+			VkFFTProfilingStage profilingStage = {};
+			VkFFTStageName(stage, profilingStage.name);
+			profilingStage.bytes = bytes;
+			vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, queryPool, 2 * profilingStages.size());
+			profilingStages.push_back(profilingStage);
+			return true;
+		}
+		void VkFFTProfilingEnd(VkCommandBuffer commandBuffer) {
+			vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, queryPool, 2 * profilingStages.size() - 1);
+		}
+		void VkFFTDispatch(VkCommandBuffer commandBuffer, VkFFTAxis* axis, uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ) {
+			//each invocation reads and writes 8 complex numbers
+			bool profiled = VkFFTProfilingBegin(commandBuffer, axis, (VkDeviceSize)groupCountX * groupCountY * groupCountZ * axis->axisBlock[0] * axis->axisBlock[1] * axis->axisBlock[2] * 8 * 2 * 2 * sizeof(float));
+			VkFFTDispatchAxis(commandBuffer, axis, groupCountX, groupCountY, groupCountZ);
+			if (profiled) VkFFTProfilingEnd(commandBuffer);
+		}
+		void VkFFTDispatch(VkCommandBuffer commandBuffer, VkFFTTranspose* transpose, uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ) {
+			//each invocation reads and writes 1 complex number
+			bool profiled = VkFFTProfilingBegin(commandBuffer, transpose, (VkDeviceSize)groupCountX * groupCountY * groupCountZ * transpose->transposeBlock[0] * transpose->transposeBlock[1] * transpose->transposeBlock[2] * 2 * 2 * sizeof(float));
+			vkCmdDispatch(commandBuffer, groupCountX, groupCountY, groupCountZ);
+			if (profiled) VkFFTProfilingEnd(commandBuffer);
+		}
+		void VkFFTDispatchAxis(VkCommandBuffer commandBuffer, VkFFTAxis* axis, uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ) {
+			//x and y counts were checked by VkFFTCheckGridLimits
+			if (groupCountZ <= maxComputeWorkGroupCount[2]) {
+				vkCmdDispatch(commandBuffer, groupCountX, groupCountY, groupCountZ);
+				return;
+			}
+			//split along z - all shaders index z linearly through stride[2], so each chunk is shifted with buffer offsets. The z window and the fftshift sign read the global z coordinate from zOffset
+			VkFFTPushConstantsLayout pushConstants = axis->pushConstants;
+			for (uint32_t zOffset = 0; zOffset < groupCountZ; zOffset += maxComputeWorkGroupCount[2]) {
+				uint32_t zCount = (groupCountZ - zOffset < maxComputeWorkGroupCount[2]) ? groupCountZ - zOffset : maxComputeWorkGroupCount[2];
+				pushConstants.inputOffset = axis->pushConstants.inputOffset + axis->offsetScale[0] * zOffset * axis->axisBlock[2] * axis->pushConstants.inputStride[2];
+				pushConstants.outputOffset = axis->pushConstants.outputOffset + axis->offsetScale[1] * zOffset * axis->axisBlock[2] * axis->pushConstants.outputStride[2];
+				pushConstants.zOffset = axis->pushConstants.zOffset + zOffset * axis->axisBlock[2];
+				vkCmdPushConstants(commandBuffer, axis->pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(VkFFTPushConstantsLayout), &pushConstants);
+				vkCmdDispatch(commandBuffer, groupCountX, groupCountY, zCount);
+			}
+			vkCmdPushConstants(commandBuffer, axis->pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(VkFFTPushConstantsLayout), &axis->pushConstants);
+		}
+		bool VkFFTGetDeviceID(uint8_t* deviceUUID, uint32_t* driverVersion) {
+			if (configuration.physicalDevice == 0) {
+				printf("VkFFT wisdom requires configuration.physicalDevice to be set\n");
+				return false;
+			}
+			VkPhysicalDeviceIDProperties IDProperties = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ID_PROPERTIES };
+			VkPhysicalDeviceProperties2 properties = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2 };
+			properties.pNext = &IDProperties;
+			vkGetPhysicalDeviceProperties2(configuration.physicalDevice[0], &properties);
+			memcpy(deviceUUID, IDProperties.deviceUUID, VK_UUID_SIZE);
+			driverVersion[0] = properties.properties.driverVersion;
+			return true;
+		}
+		bool VkFFTWisdomKeyMatch(VkFFTWisdomEntry* entry) {
+			if ((entry->FFTdim != configuration.FFTdim) || (entry->vectorDimension != configuration.vectorDimension) || (entry->performR2C != configuration.performR2C) || (entry->performConvolution != configuration.performConvolution) || (entry->inverse != configuration.inverse))
+				return false;
+			if ((entry->performZeropadding != configuration.performZeropadding) || (entry->symmetricKernel != configuration.symmetricKernel) || (entry->inputChannels != configuration.inputChannels) || (entry->outputChannels != configuration.outputChannels) || (entry->analyticKernel != configuration.analyticKernel) || (entry->filterBankSize != configuration.filterBankSize))
+				return false;
+			for (uint32_t i = 0; i < 3; i++)
+				if (entry->size[i] != configuration.size[i])
+					return false;
+			return true;
+		}
+		//entries that don't fit this device are skipped, the plan parameters are then chosen as if there was no entry
+		bool VkFFTCheckWisdomLimits(VkFFTWisdomEntry* entry) {
+			if (!VkFFTCheckWisdomEntry(entry))
+				return false;
+			//grouped axes hold groupedBatch lines of the axis in shared memory
+			for (uint32_t i = 1; i < configuration.FFTdim; i++) {
+				uint32_t maxGroupedBatch = (maxSharedComplexNumbers / configuration.size[i] > 1) ? maxSharedComplexNumbers / configuration.size[i] : 1;
+				if ((!entry->performTranspose[i - 1]) && (entry->groupedBatch[i] > maxGroupedBatch))
+					return false;
+			}
+			//same bound as the transpose tiles chosen by VkFFTPlanTranspose, one invocation per tile element
+			uint32_t transposeInvocations = (maxComputeWorkGroupInvocations < maxSharedComplexNumbers / 2) ? maxComputeWorkGroupInvocations : maxSharedComplexNumbers / 2;
+			for (uint32_t i = 0; i < 2; i++)
+				if ((uint64_t)entry->transposeBlock[i][0] * entry->transposeBlock[i][1] > transposeInvocations)
+					return false;
+			return true;
+		}
+		void VkFFTFindWisdom() {
+			useWisdom = false;
+			//wisdom key has no omitted axes, such plans are neither looked up nor stored
+			if ((configuration.wisdom == 0) || (VkFFTOmitsAxes())) return;
+			if (!VkFFTGetDeviceID(wisdomEntry.deviceUUID, &wisdomEntry.driverVersion)) return;
+			for (uint32_t i = 0; i < configuration.wisdom->entries.size(); i++) {
+				VkFFTWisdomEntry* entry = &configuration.wisdom->entries[i];
+				if ((memcmp(entry->deviceUUID, wisdomEntry.deviceUUID, VK_UUID_SIZE) == 0) && (entry->driverVersion == wisdomEntry.driverVersion) && (VkFFTWisdomKeyMatch(entry))) {
+					if (!VkFFTCheckWisdomLimits(entry)) {
+						printf("VkFFT wisdom entry doesn't fit the device limits, plan parameters are chosen without it\n");
+						return;
+					}
+					wisdomEntry = entry[0];
+					useWisdom = true;
+					return;
+				}
+			}
+		}
+		void VkFFTStoreWisdom() {
+			if ((configuration.wisdom == 0) || (useWisdom) || (configuration.physicalDevice == 0) || (VkFFTOmitsAxes())) return;
+			for (uint32_t i = 0; i < 3; i++)
+				wisdomEntry.size[i] = configuration.size[i];
+			wisdomEntry.FFTdim = configuration.FFTdim;
+			wisdomEntry.vectorDimension = configuration.vectorDimension;
+			wisdomEntry.performR2C = configuration.performR2C;
+			wisdomEntry.performConvolution = configuration.performConvolution;
+			wisdomEntry.inverse = configuration.inverse;
+			wisdomEntry.performZeropadding = configuration.performZeropadding;
+			wisdomEntry.symmetricKernel = configuration.symmetricKernel;
+			wisdomEntry.inputChannels = configuration.inputChannels;
+			wisdomEntry.outputChannels = configuration.outputChannels;
+			wisdomEntry.analyticKernel = configuration.analyticKernel;
+			wisdomEntry.filterBankSize = configuration.filterBankSize;
+			wisdomEntry.radix = configuration.radix;
+			wisdomEntry.fused2D = fused2D;
+			for (uint32_t i = 0; i < 2; i++) {
+				wisdomEntry.performTranspose[i] = configuration.performTranspose[i];
+				wisdomEntry.transposeBlock[i][0] = localFFTPlan.transpose[i].transposeBlock[0];
+				wisdomEntry.transposeBlock[i][1] = localFFTPlan.transpose[i].transposeBlock[1];
+			}
+			for (uint32_t i = 0; i < 3; i++)
+				wisdomEntry.groupedBatch[i] = localFFTPlan.axes[i].groupedBatch;
+			configuration.wisdom->entries.push_back(wisdomEntry);
+		}
+		VkResult VkFFTPlanAxis(VkFFTPlan* FFTPlan, uint32_t axis_id, bool inverse) {
+			VkResult res = VK_SUCCESS;
 			//get radix stages
 			VkFFTAxis * axis = &FFTPlan->axes[axis_id];
 			//for (uint32_t i; i<3; i++)
@@ -277,21 +828,6 @@ namespace VkFFT
 					break;
 				}
 			}
-			if (4096 / configuration.size[1] > 8) {
-				configuration.performTranspose[0] = false;
-				FFTPlan->axes[1].groupedBatch = 4096 / configuration.size[1];
-			}
-			else {
-				configuration.performTranspose[0] = true;
-			}
-
-			if (4096 / configuration.size[2] > 8) {
-				configuration.performTranspose[1] = false;
-				FFTPlan->axes[2].groupedBatch = 4096 / configuration.size[2];
-			}
-			else {
-				configuration.performTranspose[1] = true;
-			}
 			//configure strides
 			if (configuration.performR2C)
 			{
@@ -394,6 +930,17 @@ namespace VkFFT
 				axis->pushConstants.outputStride[3] = axis->pushConstants.inputStride[3];
 			}
 			
+			if ((VkFFTReadsInputBuffer(axis_id, inverse)) && (configuration.stftHop > 0)) {
+				axis->pushConstants.inputStride[1] = configuration.stftHop;
+				axis->pushConstants.inputStride[2] = VkFFTSignalStride();
+				axis->pushConstants.inputStride[3] = VkFFTSignalStride();
+			}
+			else if ((VkFFTReadsInputBuffer(axis_id, inverse)) && (configuration.performR2C)) {
+				//real systems of inputBuffer are packed, without the padding of the in-place layout
+				axis->pushConstants.inputStride[2] = configuration.size[0] / 2 * configuration.size[1];
+				axis->pushConstants.inputStride[3] = configuration.size[0] / 2 * configuration.size[1] * configuration.size[2];
+			}
+
 			for (uint32_t i = 0; i < 3; ++i) {
 				axis->pushConstants.radixStride[i] = configuration.size[axis_id] / pow(2,i+1);
 				
@@ -590,13 +1137,12 @@ namespace VkFFT
 			}
 			axis->pushConstants.inputOffset = 0;
 			axis->pushConstants.outputOffset = 0;
+			axis->offsetScale[0] = ((configuration.performR2C) && (axis_id == 0) && (!inverse)) ? 2 : 1;
+			axis->offsetScale[1] = ((configuration.performR2C) && (axis_id == 0) && (inverse)) ? 2 : 1;
 			
 			VkDescriptorPoolSize descriptorPoolSize = { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER };
-			descriptorPoolSize.descriptorCount = 2;
-			if ((axis_id == 1) && (configuration.FFTdim == 2) && (configuration.performConvolution)) 
-				descriptorPoolSize.descriptorCount = 3;
-			if ((axis_id == 2) && (configuration.FFTdim == 3) && (configuration.performConvolution))
-				descriptorPoolSize.descriptorCount = 3;
+			//binding 2 is the kernel in convolution shaders and the spectrum output in FFT shaders
+			descriptorPoolSize.descriptorCount = 3;
 
 			VkDescriptorPoolCreateInfo descriptorPoolCreateInfo = { VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO };
 			descriptorPoolCreateInfo.poolSizeCount = 1;
@@ -632,7 +1178,10 @@ namespace VkFFT
 					descriptorBufferInfo.buffer = configuration.buffer[0];
 					descriptorBufferInfo.offset = 0;
 					descriptorBufferInfo.range = configuration.bufferSize[0];
-
+					if (VkFFTReadsInputBuffer(axis_id, inverse)) {
+						descriptorBufferInfo.buffer = configuration.inputBuffer[0];
+						descriptorBufferInfo.range = configuration.inputBufferSize[0];
+					}
 				}
 				if (i == 1) {
 					descriptorBufferInfo.buffer = configuration.buffer[0];
@@ -640,9 +1189,7 @@ namespace VkFFT
 					descriptorBufferInfo.range = configuration.bufferSize[0];
 				}
 				if (i == 2) {
-					descriptorBufferInfo.buffer = configuration.kernel[0];
-					descriptorBufferInfo.offset = 0;
-					descriptorBufferInfo.range = configuration.kernelSize[0];
+					VkFFTBindingTwo(&descriptorBufferInfo);
 				}
 					VkWriteDescriptorSet writeDescriptorSet = { VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET };
 					writeDescriptorSet.dstSet = axis->descriptorSet;
@@ -679,7 +1226,8 @@ namespace VkFFT
 					}
 					if (axis_id == 1) {
 						if (configuration.performTranspose[0]) {
-							VkFFTPlanTranspose(FFTPlan, 0);
+							res = VkFFTPlanTranspose(FFTPlan, 0);
+							if (res != VK_SUCCESS) return res;
 							FFTPlan->axes[axis_id].axisBlock[0] = (configuration.size[axis_id] / 8 > 1) ? configuration.size[axis_id] / 8 : 1;
 							FFTPlan->axes[axis_id].axisBlock[1] = (FFTPlan->axes[axis_id].pushConstants.ratioDirection[0]) ? FFTPlan->axes[axis_id].pushConstants.ratio[0] : 1;
 							FFTPlan->axes[axis_id].axisBlock[2] = 1;
@@ -687,7 +1235,8 @@ namespace VkFFT
 						}
 						else {
 							if (configuration.performR2C) {
-								VkFFTPlanSupportAxis(FFTPlan, 1, inverse);
+								res = VkFFTPlanSupportAxis(FFTPlan, 1, inverse);
+								if (res != VK_SUCCESS) return res;
 								FFTPlan->axes[axis_id].axisBlock[0] = (configuration.size[0] / 2 > FFTPlan->axes[axis_id].groupedBatch) ? FFTPlan->axes[axis_id].groupedBatch : configuration.size[0] / 2;
 							}
 							else
@@ -699,7 +1248,8 @@ namespace VkFFT
 					}
 					if (axis_id == 2) {
 						if (configuration.performTranspose[1]) {
-							VkFFTPlanTranspose(FFTPlan, 1);
+							res = VkFFTPlanTranspose(FFTPlan, 1);
+							if (res != VK_SUCCESS) return res;
 							FFTPlan->axes[axis_id].axisBlock[0] = (configuration.size[axis_id] / 8 > 1) ? configuration.size[axis_id] / 8 : 1;
 							FFTPlan->axes[axis_id].axisBlock[1] = (FFTPlan->axes[axis_id].pushConstants.ratioDirection[0]) ? FFTPlan->axes[axis_id].pushConstants.ratio[0] : 1;
 							FFTPlan->axes[axis_id].axisBlock[2] = 1;
@@ -714,7 +1264,8 @@ namespace VkFFT
 							}
 							else {
 								if (configuration.performR2C) {
-									VkFFTPlanSupportAxis(FFTPlan, 2, inverse);
+									res = VkFFTPlanSupportAxis(FFTPlan, 2, inverse);
+									if (res != VK_SUCCESS) return res;
 									FFTPlan->axes[axis_id].axisBlock[0] = (configuration.size[0] / 2 > FFTPlan->axes[axis_id].groupedBatch) ? FFTPlan->axes[axis_id].groupedBatch : configuration.size[0] / 2;
 								}
 								else
@@ -738,7 +1289,8 @@ namespace VkFFT
 					}
 					if (axis_id == 1) {
 						if (configuration.performTranspose[0]) {
-							VkFFTPlanTranspose(FFTPlan, 0);
+							res = VkFFTPlanTranspose(FFTPlan, 0);
+							if (res != VK_SUCCESS) return res;
 							FFTPlan->axes[axis_id].axisBlock[0] = (configuration.size[axis_id] / 8 > 1) ? configuration.size[axis_id] / 8 : 1;
 							FFTPlan->axes[axis_id].axisBlock[1] = (FFTPlan->axes[axis_id].pushConstants.ratioDirection[1]) ? 1 : FFTPlan->axes[axis_id].pushConstants.ratio[1] ;
 							FFTPlan->axes[axis_id].axisBlock[2] = 1;
@@ -746,7 +1298,8 @@ namespace VkFFT
 						}
 						else {
 							if (configuration.performR2C) {
-								VkFFTPlanSupportAxis(FFTPlan, 1, inverse);
+								res = VkFFTPlanSupportAxis(FFTPlan, 1, inverse);
+								if (res != VK_SUCCESS) return res;
 								FFTPlan->axes[axis_id].axisBlock[0] = (configuration.size[0] / 2 > FFTPlan->axes[axis_id].groupedBatch) ? FFTPlan->axes[axis_id].groupedBatch : configuration.size[0] / 2;
 							}
 							else
@@ -758,7 +1311,8 @@ namespace VkFFT
 					}
 					if (axis_id == 2) {
 						if (configuration.performTranspose[1]) {
-							VkFFTPlanTranspose(FFTPlan, 1);
+							res = VkFFTPlanTranspose(FFTPlan, 1);
+							if (res != VK_SUCCESS) return res;
 							FFTPlan->axes[axis_id].axisBlock[0] = (configuration.size[axis_id] / 8 > 1) ? configuration.size[axis_id] / 8 : 1;
 							FFTPlan->axes[axis_id].axisBlock[1] = (FFTPlan->axes[axis_id].pushConstants.ratioDirection[1]) ? 1 : FFTPlan->axes[axis_id].pushConstants.ratio[1];
 							FFTPlan->axes[axis_id].axisBlock[2] = 1;
@@ -773,7 +1327,8 @@ namespace VkFFT
 							}
 							else {
 								if (configuration.performR2C) {
-									VkFFTPlanSupportAxis(FFTPlan, 2, inverse);
+									res = VkFFTPlanSupportAxis(FFTPlan, 2, inverse);
+									if (res != VK_SUCCESS) return res;
 									FFTPlan->axes[axis_id].axisBlock[0] = (configuration.size[0] / 2 > FFTPlan->axes[axis_id].groupedBatch) ? FFTPlan->axes[axis_id].groupedBatch : configuration.size[0] / 2;
 								}
 								else
@@ -786,44 +1341,53 @@ namespace VkFFT
 					}
 
 				}
-				VkSpecializationMapEntry specializationMapEntries[4] = { {} };
-				specializationMapEntries[0].constantID = 1;
-				specializationMapEntries[0].size = sizeof(uint32_t);
-				specializationMapEntries[0].offset = 0;
-				specializationMapEntries[1].constantID = 2;
-				specializationMapEntries[1].size = sizeof(uint32_t);
-				specializationMapEntries[1].offset = sizeof(uint32_t);
-				specializationMapEntries[2].constantID = 3;
-				specializationMapEntries[2].size = sizeof(uint32_t);
-				specializationMapEntries[2].offset = 2 * sizeof(uint32_t);
-				specializationMapEntries[3].constantID = 4;
-				specializationMapEntries[3].size = sizeof(uint32_t);
-				specializationMapEntries[3].offset = 3 * sizeof(uint32_t);
+				res = VkFFTCheckAxisLimits(axis, axis_id);
+				if (res != VK_SUCCESS) return res;
+				//axisBlock with fft_dim, kernel conjugation used by convolution shaders, user callbacks, r2c input windows, spectrum output, fftshift and integer input
+				uint32_t specializationData[22] = { FFTPlan->axes[axis_id].axisBlock[0], FFTPlan->axes[axis_id].axisBlock[1], FFTPlan->axes[axis_id].axisBlock[2], FFTPlan->axes[axis_id].axisBlock[3], configuration.performCorrelation, VkFFTLoadCallback(axis_id, inverse), VkFFTStoreCallback(axis_id, inverse) };
+				VkFFTWindowConstants(axis_id, inverse, &specializationData[7]);
+				VkFFTSpectrumConstants(axis_id, inverse, &specializationData[13]);
+				VkFFTShiftConstants(axis_id, &specializationData[17]);
+				VkFFTInputConstants(axis_id, inverse, &specializationData[20]);
+				VkSpecializationMapEntry specializationMapEntries[22] = { {} };
+				for (uint32_t i = 0; i < 22; i++) {
+					specializationMapEntries[i].constantID = i + 1;
+					specializationMapEntries[i].size = sizeof(uint32_t);
+					specializationMapEntries[i].offset = i * sizeof(uint32_t);
+				}
 
 				VkSpecializationInfo specializationInfo={};
-				specializationInfo.dataSize = 4 * sizeof(uint32_t);
-				specializationInfo.mapEntryCount = 4;
+				specializationInfo.dataSize = 22 * sizeof(uint32_t);
+				specializationInfo.mapEntryCount = 22;
 				specializationInfo.pMapEntries = specializationMapEntries;
-				specializationInfo.pData = &FFTPlan->axes[axis_id].axisBlock;
+				specializationInfo.pData = specializationData;
 				VkPipelineShaderStageCreateInfo pipelineShaderStageCreateInfo = { VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO };
 		
 				VkComputePipelineCreateInfo computePipelineCreateInfo = { VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO };
 
 
 				pipelineShaderStageCreateInfo.stage = VK_SHADER_STAGE_COMPUTE_BIT;
-				if (configuration.performR2C) {
+				uint32_t matrixSpecializationData[16];
+				VkSpecializationMapEntry matrixSpecializationMapEntries[16];
+				if ((matrixConvolution) && (axis_id == configuration.FFTdim - 1)) {
+					//same layouts as the 1x1 shaders: grouped if the last axis was not transposed, r2c after 0-1 transpose has the extra line in the last workgroup
+					bool grouped = (configuration.FFTdim == 2) ? !configuration.performTranspose[0] : !configuration.performTranspose[1];
+					bool afterR2C = (configuration.performR2C) && (configuration.FFTdim == 2) && (configuration.performTranspose[0]);
+					res = VkFFTInitMatrixConvolutionShader(&FFTPlan->axes[axis_id], grouped, afterR2C, false, &specializationInfo, matrixSpecializationData, matrixSpecializationMapEntries, &pipelineShaderStageCreateInfo.module);
+				}
+				else if (configuration.performR2C) {
 					if (axis_id == 0) {
 						if (inverse) {
 							if (configuration.performZeropadding)
-								VkFFTInitShader(2, &pipelineShaderStageCreateInfo.module);
+								res = VkFFTInitShader(2, &pipelineShaderStageCreateInfo.module);
 							else
-								VkFFTInitShader(1, &pipelineShaderStageCreateInfo.module);
+								res = VkFFTInitShader(1, &pipelineShaderStageCreateInfo.module);
 						}
 						else {
 							if (configuration.performZeropadding)
-								VkFFTInitShader(4, &pipelineShaderStageCreateInfo.module);
+								res = VkFFTInitShader(4, &pipelineShaderStageCreateInfo.module);
 							else
-								VkFFTInitShader(3, &pipelineShaderStageCreateInfo.module);
+								res = VkFFTInitShader(VkFFTFirstPassShader(3), &pipelineShaderStageCreateInfo.module);
 							
 						}
 					}
@@ -833,37 +1397,37 @@ namespace VkFFT
 							if (configuration.performTranspose[0]) 
 								switch (configuration.vectorDimension) {
 								case 1:
-									VkFFTInitShader(10, &pipelineShaderStageCreateInfo.module);
+									res = VkFFTInitShader(10, &pipelineShaderStageCreateInfo.module);
 									break;
 								case 2:
 									if (configuration.symmetricKernel)
-										VkFFTInitShader(13, &pipelineShaderStageCreateInfo.module);
+										res = VkFFTInitShader(13, &pipelineShaderStageCreateInfo.module);
 									else
-										VkFFTInitShader(16, &pipelineShaderStageCreateInfo.module);
+										res = VkFFTInitShader(16, &pipelineShaderStageCreateInfo.module);
 									break;
 								case 3:
 									if (configuration.symmetricKernel)
-										VkFFTInitShader(19, &pipelineShaderStageCreateInfo.module);
+										res = VkFFTInitShader(19, &pipelineShaderStageCreateInfo.module);
 									else
-										VkFFTInitShader(22, &pipelineShaderStageCreateInfo.module);
+										res = VkFFTInitShader(22, &pipelineShaderStageCreateInfo.module);
 									break;
 								}
 							else 
 								switch (configuration.vectorDimension) {
 								case 1:
-									VkFFTInitShader(8, &pipelineShaderStageCreateInfo.module);
+									res = VkFFTInitShader(8, &pipelineShaderStageCreateInfo.module);
 									break;
 								case 2:
 									if (configuration.symmetricKernel)
-										VkFFTInitShader(11, &pipelineShaderStageCreateInfo.module);
+										res = VkFFTInitShader(11, &pipelineShaderStageCreateInfo.module);
 									else
-										VkFFTInitShader(14, &pipelineShaderStageCreateInfo.module);
+										res = VkFFTInitShader(14, &pipelineShaderStageCreateInfo.module);
 									break;
 								case 3:
 									if (configuration.symmetricKernel)
-										VkFFTInitShader(17, &pipelineShaderStageCreateInfo.module);
+										res = VkFFTInitShader(17, &pipelineShaderStageCreateInfo.module);
 									else
-										VkFFTInitShader(20, &pipelineShaderStageCreateInfo.module);
+										res = VkFFTInitShader(20, &pipelineShaderStageCreateInfo.module);
 									break;
 								}
 							
@@ -871,12 +1435,12 @@ namespace VkFFT
 						else {
 							if (configuration.performTranspose[0]) {
 								if (inverse)
-									VkFFTInitShader(6, &pipelineShaderStageCreateInfo.module);
+									res = VkFFTInitShader(6, &pipelineShaderStageCreateInfo.module);
 								else
-									VkFFTInitShader(5, &pipelineShaderStageCreateInfo.module);
+									res = VkFFTInitShader(5, &pipelineShaderStageCreateInfo.module);
 							}
 							else {
-								VkFFTInitShader(7, &pipelineShaderStageCreateInfo.module);
+								res = VkFFTInitShader(7, &pipelineShaderStageCreateInfo.module);
 							}
 						}
 
@@ -887,46 +1451,46 @@ namespace VkFFT
 							if (configuration.performTranspose[1]) 
 								switch (configuration.vectorDimension) {
 								case 1:
-									VkFFTInitShader(9, &pipelineShaderStageCreateInfo.module);
+									res = VkFFTInitShader(9, &pipelineShaderStageCreateInfo.module);
 									break;
 								case 2:
 									if (configuration.symmetricKernel)
-										VkFFTInitShader(12, &pipelineShaderStageCreateInfo.module);
+										res = VkFFTInitShader(12, &pipelineShaderStageCreateInfo.module);
 									else
-										VkFFTInitShader(15, &pipelineShaderStageCreateInfo.module);
+										res = VkFFTInitShader(15, &pipelineShaderStageCreateInfo.module);
 									break;
 								case 3:
 									if (configuration.symmetricKernel)
-										VkFFTInitShader(18, &pipelineShaderStageCreateInfo.module);
+										res = VkFFTInitShader(18, &pipelineShaderStageCreateInfo.module);
 									else
-										VkFFTInitShader(21, &pipelineShaderStageCreateInfo.module);
+										res = VkFFTInitShader(21, &pipelineShaderStageCreateInfo.module);
 									break;
 								}
 							else
 								switch (configuration.vectorDimension) {
 								case 1:
-									VkFFTInitShader(8, &pipelineShaderStageCreateInfo.module);
+									res = VkFFTInitShader(8, &pipelineShaderStageCreateInfo.module);
 									break;
 								case 2:
 									if (configuration.symmetricKernel)
-										VkFFTInitShader(11, &pipelineShaderStageCreateInfo.module);
+										res = VkFFTInitShader(11, &pipelineShaderStageCreateInfo.module);
 									else
-										VkFFTInitShader(14, &pipelineShaderStageCreateInfo.module);
+										res = VkFFTInitShader(14, &pipelineShaderStageCreateInfo.module);
 									break;
 								case 3:
 									if (configuration.symmetricKernel)
-										VkFFTInitShader(17, &pipelineShaderStageCreateInfo.module);
+										res = VkFFTInitShader(17, &pipelineShaderStageCreateInfo.module);
 									else
-										VkFFTInitShader(20, &pipelineShaderStageCreateInfo.module);
+										res = VkFFTInitShader(20, &pipelineShaderStageCreateInfo.module);
 									break;
 								}
 							
 						}
 						else {
 							if (configuration.performTranspose[1])
-								VkFFTInitShader(0, &pipelineShaderStageCreateInfo.module);
+								res = VkFFTInitShader(0, &pipelineShaderStageCreateInfo.module);
 							else
-								VkFFTInitShader(7, &pipelineShaderStageCreateInfo.module);
+								res = VkFFTInitShader(7, &pipelineShaderStageCreateInfo.module);
 						}
 					}
 				}
@@ -934,9 +1498,9 @@ namespace VkFFT
 					if (axis_id == 0) {
 						
 						if (configuration.performZeropadding)
-							VkFFTInitShader(11, &pipelineShaderStageCreateInfo.module);//not here
+							res = VkFFTInitShader(11, &pipelineShaderStageCreateInfo.module);//not here
 						else
-							VkFFTInitShader(0, &pipelineShaderStageCreateInfo.module);
+							res = VkFFTInitShader((inverse) ? 0 : VkFFTFirstPassShader(0), &pipelineShaderStageCreateInfo.module);
 					}
 					if (axis_id == 1) {
 
@@ -944,46 +1508,46 @@ namespace VkFFT
 							if (configuration.performTranspose[0])
 								switch (configuration.vectorDimension) {
 								case 1:
-									VkFFTInitShader(10, &pipelineShaderStageCreateInfo.module);
+									res = VkFFTInitShader(10, &pipelineShaderStageCreateInfo.module);
 									break;
 								case 2:
 									if (configuration.symmetricKernel)
-										VkFFTInitShader(13, &pipelineShaderStageCreateInfo.module);
+										res = VkFFTInitShader(13, &pipelineShaderStageCreateInfo.module);
 									else
-										VkFFTInitShader(16, &pipelineShaderStageCreateInfo.module);
+										res = VkFFTInitShader(16, &pipelineShaderStageCreateInfo.module);
 									break;
 								case 3:
 									if (configuration.symmetricKernel)
-										VkFFTInitShader(19, &pipelineShaderStageCreateInfo.module);
+										res = VkFFTInitShader(19, &pipelineShaderStageCreateInfo.module);
 									else
-										VkFFTInitShader(22, &pipelineShaderStageCreateInfo.module);
+										res = VkFFTInitShader(22, &pipelineShaderStageCreateInfo.module);
 									break;
 								}
 							else
 								switch (configuration.vectorDimension) {
 								case 1:
-									VkFFTInitShader(8, &pipelineShaderStageCreateInfo.module);
+									res = VkFFTInitShader(8, &pipelineShaderStageCreateInfo.module);
 									break;
 								case 2:
 									if (configuration.symmetricKernel)
-										VkFFTInitShader(11, &pipelineShaderStageCreateInfo.module);
+										res = VkFFTInitShader(11, &pipelineShaderStageCreateInfo.module);
 									else
-										VkFFTInitShader(14, &pipelineShaderStageCreateInfo.module);
+										res = VkFFTInitShader(14, &pipelineShaderStageCreateInfo.module);
 									break;
 								case 3:
 									if (configuration.symmetricKernel)
-										VkFFTInitShader(17, &pipelineShaderStageCreateInfo.module);
+										res = VkFFTInitShader(17, &pipelineShaderStageCreateInfo.module);
 									else
-										VkFFTInitShader(20, &pipelineShaderStageCreateInfo.module);
+										res = VkFFTInitShader(20, &pipelineShaderStageCreateInfo.module);
 									break;
 								}
 						}
 						else {
 							if (configuration.performTranspose[0]) {
-								VkFFTInitShader(0, &pipelineShaderStageCreateInfo.module);
+								res = VkFFTInitShader(0, &pipelineShaderStageCreateInfo.module);
 							}
 							else {
-								VkFFTInitShader(7, &pipelineShaderStageCreateInfo.module);
+								res = VkFFTInitShader(7, &pipelineShaderStageCreateInfo.module);
 							}
 						}
 
@@ -994,49 +1558,49 @@ namespace VkFFT
 							if (configuration.performTranspose[1])
 								switch (configuration.vectorDimension) {
 								case 1:
-									VkFFTInitShader(9, &pipelineShaderStageCreateInfo.module);
+									res = VkFFTInitShader(9, &pipelineShaderStageCreateInfo.module);
 									break;
 								case 2:
 									if (configuration.symmetricKernel)
-										VkFFTInitShader(12, &pipelineShaderStageCreateInfo.module);
+										res = VkFFTInitShader(12, &pipelineShaderStageCreateInfo.module);
 									else
-										VkFFTInitShader(15, &pipelineShaderStageCreateInfo.module);
+										res = VkFFTInitShader(15, &pipelineShaderStageCreateInfo.module);
 									break;
 								case 3:
 									if (configuration.symmetricKernel)
-										VkFFTInitShader(18, &pipelineShaderStageCreateInfo.module);
+										res = VkFFTInitShader(18, &pipelineShaderStageCreateInfo.module);
 									else
-										VkFFTInitShader(21, &pipelineShaderStageCreateInfo.module);
+										res = VkFFTInitShader(21, &pipelineShaderStageCreateInfo.module);
 									break;
 								}
 							else
 								switch (configuration.vectorDimension) {
 								case 1:
-									VkFFTInitShader(8, &pipelineShaderStageCreateInfo.module);
+									res = VkFFTInitShader(8, &pipelineShaderStageCreateInfo.module);
 									break;
 								case 2:
 									if (configuration.symmetricKernel)
-										VkFFTInitShader(11, &pipelineShaderStageCreateInfo.module);
+										res = VkFFTInitShader(11, &pipelineShaderStageCreateInfo.module);
 									else
-										VkFFTInitShader(14, &pipelineShaderStageCreateInfo.module);
+										res = VkFFTInitShader(14, &pipelineShaderStageCreateInfo.module);
 									break;
 								case 3:
 									if (configuration.symmetricKernel)
-										VkFFTInitShader(17, &pipelineShaderStageCreateInfo.module);
+										res = VkFFTInitShader(17, &pipelineShaderStageCreateInfo.module);
 									else
-										VkFFTInitShader(20, &pipelineShaderStageCreateInfo.module);
+										res = VkFFTInitShader(20, &pipelineShaderStageCreateInfo.module);
 									break;
 								}
 						}
 						else {
 							if (configuration.performTranspose[1])
-								VkFFTInitShader(0, &pipelineShaderStageCreateInfo.module);
+								res = VkFFTInitShader(0, &pipelineShaderStageCreateInfo.module);
 							else
-								VkFFTInitShader(7, &pipelineShaderStageCreateInfo.module);
+								res = VkFFTInitShader(7, &pipelineShaderStageCreateInfo.module);
 						}
 					}
 				}
-				
+				if (res != VK_SUCCESS) return res;
 				pipelineShaderStageCreateInfo.pName = "main";
 				pipelineShaderStageCreateInfo.pSpecializationInfo = &specializationInfo;
 				computePipelineCreateInfo.stage = pipelineShaderStageCreateInfo;
@@ -1044,13 +1608,16 @@ namespace VkFFT
 
 				
 
-				vkCreateComputePipelines(configuration.device[0], VK_NULL_HANDLE, 1, &computePipelineCreateInfo, NULL, &axis->pipeline);
+				res = vkCreateComputePipelines(configuration.device[0], VK_NULL_HANDLE, 1, &computePipelineCreateInfo, NULL, &axis->pipeline);
+				vkDestroyShaderModule(configuration.device[0], pipelineShaderStageCreateInfo.module, NULL);
+				if (res != VK_SUCCESS) return res;
 
 			}
 
-			
+			return res;
 		}
-		void VkFFTPlanSupportAxis(VkFFTPlan* FFTPlan, uint32_t axis_id, bool inverse) {
+		VkResult VkFFTPlanSupportAxis(VkFFTPlan* FFTPlan, uint32_t axis_id, bool inverse) {
+			VkResult res = VK_SUCCESS;
 			//get radix stages
 			VkFFTAxis* axis = &FFTPlan->supportAxes[axis_id-1];
 			//for (uint32_t i; i<3; i++)
@@ -1147,11 +1714,8 @@ namespace VkFFT
 			axis->pushConstants.outputOffset = configuration.size[0] * configuration.size[1] / 2;
 
 			VkDescriptorPoolSize descriptorPoolSize = { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER };
-			descriptorPoolSize.descriptorCount = 2;
-			if ((axis_id == 1) && (configuration.FFTdim == 2) && (configuration.performConvolution))
-				descriptorPoolSize.descriptorCount = 3;
-			if ((axis_id == 2) && (configuration.FFTdim == 3) && (configuration.performConvolution))
-				descriptorPoolSize.descriptorCount = 3;
+			//binding 2 is the kernel in convolution shaders and the spectrum output in FFT shaders
+			descriptorPoolSize.descriptorCount = 3;
 
 			VkDescriptorPoolCreateInfo descriptorPoolCreateInfo = { VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO };
 			descriptorPoolCreateInfo.poolSizeCount = 1;
@@ -1195,9 +1759,7 @@ namespace VkFFT
 					descriptorBufferInfo.range = configuration.bufferSize[0];
 				}
 				if (i == 2) {
-					descriptorBufferInfo.buffer = configuration.kernel[0];
-					descriptorBufferInfo.offset = 0;
-					descriptorBufferInfo.range = configuration.kernelSize[0];
+					VkFFTBindingTwo(&descriptorBufferInfo);
 				}
 				VkWriteDescriptorSet writeDescriptorSet = { VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET };
 				writeDescriptorSet.dstSet = axis->descriptorSet;
@@ -1233,86 +1795,89 @@ namespace VkFFT
 					FFTPlan->supportAxes[1].axisBlock[2] = 1;
 					FFTPlan->supportAxes[1].axisBlock[3] = configuration.size[2];
 				}
-				VkSpecializationMapEntry specializationMapEntries[4] = { {} };
-				specializationMapEntries[0].constantID = 1;
-				specializationMapEntries[0].size = sizeof(uint32_t);
-				specializationMapEntries[0].offset = 0;
-				specializationMapEntries[1].constantID = 2;
-				specializationMapEntries[1].size = sizeof(uint32_t);
-				specializationMapEntries[1].offset = sizeof(uint32_t);
-				specializationMapEntries[2].constantID = 3;
-				specializationMapEntries[2].size = sizeof(uint32_t);
-				specializationMapEntries[2].offset = 2 * sizeof(uint32_t);
-				specializationMapEntries[3].constantID = 4;
-				specializationMapEntries[3].size = sizeof(uint32_t);
-				specializationMapEntries[3].offset = 3 * sizeof(uint32_t);
+				res = VkFFTCheckAxisLimits(axis, axis_id);
+				if (res != VK_SUCCESS) return res;
+				//axisBlock with fft_dim, kernel conjugation used by convolution shaders, user callbacks, r2c input windows, spectrum output and fftshift
+				uint32_t specializationData[20] = { FFTPlan->supportAxes[axis_id-1].axisBlock[0], FFTPlan->supportAxes[axis_id-1].axisBlock[1], FFTPlan->supportAxes[axis_id-1].axisBlock[2], FFTPlan->supportAxes[axis_id-1].axisBlock[3], configuration.performCorrelation, VkFFTLoadCallback(axis_id, inverse), VkFFTStoreCallback(axis_id, inverse) };
+				VkFFTWindowConstants(axis_id, inverse, &specializationData[7]);
+				VkFFTSpectrumConstants(axis_id, inverse, &specializationData[13]);
+				VkFFTShiftConstants(axis_id, &specializationData[17]);
+				VkSpecializationMapEntry specializationMapEntries[20] = { {} };
+				for (uint32_t i = 0; i < 20; i++) {
+					specializationMapEntries[i].constantID = i + 1;
+					specializationMapEntries[i].size = sizeof(uint32_t);
+					specializationMapEntries[i].offset = i * sizeof(uint32_t);
+				}
 
 				VkSpecializationInfo specializationInfo={};
-				specializationInfo.dataSize = 4 * sizeof(uint32_t);
-				specializationInfo.mapEntryCount = 4;
+				specializationInfo.dataSize = 20 * sizeof(uint32_t);
+				specializationInfo.mapEntryCount = 20;
 				specializationInfo.pMapEntries = specializationMapEntries;
-				specializationInfo.pData = &FFTPlan->supportAxes[axis_id-1].axisBlock;
+				specializationInfo.pData = specializationData;
 				VkPipelineShaderStageCreateInfo pipelineShaderStageCreateInfo = { VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO };
 				VkComputePipelineCreateInfo computePipelineCreateInfo = { VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO };
 
 
 				pipelineShaderStageCreateInfo.stage = VK_SHADER_STAGE_COMPUTE_BIT;
-				
-					
-				if (axis_id == 1) {
+				uint32_t matrixSpecializationData[16];
+				VkSpecializationMapEntry matrixSpecializationMapEntries[16];
+				if ((matrixConvolution) && (axis_id == configuration.FFTdim - 1)) {
+					res = VkFFTInitMatrixConvolutionShader(&FFTPlan->supportAxes[axis_id - 1], (axis_id == 2), false, true, &specializationInfo, matrixSpecializationData, matrixSpecializationMapEntries, &pipelineShaderStageCreateInfo.module);
+				}
+				else if (axis_id == 1) {
 
 					if ((configuration.FFTdim == 2) && (configuration.performConvolution)) {
 						switch (configuration.vectorDimension) {
 						case 1:
-							VkFFTInitShader(9, &pipelineShaderStageCreateInfo.module);
+							res = VkFFTInitShader(9, &pipelineShaderStageCreateInfo.module);
 							break;
 						case 2:
 							if (configuration.symmetricKernel)
-								VkFFTInitShader(12, &pipelineShaderStageCreateInfo.module);
+								res = VkFFTInitShader(12, &pipelineShaderStageCreateInfo.module);
 							else
-								VkFFTInitShader(15, &pipelineShaderStageCreateInfo.module);
+								res = VkFFTInitShader(15, &pipelineShaderStageCreateInfo.module);
 							break;
 						case 3:
 							if (configuration.symmetricKernel)
-								VkFFTInitShader(18, &pipelineShaderStageCreateInfo.module);
+								res = VkFFTInitShader(18, &pipelineShaderStageCreateInfo.module);
 							else
-								VkFFTInitShader(21, &pipelineShaderStageCreateInfo.module);
+								res = VkFFTInitShader(21, &pipelineShaderStageCreateInfo.module);
 							break;
 						}
 
 					}
 					else {
 							
-						VkFFTInitShader(0, &pipelineShaderStageCreateInfo.module);
+						res = VkFFTInitShader(0, &pipelineShaderStageCreateInfo.module);
 					}
 
 				}
 
-				if (axis_id == 2) {
+				else if (axis_id == 2) {
 					if ((configuration.FFTdim == 3) && (configuration.performConvolution)) {
 						switch (configuration.vectorDimension) {
 						case 1:
-							VkFFTInitShader(8, &pipelineShaderStageCreateInfo.module);
+							res = VkFFTInitShader(8, &pipelineShaderStageCreateInfo.module);
 							break;
 						case 2:
 							if (configuration.symmetricKernel)
-								VkFFTInitShader(11, &pipelineShaderStageCreateInfo.module);
+								res = VkFFTInitShader(11, &pipelineShaderStageCreateInfo.module);
 							else
-								VkFFTInitShader(14, &pipelineShaderStageCreateInfo.module);
+								res = VkFFTInitShader(14, &pipelineShaderStageCreateInfo.module);
 							break;
 						case 3:
 							if (configuration.symmetricKernel)
-								VkFFTInitShader(17, &pipelineShaderStageCreateInfo.module);
+								res = VkFFTInitShader(17, &pipelineShaderStageCreateInfo.module);
 							else
-								VkFFTInitShader(20, &pipelineShaderStageCreateInfo.module);
+								res = VkFFTInitShader(20, &pipelineShaderStageCreateInfo.module);
 							break;
 						}
 					}
 					else {
-						VkFFTInitShader(7, &pipelineShaderStageCreateInfo.module);
+						res = VkFFTInitShader(7, &pipelineShaderStageCreateInfo.module);
 					}
 				}
-				
+				if (res != VK_SUCCESS) return res;
 				pipelineShaderStageCreateInfo.pName = "main";
 				pipelineShaderStageCreateInfo.pSpecializationInfo = &specializationInfo;
 				computePipelineCreateInfo.stage = pipelineShaderStageCreateInfo;
@@ -1320,13 +1885,15 @@ namespace VkFFT
 
 
 
-				vkCreateComputePipelines(configuration.device[0], VK_NULL_HANDLE, 1, &computePipelineCreateInfo, NULL, &axis->pipeline);
+				res = vkCreateComputePipelines(configuration.device[0], VK_NULL_HANDLE, 1, &computePipelineCreateInfo, NULL, &axis->pipeline);
+				vkDestroyShaderModule(configuration.device[0], pipelineShaderStageCreateInfo.module, NULL);
+				if (res != VK_SUCCESS) return res;
 
 			}
 
-
+			return res;
 		}
-		void VkFFTPlanTranspose(VkFFTPlan* FFTPlan, uint32_t axis_id) {
+		VkResult VkFFTPlanTranspose(VkFFTPlan* FFTPlan, uint32_t axis_id) {
 			if (axis_id == 0) {
 				if (configuration.performR2C) {
 					FFTPlan->transpose[0].pushConstants.ratio = (configuration.size[0] / configuration.size[1] / 2 >= 1) ? configuration.size[0] / configuration.size[1] / 2 : 2 * configuration.size[1] / configuration.size[0];
@@ -1430,18 +1997,9 @@ namespace VkFFT
 			
 
 		
-			uint32_t filelength;
 			//printf("vkFFT_transpose_inplace\n");
-			char filename[256];
-			sprintf(filename, "%s%s", configuration.shaderPath, "vkFFT_transpose_inplace.spv");
-	
-			uint32_t* code = VkFFTReadShader(filelength, filename);
-			VkShaderModuleCreateInfo createInfo = { VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO };
-			createInfo.pCode = code;
-			createInfo.codeSize = filelength;
-			vkCreateShaderModule(configuration.device[0], &createInfo, NULL, &FFTPlan->transpose[axis_id].shaderModule);
-			delete[] code;
-				
+			VkResult res = VkFFTCreateShaderModule(configuration.device[0], configuration.shaderPath, "vkFFT_transpose_inplace.spv", &FFTPlan->transpose[axis_id].shaderModule);
+			if (res != VK_SUCCESS) return res;
 			VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo = { VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO };
 			pipelineLayoutCreateInfo.setLayoutCount = 1;
 			pipelineLayoutCreateInfo.pSetLayouts = &FFTPlan->transpose[axis_id].descriptorSetLayout;
@@ -1466,14 +2024,20 @@ namespace VkFFT
 			specializationMapEntries[2].size = sizeof(uint32_t);
 			specializationMapEntries[2].offset = 2 * sizeof(uint32_t);
 
+			//transpose tile holds 2*x*(y+1) floats in shared memory, one invocation per tile element
+			uint32_t transposeInvocations = (maxComputeWorkGroupInvocations < maxSharedComplexNumbers / 2) ? maxComputeWorkGroupInvocations : maxSharedComplexNumbers / 2;
 			uint32_t max_dim = 1;
-			if (FFTPlan->axes[axis_id ].axisBlock[1] * configuration.size[axis_id] < pow(2, floor(log2(sqrt(1024 * FFTPlan->transpose[axis_id].pushConstants.ratio)))))
+			if (FFTPlan->axes[axis_id ].axisBlock[1] * configuration.size[axis_id] < pow(2, floor(log2(sqrt(transposeInvocations * FFTPlan->transpose[axis_id].pushConstants.ratio)))))
 				max_dim = FFTPlan->axes[axis_id].axisBlock[1] * configuration.size[axis_id ];
 			else
-				max_dim=pow(2, floor(log2(sqrt(1024 * FFTPlan->transpose[axis_id].pushConstants.ratio))));
+				max_dim=pow(2, floor(log2(sqrt(transposeInvocations * FFTPlan->transpose[axis_id].pushConstants.ratio))));
 			FFTPlan->transpose[axis_id].transposeBlock[0] = max_dim;
 			FFTPlan->transpose[axis_id].transposeBlock[1] = max_dim / FFTPlan->transpose[axis_id].pushConstants.ratio;
 			FFTPlan->transpose[axis_id].transposeBlock[2] = 1;
+			if ((useWisdom) && (wisdomEntry.transposeBlock[axis_id][0] != 0)) {
+				FFTPlan->transpose[axis_id].transposeBlock[0] = wisdomEntry.transposeBlock[axis_id][0];
+				FFTPlan->transpose[axis_id].transposeBlock[1] = wisdomEntry.transposeBlock[axis_id][1];
+			}
 			VkSpecializationInfo specializationInfo={};
 			specializationInfo.dataSize = 3 * sizeof(uint32_t);
 			specializationInfo.mapEntryCount = 3;
@@ -1488,44 +2052,318 @@ namespace VkFFT
 			computePipelineCreateInfo.layout = FFTPlan->transpose[axis_id].pipelineLayout;
 
 
-			vkCreateComputePipelines(configuration.device[0], VK_NULL_HANDLE, 1, &computePipelineCreateInfo, NULL, &FFTPlan->transpose[axis_id].pipeline);
-			
+			return vkCreateComputePipelines(configuration.device[0], VK_NULL_HANDLE, 1, &computePipelineCreateInfo, NULL, &FFTPlan->transpose[axis_id].pipeline);
+		}
+		bool VkFFTCheckFused2D() {
+			if ((!configuration.performFused2D) || (configuration.FFTdim != 2) || (configuration.performR2C) || (configuration.performConvolution) || (configuration.inputBuffer) || (VkFFTOmitsAxes()))
+				return false;
+			//radix stages of the fused kernel cover powers of 2, one workgroup keeps the whole system in shared memory
+			if ((configuration.size[0] & (configuration.size[0] - 1)) || (configuration.size[1] & (configuration.size[1] - 1)))
+				return false;
+			return (configuration.size[0] <= 64) && (configuration.size[1] <= 64) && (configuration.size[0] * configuration.size[1] <= maxSharedComplexNumbers);
+		}
+		VkResult VkFFTPlanFused2D(VkFFTPlan* FFTPlan, bool inverse) {
+			VkFFTAxis* axis = &FFTPlan->fusedAxis;
+			uint32_t systemSize = configuration.size[0] * configuration.size[1];
+			axis->pushConstants.inverse = inverse;
+			axis->pushConstants.inputStride[0] = 1;
+			axis->pushConstants.inputStride[1] = configuration.size[0];
+			axis->pushConstants.inputStride[2] = systemSize;
+			axis->pushConstants.inputStride[3] = systemSize * configuration.size[2];
+			for (uint32_t i = 0; i < 4; i++)
+				axis->pushConstants.outputStride[i] = axis->pushConstants.inputStride[i];
+			axis->pushConstants.inputOffset = 0;
+			axis->pushConstants.outputOffset = 0;
+			//each invocation processes 8 complex numbers, the system index is the workgroup z index
+			axis->axisBlock[0] = (systemSize / 8 > 1) ? systemSize / 8 : 1;
+			axis->axisBlock[1] = 1;
+			axis->axisBlock[2] = 1;
+			axis->axisBlock[3] = configuration.size[0];
+			VkResult res = VkFFTCheckAxisLimits(axis, 0);
+			if (res != VK_SUCCESS) return res;
 
+			VkDescriptorPoolSize descriptorPoolSize = { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER };
+			descriptorPoolSize.descriptorCount = 3;
+			VkDescriptorPoolCreateInfo descriptorPoolCreateInfo = { VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO };
+			descriptorPoolCreateInfo.poolSizeCount = 1;
+			descriptorPoolCreateInfo.pPoolSizes = &descriptorPoolSize;
+			descriptorPoolCreateInfo.maxSets = 1;
+			vkCreateDescriptorPool(configuration.device[0], &descriptorPoolCreateInfo, NULL, &axis->descriptorPool);
+
+			//input, output and spectrum output
+			VkDescriptorSetLayoutBinding descriptorSetLayoutBindings[3] = {};
+			for (uint32_t i = 0; i < 3; ++i) {
+				descriptorSetLayoutBindings[i].binding = i;
+				descriptorSetLayoutBindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+				descriptorSetLayoutBindings[i].descriptorCount = 1;
+				descriptorSetLayoutBindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+			}
+			VkDescriptorSetLayoutCreateInfo descriptorSetLayoutCreateInfo = { VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO };
+			descriptorSetLayoutCreateInfo.bindingCount = 3;
+			descriptorSetLayoutCreateInfo.pBindings = descriptorSetLayoutBindings;
+			vkCreateDescriptorSetLayout(configuration.device[0], &descriptorSetLayoutCreateInfo, NULL, &axis->descriptorSetLayout);
+
+			VkDescriptorSetAllocateInfo descriptorSetAllocateInfo = { VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO };
+			descriptorSetAllocateInfo.descriptorPool = axis->descriptorPool;
+			descriptorSetAllocateInfo.descriptorSetCount = 1;
+			descriptorSetAllocateInfo.pSetLayouts = &axis->descriptorSetLayout;
+			vkAllocateDescriptorSets(configuration.device[0], &descriptorSetAllocateInfo, &axis->descriptorSet);
+			for (uint32_t i = 0; i < 3; ++i) {
+				VkDescriptorBufferInfo descriptorBufferInfo = {};
+				descriptorBufferInfo.buffer = configuration.buffer[0];
+				descriptorBufferInfo.offset = 0;
+				descriptorBufferInfo.range = configuration.bufferSize[0];
+				if (i == 2)
+					VkFFTBindingTwo(&descriptorBufferInfo);
+				VkWriteDescriptorSet writeDescriptorSet = { VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET };
+				writeDescriptorSet.dstSet = axis->descriptorSet;
+				writeDescriptorSet.dstBinding = i;
+				writeDescriptorSet.dstArrayElement = 0;
+				writeDescriptorSet.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+				writeDescriptorSet.descriptorCount = 1;
+				writeDescriptorSet.pBufferInfo = &descriptorBufferInfo;
+				vkUpdateDescriptorSets(configuration.device[0], 1, &writeDescriptorSet, 0, NULL);
+			}
+
+			VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo = { VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO };
+			pipelineLayoutCreateInfo.setLayoutCount = 1;
+			pipelineLayoutCreateInfo.pSetLayouts = &axis->descriptorSetLayout;
+			VkPushConstantRange pushConstantRange = { VK_SHADER_STAGE_COMPUTE_BIT };
+			pushConstantRange.offset = 0;
+			pushConstantRange.size = sizeof(axis->pushConstants);
+			pipelineLayoutCreateInfo.pushConstantRangeCount = 1;
+			pipelineLayoutCreateInfo.pPushConstantRanges = &pushConstantRange;
+			vkCreatePipelineLayout(configuration.device[0], &pipelineLayoutCreateInfo, NULL, &axis->pipelineLayout);
+
+			//workgroup size, size of axis 0, size of axis 1, user callbacks, spectrum output and fftshift - the only pass reads the input and writes the output
+			uint32_t specializationData[20] = { axis->axisBlock[0], axis->axisBlock[1], axis->axisBlock[2], configuration.size[0], configuration.size[1], configuration.loadCallback, configuration.storeCallback };
+			VkFFTSpectrumConstants(1, inverse, &specializationData[13]);
+			VkFFTShiftConstants(0, &specializationData[17]);
+			VkSpecializationMapEntry specializationMapEntries[20] = { {} };
+			for (uint32_t i = 0; i < 20; i++) {
+				specializationMapEntries[i].constantID = i + 1;
+				specializationMapEntries[i].size = sizeof(uint32_t);
+				specializationMapEntries[i].offset = i * sizeof(uint32_t);
+			}
+			VkSpecializationInfo specializationInfo = {};
+			specializationInfo.dataSize = 20 * sizeof(uint32_t);
+			specializationInfo.mapEntryCount = 20;
+			specializationInfo.pMapEntries = specializationMapEntries;
+			specializationInfo.pData = specializationData;
+
+			VkPipelineShaderStageCreateInfo pipelineShaderStageCreateInfo = { VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO };
+			VkComputePipelineCreateInfo computePipelineCreateInfo = { VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO };
+			pipelineShaderStageCreateInfo.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+			res = VkFFTInitShader(23, &pipelineShaderStageCreateInfo.module);
+			if (res != VK_SUCCESS) return res;
+			pipelineShaderStageCreateInfo.pName = "main";
+			pipelineShaderStageCreateInfo.pSpecializationInfo = &specializationInfo;
+			computePipelineCreateInfo.stage = pipelineShaderStageCreateInfo;
+			computePipelineCreateInfo.layout = axis->pipelineLayout;
+			res = vkCreateComputePipelines(configuration.device[0], VK_NULL_HANDLE, 1, &computePipelineCreateInfo, NULL, &axis->pipeline);
+			vkDestroyShaderModule(configuration.device[0], pipelineShaderStageCreateInfo.module, NULL);
+			return res;
 		}
 		
 	public:
-		void initializeVulkanFFT(VkFFTConfiguration inputLaunchConfiguration) {
+		//returns VK_SUCCESS or the error that stopped plan creation, everything created before it is released
+		VkResult initializeVulkanFFT(VkFFTConfiguration inputLaunchConfiguration) {
 			configuration = inputLaunchConfiguration;
-			
-			if (configuration.performConvolution) {
+
+			if ((VkFFTOmitsAxes()) && ((configuration.performR2C) || (configuration.performConvolution))) {
+				printf("VkFFT omitDimension is supported by C2C transforms without convolution\n");
+				return VK_ERROR_INITIALIZATION_FAILED;
+			}
+			if ((configuration.performConvolution) && (configuration.FFTdim == 1)) {
+				printf("VkFFT convolution is embedded in the last axis of 2D and 3D systems, 1D convolutions are done by VkFFTOverlapConvolution of vkFFT_overlap.h\n");
+				return VK_ERROR_INITIALIZATION_FAILED;
+			}
+			if (configuration.performConvolution)
 				configuration.inverse = false;
+			matrixConvolution = (configuration.performConvolution) && ((configuration.analyticKernel) || (configuration.filterBankSize > 0) || (configuration.inputChannels > 0) || (configuration.outputChannels > 0) || (configuration.vectorDimension > 3));
+			if (matrixConvolution) {
+				if (configuration.inputChannels == 0)
+					configuration.inputChannels = configuration.vectorDimension;
+				if (configuration.filterBankSize > 0)
+					configuration.outputChannels = configuration.inputChannels * configuration.filterBankSize;
+				if (configuration.outputChannels == 0)
+					configuration.outputChannels = configuration.inputChannels;
+				//forward transforms run over the input systems, inverse ones over the output systems that follow them
+				configuration.vectorDimension = configuration.inputChannels;
+				convolutionOutputs[0] = configuration.inputChannels;
+				convolutionOutputs[1] = configuration.outputChannels;
+			}
+			else {
+				convolutionOutputs[0] = 0;
+				convolutionOutputs[1] = configuration.vectorDimension;
+			}
+			if (configuration.spectrumOutput > 2) {
+				printf("VkFFT spectrumOutput %u is not one of 0 - off, 1 - power, 2 - log-magnitude\n", configuration.spectrumOutput);
+				return VK_ERROR_INITIALIZATION_FAILED;
+			}
+			if ((configuration.spectrumOutput > 0) && ((configuration.spectrumBuffer == 0) || (configuration.performConvolution))) {
+				printf("VkFFT spectrum output needs configuration.spectrumBuffer and is not done by convolutions\n");
+				return VK_ERROR_INITIALIZATION_FAILED;
+			}
+			if (configuration.performConvolution)
+				configuration.spectrumBuffer = 0;
+			if ((configuration.spectrumOutput == 2) && (configuration.accumulateSpectrum)) {
+				printf("VkFFT accumulates power, log-magnitude can't be accumulated\n");
+				return VK_ERROR_INITIALIZATION_FAILED;
+			}
+			//rows of one dispatch write the same bins concurrently, so untransformed batch axes can not be summed without a reduction pass
+			if ((configuration.spectrumOutput > 0) && (configuration.accumulateSpectrum) && (((configuration.FFTdim < 2) && (configuration.size[1] > 1)) || ((configuration.FFTdim < 3) && (configuration.size[2] > 1)))) {
+				printf("VkFFT accumulateSpectrum sums systems of vectorDimension and consecutive calls, batched systems along untransformed axes are not summed\n");
+				return VK_ERROR_INITIALIZATION_FAILED;
+			}
+			if (((configuration.fftShift[0]) || (configuration.fftShift[1]) || (configuration.fftShift[2])) && (configuration.performConvolution)) {
+				printf("VkFFT fftShift is not done by convolutions\n");
+				return VK_ERROR_INITIALIZATION_FAILED;
+			}
+			if ((configuration.inputBuffer) && (configuration.inverse)) {
+				printf("VkFFT inputBuffer is read by forward transforms, inverse ones are done in buffer\n");
+				return VK_ERROR_INITIALIZATION_FAILED;
+			}
+			if ((configuration.inputType > 0) && (configuration.inputBuffer == 0)) {
+				printf("VkFFT integer input is read from configuration.inputBuffer of a forward transform\n");
+				return VK_ERROR_INITIALIZATION_FAILED;
+			}
+			if ((configuration.stftHop > 0) && ((configuration.inputBuffer == 0) || (!configuration.performR2C) || (configuration.FFTdim != 1) || (configuration.size[2] != 1) || (configuration.performConvolution))) {
+				printf("VkFFT short-time Fourier transform is a forward 1D R2C of size[1] frames read from configuration.inputBuffer\n");
+				return VK_ERROR_INITIALIZATION_FAILED;
+			}
+			if (((configuration.windowType[0] > 0) || (configuration.windowType[1] > 0) || (configuration.windowType[2] > 0)) && (!configuration.performR2C)) {
+				printf("VkFFT windows are applied by the R2C load, C2C systems can't be windowed\n");
+				return VK_ERROR_INITIALIZATION_FAILED;
+			}
+			VkFFTGetDeviceLimits();
+			VkResult res = VkFFTCheckInputType();
+			if (res != VK_SUCCESS) return res;
+			VkFFTCheckTimestamps();
+			if (configuration.performProfiling) {
+				VkQueryPoolCreateInfo queryPoolCreateInfo = { VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO };
+				queryPoolCreateInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+				queryPoolCreateInfo.queryCount = 2 * maxProfilingStages;
+				res = vkCreateQueryPool(configuration.device[0], &queryPoolCreateInfo, NULL, &queryPool);
+				if (res != VK_SUCCESS) return res;
+			}
+			VkFFTFindWisdom();
+			//wisdom can only turn the fused kernel off, plans it does not cover fall back to the per-axis path
+			fused2D = (useWisdom) ? (wisdomEntry.fused2D) && (VkFFTCheckFused2D()) : VkFFTCheckFused2D();
+			if (fused2D) {
+				res = VkFFTPlanFused2D(&localFFTPlan, configuration.inverse);
+				if (res != VK_SUCCESS) {
+					deleteVulkanFFT();
+					return res;
+				}
+				VkFFTStoreWisdom();
+				return res;
+			}
+			if (configuration.performConvolution) {
+				VkFFTPlanParameters(&localFFTPlan_inverse_convolution);
 				for (uint32_t i = 0; i < configuration.FFTdim; i++) {
-					VkFFTPlanAxis(&localFFTPlan_inverse_convolution, i, true);
+					res = VkFFTPlanAxis(&localFFTPlan_inverse_convolution, i, true);
+					if (res != VK_SUCCESS) {
+						deleteVulkanFFT();
+						return res;
+					}
 				}
 			}
+			VkFFTPlanParameters(&localFFTPlan);
 			for (uint32_t i = 0; i < configuration.FFTdim; i++) {
-				VkFFTPlanAxis(&localFFTPlan, i, configuration.inverse);
+				if (configuration.omitDimension[i]) continue;
+				res = VkFFTPlanAxis(&localFFTPlan, i, configuration.inverse);
+				if (res != VK_SUCCESS) {
+					deleteVulkanFFT();
+					return res;
+				}
 			}
-			
+			res = VkFFTCheckGridLimits(&localFFTPlan);
+			if (res != VK_SUCCESS) {
+				deleteVulkanFFT();
+				return res;
+			}
+			VkFFTStoreWisdom();
+			return res;
+		}
+		bool VkFFTGetProfilingResults(std::vector<VkFFTProfilingStage>* stages) {
+			//results of the last executed VkFFTAppend, waits for the command buffer it was recorded to
+			if ((!configuration.performProfiling) || (profilingStages.size() == 0)) {
+				printf("VkFFT profiling is disabled or no stages were recorded\n");
+				return false;
+			}
+			std::vector<uint64_t> timestamps(2 * profilingStages.size());
+			VkResult res = vkGetQueryPoolResults(configuration.device[0], queryPool, 0, 2 * profilingStages.size(), timestamps.size() * sizeof(uint64_t), timestamps.data(), sizeof(uint64_t), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
+			if (res != VK_SUCCESS) return false;
+			stages[0] = profilingStages;
+			for (uint32_t i = 0; i < stages->size(); i++) {
+				stages[0][i].time = (double)((timestamps[2 * i + 1] - timestamps[2 * i]) & timestampMask) * timestampPeriod;
+				stages[0][i].bandwidth = (stages[0][i].time > 0) ? stages[0][i].bytes / stages[0][i].time : 0;
+			}
+			return true;
+		}
+		void deleteVulkanFFT() {
+			VkFFTPlan* FFTPlans[2] = { &localFFTPlan, &localFFTPlan_inverse_convolution };
+			for (uint32_t p = 0; p < 2; p++) {
+				for (uint32_t i = 0; i < 6; i++) {
+					VkFFTAxis* axis = (i < 3) ? &FFTPlans[p]->axes[i] : (i < 5) ? &FFTPlans[p]->supportAxes[i - 3] : &FFTPlans[p]->fusedAxis;
+					if (axis->pipeline != VK_NULL_HANDLE) vkDestroyPipeline(configuration.device[0], axis->pipeline, NULL);
+					if (axis->pipelineLayout != VK_NULL_HANDLE) vkDestroyPipelineLayout(configuration.device[0], axis->pipelineLayout, NULL);
+					if (axis->descriptorSetLayout != VK_NULL_HANDLE) vkDestroyDescriptorSetLayout(configuration.device[0], axis->descriptorSetLayout, NULL);
+					if (axis->descriptorPool != VK_NULL_HANDLE) vkDestroyDescriptorPool(configuration.device[0], axis->descriptorPool, NULL);
+				}
+				for (uint32_t i = 0; i < 2; i++) {
+					VkFFTTranspose* transpose = &FFTPlans[p]->transpose[i];
+					if (transpose->pipeline != VK_NULL_HANDLE) vkDestroyPipeline(configuration.device[0], transpose->pipeline, NULL);
+					if (transpose->pipelineLayout != VK_NULL_HANDLE) vkDestroyPipelineLayout(configuration.device[0], transpose->pipelineLayout, NULL);
+					if (transpose->descriptorSetLayout != VK_NULL_HANDLE) vkDestroyDescriptorSetLayout(configuration.device[0], transpose->descriptorSetLayout, NULL);
+					if (transpose->descriptorPool != VK_NULL_HANDLE) vkDestroyDescriptorPool(configuration.device[0], transpose->descriptorPool, NULL);
+					if (transpose->shaderModule != VK_NULL_HANDLE) vkDestroyShaderModule(configuration.device[0], transpose->shaderModule, NULL);
+				}
+				FFTPlans[p][0] = {};
+			}
+			if (queryPool != VK_NULL_HANDLE) vkDestroyQueryPool(configuration.device[0], queryPool, NULL);
+			queryPool = VK_NULL_HANDLE;
+			profilingStages.clear();
 		}
 		void VkFFTAppend(VkCommandBuffer commandBuffer) {
+			if (configuration.performProfiling) {
+				profilingStages.clear();
+				vkCmdResetQueryPool(commandBuffer, queryPool, 0, 2 * maxProfilingStages);
+			}
 			VkMemoryBarrier memory_barrier = {
 					VK_STRUCTURE_TYPE_MEMORY_BARRIER,
 					nullptr,
 					VK_ACCESS_SHADER_WRITE_BIT,
 					VK_ACCESS_SHADER_READ_BIT,
 			};
+			if (fused2D) {
+				//both axes of every system of the batch in one dispatch, x and y counts are 1 and z is split by VkFFTDispatchAxis beyond maxComputeWorkGroupCount[2]
+				VkFFTAxis* axis = &localFFTPlan.fusedAxis;
+				vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, axis->pipeline);
+				vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, axis->pipelineLayout, 0, 1, &axis->descriptorSet, 0, NULL);
+				for (uint32_t i = 0; i < configuration.vectorDimension; i++) {
+					axis->pushConstants.coordinate = i;
+					vkCmdPushConstants(commandBuffer, axis->pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(VkFFTPushConstantsLayout), &axis->pushConstants);
+					VkFFTDispatch(commandBuffer, axis, 1, 1, configuration.size[2]);
+					//accumulated spectra of the systems are summed in the same bins
+					if (configuration.accumulateSpectrum)
+						vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
+				}
+				vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
+				return;
+			}
 			if (!configuration.inverse) {
 				//FFT axis 0
-				for (uint32_t i = 0; i < configuration.vectorDimension; i++) {
+				for (uint32_t i = 0; (i < configuration.vectorDimension) && (!configuration.omitDimension[0]); i++) {
 					localFFTPlan.axes[0].pushConstants.coordinate = i;
 					vkCmdPushConstants(commandBuffer, localFFTPlan.axes[0].pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(VkFFTPushConstantsLayout), &localFFTPlan.axes[0].pushConstants);
 					vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan.axes[0].pipeline);
 					vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan.axes[0].pipelineLayout, 0, 1, &localFFTPlan.axes[0].descriptorSet, 0, NULL);
 					if (configuration.performR2C == true)
-						vkCmdDispatch(commandBuffer, 1, configuration.size[1] / 2/ localFFTPlan.axes[0].axisBlock[1], configuration.size[2] / localFFTPlan.axes[0].axisBlock[2]);
+						VkFFTDispatch(commandBuffer, &localFFTPlan.axes[0], 1, configuration.size[1] / 2/ localFFTPlan.axes[0].axisBlock[1], configuration.size[2] / localFFTPlan.axes[0].axisBlock[2]);
 					else
-						vkCmdDispatch(commandBuffer, 1, configuration.size[1] / localFFTPlan.axes[0].axisBlock[1], configuration.size[2] / localFFTPlan.axes[0].axisBlock[2]);
+						VkFFTDispatch(commandBuffer, &localFFTPlan.axes[0], 1, configuration.size[1] / localFFTPlan.axes[0].axisBlock[1], configuration.size[2] / localFFTPlan.axes[0].axisBlock[2]);
 					vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
 
 				}
@@ -1539,16 +2377,16 @@ namespace VkFFT
 							vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan.transpose[0].pipelineLayout, 0, 1, &localFFTPlan.transpose[0].descriptorSet, 0, NULL);
 							if (configuration.performR2C == true) {
 								if (localFFTPlan.transpose[0].pushConstants.ratioDirection)
-									vkCmdDispatch(commandBuffer, configuration.size[0] / 2 / localFFTPlan.transpose[0].transposeBlock[0], configuration.size[1] / localFFTPlan.transpose[0].transposeBlock[1], configuration.size[2] / localFFTPlan.transpose[0].transposeBlock[2]);
+									VkFFTDispatch(commandBuffer, &localFFTPlan.transpose[0], configuration.size[0] / 2 / localFFTPlan.transpose[0].transposeBlock[0], configuration.size[1] / localFFTPlan.transpose[0].transposeBlock[1], configuration.size[2] / localFFTPlan.transpose[0].transposeBlock[2]);
 								else
-									vkCmdDispatch(commandBuffer, configuration.size[1] / localFFTPlan.transpose[0].transposeBlock[0], configuration.size[0]/2 / localFFTPlan.transpose[0].transposeBlock[1], configuration.size[2] / localFFTPlan.transpose[0].transposeBlock[2]);
+									VkFFTDispatch(commandBuffer, &localFFTPlan.transpose[0], configuration.size[1] / localFFTPlan.transpose[0].transposeBlock[0], configuration.size[0]/2 / localFFTPlan.transpose[0].transposeBlock[1], configuration.size[2] / localFFTPlan.transpose[0].transposeBlock[2]);
 
 							}
 							else {
 								if (localFFTPlan.transpose[0].pushConstants.ratioDirection)
-									vkCmdDispatch(commandBuffer, configuration.size[0] / localFFTPlan.transpose[0].transposeBlock[0], configuration.size[1] / localFFTPlan.transpose[0].transposeBlock[1], configuration.size[2] / localFFTPlan.transpose[0].transposeBlock[2]);
+									VkFFTDispatch(commandBuffer, &localFFTPlan.transpose[0], configuration.size[0] / localFFTPlan.transpose[0].transposeBlock[0], configuration.size[1] / localFFTPlan.transpose[0].transposeBlock[1], configuration.size[2] / localFFTPlan.transpose[0].transposeBlock[2]);
 								else
-									vkCmdDispatch(commandBuffer, configuration.size[1] / localFFTPlan.transpose[0].transposeBlock[0], configuration.size[0] / localFFTPlan.transpose[0].transposeBlock[1], configuration.size[2] / localFFTPlan.transpose[0].transposeBlock[2]);
+									VkFFTDispatch(commandBuffer, &localFFTPlan.transpose[0], configuration.size[1] / localFFTPlan.transpose[0].transposeBlock[0], configuration.size[0] / localFFTPlan.transpose[0].transposeBlock[1], configuration.size[2] / localFFTPlan.transpose[0].transposeBlock[2]);
 
 							}
 							vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
@@ -1563,9 +2401,9 @@ namespace VkFFT
 							vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan.axes[1].pipeline);
 							vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan.axes[1].pipelineLayout, 0, 1, &localFFTPlan.axes[1].descriptorSet, 0, NULL);
 							if (configuration.performR2C == true)
-								vkCmdDispatch(commandBuffer, 1, configuration.size[0] / 2 / localFFTPlan.axes[1].axisBlock[1] + 1, configuration.size[2] / localFFTPlan.axes[1].axisBlock[2]);
+								VkFFTDispatch(commandBuffer, &localFFTPlan.axes[1], 1, configuration.size[0] / 2 / localFFTPlan.axes[1].axisBlock[1] + 1, configuration.size[2] / localFFTPlan.axes[1].axisBlock[2]);
 							else
-								vkCmdDispatch(commandBuffer, 1, configuration.size[0] / localFFTPlan.axes[1].axisBlock[1], configuration.size[2] / localFFTPlan.axes[1].axisBlock[2]);
+								VkFFTDispatch(commandBuffer, &localFFTPlan.axes[1], 1, configuration.size[0] / localFFTPlan.axes[1].axisBlock[1], configuration.size[2] / localFFTPlan.axes[1].axisBlock[2]);
 							vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
 
 						}
@@ -1575,7 +2413,7 @@ namespace VkFFT
 								vkCmdPushConstants(commandBuffer, localFFTPlan.supportAxes[0].pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(VkFFTPushConstantsLayout), &localFFTPlan.supportAxes[0].pushConstants);
 								vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan.supportAxes[0].pipeline);
 								vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan.supportAxes[0].pipelineLayout, 0, 1, &localFFTPlan.supportAxes[0].descriptorSet, 0, NULL);
-								vkCmdDispatch(commandBuffer, 1, 1, configuration.size[2]);
+								VkFFTDispatch(commandBuffer, &localFFTPlan.supportAxes[0], 1, 1, configuration.size[2]);
 								vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
 							}
 							localFFTPlan.axes[1].pushConstants.coordinate = 0;
@@ -1583,24 +2421,24 @@ namespace VkFFT
 							vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan.axes[1].pipeline);
 							vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan.axes[1].pipelineLayout, 0, 1, &localFFTPlan.axes[1].descriptorSet, 0, NULL);
 							if (configuration.performR2C == true)
-								vkCmdDispatch(commandBuffer, configuration.size[0] / 2 / localFFTPlan.axes[1].axisBlock[0], 1, configuration.size[2] / localFFTPlan.axes[1].axisBlock[2]);
+								VkFFTDispatch(commandBuffer, &localFFTPlan.axes[1], configuration.size[0] / 2 / localFFTPlan.axes[1].axisBlock[0], 1, configuration.size[2] / localFFTPlan.axes[1].axisBlock[2]);
 							else
-								vkCmdDispatch(commandBuffer, configuration.size[0] / localFFTPlan.axes[1].axisBlock[0], 1, configuration.size[2] / localFFTPlan.axes[1].axisBlock[2]);
+								VkFFTDispatch(commandBuffer, &localFFTPlan.axes[1], configuration.size[0] / localFFTPlan.axes[1].axisBlock[0], 1, configuration.size[2] / localFFTPlan.axes[1].axisBlock[2]);
 							vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
 
 						}
 					}
 					else {
 						if (configuration.performTranspose[0]) {
-							for (uint32_t i = 0; i < configuration.vectorDimension; i++) {
+							for (uint32_t i = 0; (i < configuration.vectorDimension) && (!configuration.omitDimension[1]); i++) {
 								localFFTPlan.axes[1].pushConstants.coordinate = i;
 								vkCmdPushConstants(commandBuffer, localFFTPlan.axes[1].pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(VkFFTPushConstantsLayout), &localFFTPlan.axes[1].pushConstants);
 								vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan.axes[1].pipeline);
 								vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan.axes[1].pipelineLayout, 0, 1, &localFFTPlan.axes[1].descriptorSet, 0, NULL);
 								if (configuration.performR2C == true)
-									vkCmdDispatch(commandBuffer, 1, configuration.size[0] / 2 / localFFTPlan.axes[1].axisBlock[1] + 1, configuration.size[2] / localFFTPlan.axes[1].axisBlock[2]);
+									VkFFTDispatch(commandBuffer, &localFFTPlan.axes[1], 1, configuration.size[0] / 2 / localFFTPlan.axes[1].axisBlock[1] + 1, configuration.size[2] / localFFTPlan.axes[1].axisBlock[2]);
 								else
-									vkCmdDispatch(commandBuffer, 1, configuration.size[0] / localFFTPlan.axes[1].axisBlock[1], configuration.size[2] / localFFTPlan.axes[1].axisBlock[2]);
+									VkFFTDispatch(commandBuffer, &localFFTPlan.axes[1], 1, configuration.size[0] / localFFTPlan.axes[1].axisBlock[1], configuration.size[2] / localFFTPlan.axes[1].axisBlock[2]);
 								vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
 
 							}
@@ -1614,19 +2452,19 @@ namespace VkFFT
 									vkCmdPushConstants(commandBuffer, localFFTPlan.supportAxes[0].pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(VkFFTPushConstantsLayout), &localFFTPlan.supportAxes[0].pushConstants);
 									vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan.supportAxes[0].pipeline);
 									vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan.supportAxes[0].pipelineLayout, 0, 1, &localFFTPlan.supportAxes[0].descriptorSet, 0, NULL);
-									vkCmdDispatch(commandBuffer, 1, 1, configuration.size[2]);
+									VkFFTDispatch(commandBuffer, &localFFTPlan.supportAxes[0], 1, 1, configuration.size[2]);
 									vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
 								}
 							}
-							for (uint32_t i = 0; i < configuration.vectorDimension; i++) {
+							for (uint32_t i = 0; (i < configuration.vectorDimension) && (!configuration.omitDimension[1]); i++) {
 								localFFTPlan.axes[1].pushConstants.coordinate = i;
 								vkCmdPushConstants(commandBuffer, localFFTPlan.axes[1].pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(VkFFTPushConstantsLayout), &localFFTPlan.axes[1].pushConstants);
 								vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan.axes[1].pipeline);
 								vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan.axes[1].pipelineLayout, 0, 1, &localFFTPlan.axes[1].descriptorSet, 0, NULL);
 								if (configuration.performR2C == true)
-									vkCmdDispatch(commandBuffer, configuration.size[0] / 2 / localFFTPlan.axes[1].axisBlock[0], 1, configuration.size[2] / localFFTPlan.axes[1].axisBlock[2]);
+									VkFFTDispatch(commandBuffer, &localFFTPlan.axes[1], configuration.size[0] / 2 / localFFTPlan.axes[1].axisBlock[0], 1, configuration.size[2] / localFFTPlan.axes[1].axisBlock[2]);
 								else
-									vkCmdDispatch(commandBuffer, configuration.size[0] / localFFTPlan.axes[1].axisBlock[0], 1, configuration.size[2] / localFFTPlan.axes[1].axisBlock[2]);
+									VkFFTDispatch(commandBuffer, &localFFTPlan.axes[1], configuration.size[0] / localFFTPlan.axes[1].axisBlock[0], 1, configuration.size[2] / localFFTPlan.axes[1].axisBlock[2]);
 								vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
 							}
 						}
@@ -1643,16 +2481,16 @@ namespace VkFFT
 							vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan.transpose[1].pipelineLayout, 0, 1, &localFFTPlan.transpose[1].descriptorSet, 0, NULL);
 							if (configuration.performR2C == true) {
 								if (localFFTPlan.transpose[1].pushConstants.ratioDirection)
-									vkCmdDispatch(commandBuffer, configuration.size[1] / localFFTPlan.transpose[1].transposeBlock[0], configuration.size[2] / localFFTPlan.transpose[1].transposeBlock[1], (configuration.size[0] / 2 + 1) / localFFTPlan.transpose[1].transposeBlock[2]);
+									VkFFTDispatch(commandBuffer, &localFFTPlan.transpose[1], configuration.size[1] / localFFTPlan.transpose[1].transposeBlock[0], configuration.size[2] / localFFTPlan.transpose[1].transposeBlock[1], (configuration.size[0] / 2 + 1) / localFFTPlan.transpose[1].transposeBlock[2]);
 								else
-									vkCmdDispatch(commandBuffer, configuration.size[2] / localFFTPlan.transpose[1].transposeBlock[0], configuration.size[1] / localFFTPlan.transpose[1].transposeBlock[1], (configuration.size[0] / 2 + 1) / localFFTPlan.transpose[1].transposeBlock[2]);
+									VkFFTDispatch(commandBuffer, &localFFTPlan.transpose[1], configuration.size[2] / localFFTPlan.transpose[1].transposeBlock[0], configuration.size[1] / localFFTPlan.transpose[1].transposeBlock[1], (configuration.size[0] / 2 + 1) / localFFTPlan.transpose[1].transposeBlock[2]);
 
 							}
 							else {
 								if (localFFTPlan.transpose[1].pushConstants.ratioDirection)
-									vkCmdDispatch(commandBuffer, configuration.size[1] / localFFTPlan.transpose[1].transposeBlock[0], configuration.size[2] / localFFTPlan.transpose[1].transposeBlock[1], configuration.size[0] / localFFTPlan.transpose[1].transposeBlock[2]);
+									VkFFTDispatch(commandBuffer, &localFFTPlan.transpose[1], configuration.size[1] / localFFTPlan.transpose[1].transposeBlock[0], configuration.size[2] / localFFTPlan.transpose[1].transposeBlock[1], configuration.size[0] / localFFTPlan.transpose[1].transposeBlock[2]);
 								else
-									vkCmdDispatch(commandBuffer, configuration.size[2] / localFFTPlan.transpose[1].transposeBlock[0], configuration.size[1] / localFFTPlan.transpose[1].transposeBlock[1], configuration.size[0] / localFFTPlan.transpose[1].transposeBlock[2]);
+									VkFFTDispatch(commandBuffer, &localFFTPlan.transpose[1], configuration.size[2] / localFFTPlan.transpose[1].transposeBlock[0], configuration.size[1] / localFFTPlan.transpose[1].transposeBlock[1], configuration.size[0] / localFFTPlan.transpose[1].transposeBlock[2]);
 
 							}
 							vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
@@ -1667,9 +2505,9 @@ namespace VkFFT
 							vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan.axes[2].pipeline);
 							vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan.axes[2].pipelineLayout, 0, 1, &localFFTPlan.axes[2].descriptorSet, 0, NULL);
 							if (configuration.performR2C == true)
-								vkCmdDispatch(commandBuffer, 1, configuration.size[1] / localFFTPlan.axes[2].axisBlock[2], configuration.size[0] / 2 + 1);
+								VkFFTDispatch(commandBuffer, &localFFTPlan.axes[2], 1, configuration.size[1] / localFFTPlan.axes[2].axisBlock[2], configuration.size[0] / 2 + 1);
 							else
-								vkCmdDispatch(commandBuffer, 1, configuration.size[1] / localFFTPlan.axes[2].axisBlock[2], configuration.size[0]);
+								VkFFTDispatch(commandBuffer, &localFFTPlan.axes[2], 1, configuration.size[1] / localFFTPlan.axes[2].axisBlock[2], configuration.size[0]);
 							vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
 
 						}
@@ -1678,12 +2516,12 @@ namespace VkFFT
 								//transposed 0-1, didn't transpose 1-2
 								localFFTPlan.axes[2].pushConstants.coordinate = 0;
 								vkCmdPushConstants(commandBuffer, localFFTPlan.axes[2].pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(VkFFTPushConstantsLayout), &localFFTPlan.axes[2].pushConstants);
-								vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan.axes[1].pipeline);
+								vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan.axes[2].pipeline);
 								vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan.axes[2].pipelineLayout, 0, 1, &localFFTPlan.axes[2].descriptorSet, 0, NULL);
 								if (configuration.performR2C == true)
-									vkCmdDispatch(commandBuffer, configuration.size[1] / localFFTPlan.axes[2].axisBlock[0], 1, configuration.size[0] / 2 + 1);
+									VkFFTDispatch(commandBuffer, &localFFTPlan.axes[2], configuration.size[1] / localFFTPlan.axes[2].axisBlock[0], 1, configuration.size[0] / 2 + 1);
 								else
-									vkCmdDispatch(commandBuffer, configuration.size[0] / localFFTPlan.axes[2].axisBlock[0], 1, configuration.size[0]);
+									VkFFTDispatch(commandBuffer, &localFFTPlan.axes[2], configuration.size[1] / localFFTPlan.axes[2].axisBlock[0], 1, configuration.size[0]);
 								vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
 							}
 							else {
@@ -1693,7 +2531,7 @@ namespace VkFFT
 									vkCmdPushConstants(commandBuffer, localFFTPlan.supportAxes[1].pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(VkFFTPushConstantsLayout), &localFFTPlan.supportAxes[1].pushConstants);
 									vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan.supportAxes[1].pipeline);
 									vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan.supportAxes[1].pipelineLayout, 0, 1, &localFFTPlan.supportAxes[1].descriptorSet, 0, NULL);
-									vkCmdDispatch(commandBuffer, configuration.size[1] / localFFTPlan.supportAxes[1].axisBlock[0], 1, 1);
+									VkFFTDispatch(commandBuffer, &localFFTPlan.supportAxes[1], configuration.size[1] / localFFTPlan.supportAxes[1].axisBlock[0], 1, 1);
 									vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
 								}
 
@@ -1702,9 +2540,9 @@ namespace VkFFT
 								vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan.axes[2].pipeline);
 								vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan.axes[2].pipelineLayout, 0, 1, &localFFTPlan.axes[2].descriptorSet, 0, NULL);
 								if (configuration.performR2C == true)
-									vkCmdDispatch(commandBuffer, configuration.size[0] / 2 / localFFTPlan.axes[2].axisBlock[0], 1, configuration.size[1]);
+									VkFFTDispatch(commandBuffer, &localFFTPlan.axes[2], configuration.size[0] / 2 / localFFTPlan.axes[2].axisBlock[0], 1, configuration.size[1]);
 								else
-									vkCmdDispatch(commandBuffer, configuration.size[0] / localFFTPlan.axes[2].axisBlock[0], 1, configuration.size[1]);
+									VkFFTDispatch(commandBuffer, &localFFTPlan.axes[2], configuration.size[0] / localFFTPlan.axes[2].axisBlock[0], 1, configuration.size[1]);
 								vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
 							}
 						}
@@ -1712,30 +2550,30 @@ namespace VkFFT
 					else {
 						//transposed 1-2, transposed 0-1
 						if (configuration.performTranspose[1]) {
-							for (uint32_t i = 0; i < configuration.vectorDimension; i++) {
+							for (uint32_t i = 0; (i < configuration.vectorDimension) && (!configuration.omitDimension[2]); i++) {
 								localFFTPlan.axes[2].pushConstants.coordinate = i;
 								vkCmdPushConstants(commandBuffer, localFFTPlan.axes[2].pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(VkFFTPushConstantsLayout), &localFFTPlan.axes[2].pushConstants);
 								vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan.axes[2].pipeline);
 								vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan.axes[2].pipelineLayout, 0, 1, &localFFTPlan.axes[2].descriptorSet, 0, NULL);
 								if (configuration.performR2C == true)
-									vkCmdDispatch(commandBuffer, 1, configuration.size[1] / localFFTPlan.axes[2].axisBlock[2], configuration.size[0] / 2 + 1);
+									VkFFTDispatch(commandBuffer, &localFFTPlan.axes[2], 1, configuration.size[1] / localFFTPlan.axes[2].axisBlock[2], configuration.size[0] / 2 + 1);
 								else
-									vkCmdDispatch(commandBuffer, 1, configuration.size[1] / localFFTPlan.axes[2].axisBlock[2], configuration.size[0]);
+									VkFFTDispatch(commandBuffer, &localFFTPlan.axes[2], 1, configuration.size[1] / localFFTPlan.axes[2].axisBlock[2], configuration.size[0]);
 								vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
 							}
 						}
 						else {
 							if (configuration.performTranspose[0]) {
 								//transposed 0-1, didn't transpose 1-2
-								for (uint32_t i = 0; i < configuration.vectorDimension; i++) {
+								for (uint32_t i = 0; (i < configuration.vectorDimension) && (!configuration.omitDimension[2]); i++) {
 									localFFTPlan.axes[2].pushConstants.coordinate = i;
 									vkCmdPushConstants(commandBuffer, localFFTPlan.axes[2].pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(VkFFTPushConstantsLayout), &localFFTPlan.axes[2].pushConstants);
 									vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan.axes[2].pipeline);
 									vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan.axes[2].pipelineLayout, 0, 1, &localFFTPlan.axes[2].descriptorSet, 0, NULL);
 									if (configuration.performR2C == true)
-										vkCmdDispatch(commandBuffer, configuration.size[1] / localFFTPlan.axes[2].axisBlock[0], 1, configuration.size[0] / 2 + 1);
+										VkFFTDispatch(commandBuffer, &localFFTPlan.axes[2], configuration.size[1] / localFFTPlan.axes[2].axisBlock[0], 1, configuration.size[0] / 2 + 1);
 									else
-										vkCmdDispatch(commandBuffer, configuration.size[1] / localFFTPlan.axes[2].axisBlock[0], 1, configuration.size[0]);
+										VkFFTDispatch(commandBuffer, &localFFTPlan.axes[2], configuration.size[1] / localFFTPlan.axes[2].axisBlock[0], 1, configuration.size[0]);
 									vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
 								}
 							}
@@ -1747,19 +2585,19 @@ namespace VkFFT
 										vkCmdPushConstants(commandBuffer, localFFTPlan.supportAxes[1].pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(VkFFTPushConstantsLayout), &localFFTPlan.supportAxes[1].pushConstants);
 										vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan.supportAxes[1].pipeline);
 										vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan.supportAxes[1].pipelineLayout, 0, 1, &localFFTPlan.supportAxes[1].descriptorSet, 0, NULL);
-										vkCmdDispatch(commandBuffer, configuration.size[1] / localFFTPlan.supportAxes[1].axisBlock[0], 1, 1);
+										VkFFTDispatch(commandBuffer, &localFFTPlan.supportAxes[1], configuration.size[1] / localFFTPlan.supportAxes[1].axisBlock[0], 1, 1);
 										vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
 									}
 								}
-								for (uint32_t i = 0; i < configuration.vectorDimension; i++) {
+								for (uint32_t i = 0; (i < configuration.vectorDimension) && (!configuration.omitDimension[2]); i++) {
 									localFFTPlan.axes[2].pushConstants.coordinate = i;
 									vkCmdPushConstants(commandBuffer, localFFTPlan.axes[2].pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(VkFFTPushConstantsLayout), &localFFTPlan.axes[2].pushConstants);
 									vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan.axes[2].pipeline);
 									vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan.axes[2].pipelineLayout, 0, 1, &localFFTPlan.axes[2].descriptorSet, 0, NULL);
 									if (configuration.performR2C == true)
-										vkCmdDispatch(commandBuffer, configuration.size[0] / 2 / localFFTPlan.axes[2].axisBlock[0], 1, configuration.size[1]);
+										VkFFTDispatch(commandBuffer, &localFFTPlan.axes[2], configuration.size[0] / 2 / localFFTPlan.axes[2].axisBlock[0], 1, configuration.size[1]);
 									else
-										vkCmdDispatch(commandBuffer, configuration.size[0] / localFFTPlan.axes[2].axisBlock[0], 1, configuration.size[1]);
+										VkFFTDispatch(commandBuffer, &localFFTPlan.axes[2], configuration.size[0] / localFFTPlan.axes[2].axisBlock[0], 1, configuration.size[1]);
 									vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
 								}
 							}
@@ -1772,23 +2610,23 @@ namespace VkFFT
 				if (configuration.FFTdim > 2) {
 					//transpose 1-2, after 0-1
 					if (configuration.performTranspose[1]) {
-						for (uint32_t i = 0; i < configuration.vectorDimension; i++) {
+						for (uint32_t i = convolutionOutputs[0]; i < convolutionOutputs[0] + convolutionOutputs[1]; i++) {
 							localFFTPlan_inverse_convolution.transpose[1].pushConstants.coordinate = i;
 							vkCmdPushConstants(commandBuffer, localFFTPlan_inverse_convolution.transpose[1].pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(VkFFTTransposePushConstantsLayout), &localFFTPlan_inverse_convolution.transpose[1].pushConstants);
 							vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan_inverse_convolution.transpose[1].pipeline);
 							vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan_inverse_convolution.transpose[1].pipelineLayout, 0, 1, &localFFTPlan_inverse_convolution.transpose[1].descriptorSet, 0, NULL);
 							if (configuration.performR2C == true) {
 								if (localFFTPlan_inverse_convolution.transpose[1].pushConstants.ratioDirection)
-									vkCmdDispatch(commandBuffer, configuration.size[1] / localFFTPlan_inverse_convolution.transpose[1].transposeBlock[0], configuration.size[2] / localFFTPlan_inverse_convolution.transpose[1].transposeBlock[1], (configuration.size[0] / 2 + 1) / localFFTPlan_inverse_convolution.transpose[1].transposeBlock[2]);
+									VkFFTDispatch(commandBuffer, &localFFTPlan_inverse_convolution.transpose[1], configuration.size[1] / localFFTPlan_inverse_convolution.transpose[1].transposeBlock[0], configuration.size[2] / localFFTPlan_inverse_convolution.transpose[1].transposeBlock[1], (configuration.size[0] / 2 + 1) / localFFTPlan_inverse_convolution.transpose[1].transposeBlock[2]);
 								else
-									vkCmdDispatch(commandBuffer, configuration.size[2] / localFFTPlan_inverse_convolution.transpose[1].transposeBlock[0], configuration.size[1] / localFFTPlan_inverse_convolution.transpose[1].transposeBlock[1], (configuration.size[0] / 2 + 1) / localFFTPlan_inverse_convolution.transpose[1].transposeBlock[2]);
+									VkFFTDispatch(commandBuffer, &localFFTPlan_inverse_convolution.transpose[1], configuration.size[2] / localFFTPlan_inverse_convolution.transpose[1].transposeBlock[0], configuration.size[1] / localFFTPlan_inverse_convolution.transpose[1].transposeBlock[1], (configuration.size[0] / 2 + 1) / localFFTPlan_inverse_convolution.transpose[1].transposeBlock[2]);
 
 							}
 							else {
 								if (localFFTPlan_inverse_convolution.transpose[1].pushConstants.ratioDirection)
-									vkCmdDispatch(commandBuffer, configuration.size[1] / localFFTPlan_inverse_convolution.transpose[1].transposeBlock[0], configuration.size[2] / localFFTPlan_inverse_convolution.transpose[1].transposeBlock[1], configuration.size[0] / localFFTPlan_inverse_convolution.transpose[1].transposeBlock[2]);
+									VkFFTDispatch(commandBuffer, &localFFTPlan_inverse_convolution.transpose[1], configuration.size[1] / localFFTPlan_inverse_convolution.transpose[1].transposeBlock[0], configuration.size[2] / localFFTPlan_inverse_convolution.transpose[1].transposeBlock[1], configuration.size[0] / localFFTPlan_inverse_convolution.transpose[1].transposeBlock[2]);
 								else
-									vkCmdDispatch(commandBuffer, configuration.size[2] / localFFTPlan_inverse_convolution.transpose[1].transposeBlock[0], configuration.size[1] / localFFTPlan_inverse_convolution.transpose[1].transposeBlock[1], configuration.size[0] / localFFTPlan_inverse_convolution.transpose[1].transposeBlock[2]);
+									VkFFTDispatch(commandBuffer, &localFFTPlan_inverse_convolution.transpose[1], configuration.size[2] / localFFTPlan_inverse_convolution.transpose[1].transposeBlock[0], configuration.size[1] / localFFTPlan_inverse_convolution.transpose[1].transposeBlock[1], configuration.size[0] / localFFTPlan_inverse_convolution.transpose[1].transposeBlock[2]);
 
 							}
 							vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
@@ -1796,15 +2634,15 @@ namespace VkFFT
 					}
 
 					if (configuration.performTranspose[0]) {
-						for (uint32_t i = 0; i < configuration.vectorDimension; i++) {
+						for (uint32_t i = convolutionOutputs[0]; i < convolutionOutputs[0] + convolutionOutputs[1]; i++) {
 							localFFTPlan_inverse_convolution.axes[1].pushConstants.coordinate = i;
 							vkCmdPushConstants(commandBuffer, localFFTPlan_inverse_convolution.axes[1].pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(VkFFTPushConstantsLayout), &localFFTPlan_inverse_convolution.axes[1].pushConstants);
 							vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan_inverse_convolution.axes[1].pipeline);
 							vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan_inverse_convolution.axes[1].pipelineLayout, 0, 1, &localFFTPlan_inverse_convolution.axes[1].descriptorSet, 0, NULL);
 							if (configuration.performR2C == true)
-								vkCmdDispatch(commandBuffer, 1, configuration.size[0] / 2 / localFFTPlan_inverse_convolution.axes[1].axisBlock[1] + 1, configuration.size[2] / localFFTPlan_inverse_convolution.axes[1].axisBlock[2]);
+								VkFFTDispatch(commandBuffer, &localFFTPlan_inverse_convolution.axes[1], 1, configuration.size[0] / 2 / localFFTPlan_inverse_convolution.axes[1].axisBlock[1] + 1, configuration.size[2] / localFFTPlan_inverse_convolution.axes[1].axisBlock[2]);
 							else
-								vkCmdDispatch(commandBuffer, 1, configuration.size[0] / localFFTPlan_inverse_convolution.axes[1].axisBlock[1], configuration.size[2] / localFFTPlan_inverse_convolution.axes[1].axisBlock[2]);
+								VkFFTDispatch(commandBuffer, &localFFTPlan_inverse_convolution.axes[1], 1, configuration.size[0] / localFFTPlan_inverse_convolution.axes[1].axisBlock[1], configuration.size[2] / localFFTPlan_inverse_convolution.axes[1].axisBlock[2]);
 							vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
 
 						}
@@ -1812,25 +2650,25 @@ namespace VkFFT
 					else {
 
 						if (configuration.performR2C == true) {
-							for (uint32_t i = 0; i < configuration.vectorDimension; i++) {
+							for (uint32_t i = convolutionOutputs[0]; i < convolutionOutputs[0] + convolutionOutputs[1]; i++) {
 
 								localFFTPlan_inverse_convolution.supportAxes[0].pushConstants.coordinate = i;
 								vkCmdPushConstants(commandBuffer, localFFTPlan_inverse_convolution.supportAxes[0].pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(VkFFTPushConstantsLayout), &localFFTPlan_inverse_convolution.supportAxes[0].pushConstants);
 								vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan_inverse_convolution.supportAxes[0].pipeline);
 								vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan_inverse_convolution.supportAxes[0].pipelineLayout, 0, 1, &localFFTPlan_inverse_convolution.supportAxes[0].descriptorSet, 0, NULL);
-								vkCmdDispatch(commandBuffer, 1, 1, configuration.size[2]);
+								VkFFTDispatch(commandBuffer, &localFFTPlan_inverse_convolution.supportAxes[0], 1, 1, configuration.size[2]);
 								vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
 							}
 						}
-						for (uint32_t i = 0; i < configuration.vectorDimension; i++) {
+						for (uint32_t i = convolutionOutputs[0]; i < convolutionOutputs[0] + convolutionOutputs[1]; i++) {
 							localFFTPlan_inverse_convolution.axes[1].pushConstants.coordinate = i;
 							vkCmdPushConstants(commandBuffer, localFFTPlan_inverse_convolution.axes[1].pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(VkFFTPushConstantsLayout), &localFFTPlan_inverse_convolution.axes[1].pushConstants);
 							vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan_inverse_convolution.axes[1].pipeline);
 							vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan_inverse_convolution.axes[1].pipelineLayout, 0, 1, &localFFTPlan_inverse_convolution.axes[1].descriptorSet, 0, NULL);
 							if (configuration.performR2C == true)
-								vkCmdDispatch(commandBuffer, configuration.size[0] / 2 / localFFTPlan_inverse_convolution.axes[1].axisBlock[0], 1, configuration.size[2] / localFFTPlan_inverse_convolution.axes[1].axisBlock[2]);
+								VkFFTDispatch(commandBuffer, &localFFTPlan_inverse_convolution.axes[1], configuration.size[0] / 2 / localFFTPlan_inverse_convolution.axes[1].axisBlock[0], 1, configuration.size[2] / localFFTPlan_inverse_convolution.axes[1].axisBlock[2]);
 							else
-								vkCmdDispatch(commandBuffer, configuration.size[0] / localFFTPlan_inverse_convolution.axes[1].axisBlock[0], 1, configuration.size[2] / localFFTPlan_inverse_convolution.axes[1].axisBlock[2]);
+								VkFFTDispatch(commandBuffer, &localFFTPlan_inverse_convolution.axes[1], configuration.size[0] / localFFTPlan_inverse_convolution.axes[1].axisBlock[0], 1, configuration.size[2] / localFFTPlan_inverse_convolution.axes[1].axisBlock[2]);
 							vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
 						}
 					}
@@ -1842,38 +2680,38 @@ namespace VkFFT
 				if (configuration.FFTdim > 1) {
 					// transpose 0 - 1, if needed
 					if (configuration.performTranspose[0]) {
-						for (uint32_t i = 0; i < configuration.vectorDimension; i++) {
+						for (uint32_t i = convolutionOutputs[0]; i < convolutionOutputs[0] + convolutionOutputs[1]; i++) {
 							localFFTPlan_inverse_convolution.transpose[0].pushConstants.coordinate = i;
 							vkCmdPushConstants(commandBuffer, localFFTPlan_inverse_convolution.transpose[0].pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(VkFFTTransposePushConstantsLayout), &localFFTPlan_inverse_convolution.transpose[0].pushConstants);
 							vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan_inverse_convolution.transpose[0].pipeline);
 							vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan_inverse_convolution.transpose[0].pipelineLayout, 0, 1, &localFFTPlan_inverse_convolution.transpose[0].descriptorSet, 0, NULL);
 							if (configuration.performR2C == true) {
 								if (localFFTPlan_inverse_convolution.transpose[0].pushConstants.ratioDirection)
-									vkCmdDispatch(commandBuffer, configuration.size[0] / 2 / localFFTPlan_inverse_convolution.transpose[0].transposeBlock[0], configuration.size[1] / localFFTPlan_inverse_convolution.transpose[0].transposeBlock[1], configuration.size[2] / localFFTPlan_inverse_convolution.transpose[0].transposeBlock[2]);
+									VkFFTDispatch(commandBuffer, &localFFTPlan_inverse_convolution.transpose[0], configuration.size[0] / 2 / localFFTPlan_inverse_convolution.transpose[0].transposeBlock[0], configuration.size[1] / localFFTPlan_inverse_convolution.transpose[0].transposeBlock[1], configuration.size[2] / localFFTPlan_inverse_convolution.transpose[0].transposeBlock[2]);
 								else
-									vkCmdDispatch(commandBuffer, configuration.size[1] / localFFTPlan_inverse_convolution.transpose[0].transposeBlock[0], configuration.size[0] / 2 / localFFTPlan_inverse_convolution.transpose[0].transposeBlock[1], configuration.size[2] / localFFTPlan_inverse_convolution.transpose[0].transposeBlock[2]);
+									VkFFTDispatch(commandBuffer, &localFFTPlan_inverse_convolution.transpose[0], configuration.size[1] / localFFTPlan_inverse_convolution.transpose[0].transposeBlock[0], configuration.size[0] / 2 / localFFTPlan_inverse_convolution.transpose[0].transposeBlock[1], configuration.size[2] / localFFTPlan_inverse_convolution.transpose[0].transposeBlock[2]);
 
 							}
 							else {
 								if (localFFTPlan_inverse_convolution.transpose[0].pushConstants.ratioDirection)
-									vkCmdDispatch(commandBuffer, configuration.size[0] / localFFTPlan_inverse_convolution.transpose[0].transposeBlock[0], configuration.size[1] / localFFTPlan_inverse_convolution.transpose[0].transposeBlock[1], configuration.size[2] / localFFTPlan_inverse_convolution.transpose[0].transposeBlock[2]);
+									VkFFTDispatch(commandBuffer, &localFFTPlan_inverse_convolution.transpose[0], configuration.size[0] / localFFTPlan_inverse_convolution.transpose[0].transposeBlock[0], configuration.size[1] / localFFTPlan_inverse_convolution.transpose[0].transposeBlock[1], configuration.size[2] / localFFTPlan_inverse_convolution.transpose[0].transposeBlock[2]);
 								else
-									vkCmdDispatch(commandBuffer, configuration.size[1] / localFFTPlan_inverse_convolution.transpose[0].transposeBlock[0], configuration.size[0] / localFFTPlan_inverse_convolution.transpose[0].transposeBlock[1], configuration.size[2] / localFFTPlan_inverse_convolution.transpose[0].transposeBlock[2]);
+									VkFFTDispatch(commandBuffer, &localFFTPlan_inverse_convolution.transpose[0], configuration.size[1] / localFFTPlan_inverse_convolution.transpose[0].transposeBlock[0], configuration.size[0] / localFFTPlan_inverse_convolution.transpose[0].transposeBlock[1], configuration.size[2] / localFFTPlan_inverse_convolution.transpose[0].transposeBlock[2]);
 
 							}
 							vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
 						}
 					}
 
-					for (uint32_t i = 0; i < configuration.vectorDimension; i++) {
+					for (uint32_t i = convolutionOutputs[0]; i < convolutionOutputs[0] + convolutionOutputs[1]; i++) {
 						localFFTPlan_inverse_convolution.axes[0].pushConstants.coordinate = i;
 						vkCmdPushConstants(commandBuffer, localFFTPlan_inverse_convolution.axes[0].pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(VkFFTPushConstantsLayout), &localFFTPlan_inverse_convolution.axes[0].pushConstants);
 						vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan_inverse_convolution.axes[0].pipeline);
 						vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan_inverse_convolution.axes[0].pipelineLayout, 0, 1, &localFFTPlan_inverse_convolution.axes[0].descriptorSet, 0, NULL);
 						if (configuration.performR2C == true)
-							vkCmdDispatch(commandBuffer, 1, configuration.size[1] / 2 / localFFTPlan_inverse_convolution.axes[0].axisBlock[1], configuration.size[2] / localFFTPlan_inverse_convolution.axes[0].axisBlock[2]);
+							VkFFTDispatch(commandBuffer, &localFFTPlan_inverse_convolution.axes[0], 1, configuration.size[1] / 2 / localFFTPlan_inverse_convolution.axes[0].axisBlock[1], configuration.size[2] / localFFTPlan_inverse_convolution.axes[0].axisBlock[2]);
 						else
-							vkCmdDispatch(commandBuffer, 1, configuration.size[1] / localFFTPlan_inverse_convolution.axes[0].axisBlock[1], configuration.size[2] / localFFTPlan_inverse_convolution.axes[0].axisBlock[2]);
+							VkFFTDispatch(commandBuffer, &localFFTPlan_inverse_convolution.axes[0], 1, configuration.size[1] / localFFTPlan_inverse_convolution.axes[0].axisBlock[1], configuration.size[2] / localFFTPlan_inverse_convolution.axes[0].axisBlock[2]);
 						vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
 
 					}
@@ -1887,30 +2725,30 @@ namespace VkFFT
 				if (configuration.FFTdim > 2) {
 					//transposed 1-2, transposed 0-1
 					if (configuration.performTranspose[1]) {
-						for (uint32_t i = 0; i < configuration.vectorDimension; i++) {
+						for (uint32_t i = 0; (i < configuration.vectorDimension) && (!configuration.omitDimension[2]); i++) {
 							localFFTPlan.axes[2].pushConstants.coordinate = i;
 							vkCmdPushConstants(commandBuffer, localFFTPlan.axes[2].pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(VkFFTPushConstantsLayout), &localFFTPlan.axes[2].pushConstants);
 							vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan.axes[2].pipeline);
 							vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan.axes[2].pipelineLayout, 0, 1, &localFFTPlan.axes[2].descriptorSet, 0, NULL);
 							if (configuration.performR2C == true)
-								vkCmdDispatch(commandBuffer, 1, configuration.size[1] / localFFTPlan.axes[2].axisBlock[2], configuration.size[0] / 2 + 1);
+								VkFFTDispatch(commandBuffer, &localFFTPlan.axes[2], 1, configuration.size[1] / localFFTPlan.axes[2].axisBlock[2], configuration.size[0] / 2 + 1);
 							else
-								vkCmdDispatch(commandBuffer, 1, configuration.size[1] / localFFTPlan.axes[2].axisBlock[2], configuration.size[0]);
+								VkFFTDispatch(commandBuffer, &localFFTPlan.axes[2], 1, configuration.size[1] / localFFTPlan.axes[2].axisBlock[2], configuration.size[0]);
 							vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
 						}
 					}
 					else {
 						if (configuration.performTranspose[0]) {
 							//transposed 0-1, didn't transpose 1-2
-							for (uint32_t i = 0; i < configuration.vectorDimension; i++) {
+							for (uint32_t i = 0; (i < configuration.vectorDimension) && (!configuration.omitDimension[2]); i++) {
 								localFFTPlan.axes[2].pushConstants.coordinate = i;
 								vkCmdPushConstants(commandBuffer, localFFTPlan.axes[2].pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(VkFFTPushConstantsLayout), &localFFTPlan.axes[2].pushConstants);
 								vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan.axes[2].pipeline);
 								vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan.axes[2].pipelineLayout, 0, 1, &localFFTPlan.axes[2].descriptorSet, 0, NULL);
 								if (configuration.performR2C == true)
-									vkCmdDispatch(commandBuffer, configuration.size[1] / localFFTPlan.axes[2].axisBlock[0], 1, configuration.size[0] / 2 + 1);
+									VkFFTDispatch(commandBuffer, &localFFTPlan.axes[2], configuration.size[1] / localFFTPlan.axes[2].axisBlock[0], 1, configuration.size[0] / 2 + 1);
 								else
-									vkCmdDispatch(commandBuffer, configuration.size[1] / localFFTPlan.axes[2].axisBlock[0], 1, configuration.size[0]);
+									VkFFTDispatch(commandBuffer, &localFFTPlan.axes[2], configuration.size[1] / localFFTPlan.axes[2].axisBlock[0], 1, configuration.size[0]);
 								vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
 							}
 						}
@@ -1922,19 +2760,19 @@ namespace VkFFT
 									vkCmdPushConstants(commandBuffer, localFFTPlan.supportAxes[1].pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(VkFFTPushConstantsLayout), &localFFTPlan.supportAxes[1].pushConstants);
 									vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan.supportAxes[1].pipeline);
 									vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan.supportAxes[1].pipelineLayout, 0, 1, &localFFTPlan.supportAxes[1].descriptorSet, 0, NULL);
-									vkCmdDispatch(commandBuffer, configuration.size[1] / localFFTPlan.supportAxes[1].axisBlock[0], 1, 1);
+									VkFFTDispatch(commandBuffer, &localFFTPlan.supportAxes[1], configuration.size[1] / localFFTPlan.supportAxes[1].axisBlock[0], 1, 1);
 									vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
 								}
 							}
-							for (uint32_t i = 0; i < configuration.vectorDimension; i++) {
+							for (uint32_t i = 0; (i < configuration.vectorDimension) && (!configuration.omitDimension[2]); i++) {
 								localFFTPlan.axes[2].pushConstants.coordinate = i;
 								vkCmdPushConstants(commandBuffer, localFFTPlan.axes[2].pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(VkFFTPushConstantsLayout), &localFFTPlan.axes[2].pushConstants);
 								vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan.axes[2].pipeline);
 								vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan.axes[2].pipelineLayout, 0, 1, &localFFTPlan.axes[2].descriptorSet, 0, NULL);
 								if (configuration.performR2C == true)
-									vkCmdDispatch(commandBuffer, configuration.size[0] / 2 / localFFTPlan.axes[2].axisBlock[0], 1, configuration.size[1]);
+									VkFFTDispatch(commandBuffer, &localFFTPlan.axes[2], configuration.size[0] / 2 / localFFTPlan.axes[2].axisBlock[0], 1, configuration.size[1]);
 								else
-									vkCmdDispatch(commandBuffer, configuration.size[0] / localFFTPlan.axes[2].axisBlock[0], 1, configuration.size[1]);
+									VkFFTDispatch(commandBuffer, &localFFTPlan.axes[2], configuration.size[0] / localFFTPlan.axes[2].axisBlock[0], 1, configuration.size[1]);
 								vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
 							}
 						}
@@ -1948,16 +2786,16 @@ namespace VkFFT
 							vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan.transpose[1].pipelineLayout, 0, 1, &localFFTPlan.transpose[1].descriptorSet, 0, NULL);
 							if (configuration.performR2C == true) {
 								if (localFFTPlan.transpose[1].pushConstants.ratioDirection)
-									vkCmdDispatch(commandBuffer, configuration.size[1] / localFFTPlan.transpose[1].transposeBlock[0], configuration.size[2] / localFFTPlan.transpose[1].transposeBlock[1], (configuration.size[0] / 2 + 1) / localFFTPlan.transpose[1].transposeBlock[2]);
+									VkFFTDispatch(commandBuffer, &localFFTPlan.transpose[1], configuration.size[1] / localFFTPlan.transpose[1].transposeBlock[0], configuration.size[2] / localFFTPlan.transpose[1].transposeBlock[1], (configuration.size[0] / 2 + 1) / localFFTPlan.transpose[1].transposeBlock[2]);
 								else
-									vkCmdDispatch(commandBuffer, configuration.size[2] / localFFTPlan.transpose[1].transposeBlock[0], configuration.size[1] / localFFTPlan.transpose[1].transposeBlock[1], (configuration.size[0] / 2 + 1) / localFFTPlan.transpose[1].transposeBlock[2]);
+									VkFFTDispatch(commandBuffer, &localFFTPlan.transpose[1], configuration.size[2] / localFFTPlan.transpose[1].transposeBlock[0], configuration.size[1] / localFFTPlan.transpose[1].transposeBlock[1], (configuration.size[0] / 2 + 1) / localFFTPlan.transpose[1].transposeBlock[2]);
 
 							}
 							else {
 								if (localFFTPlan.transpose[1].pushConstants.ratioDirection)
-									vkCmdDispatch(commandBuffer, configuration.size[1] / localFFTPlan.transpose[1].transposeBlock[0], configuration.size[2] / localFFTPlan.transpose[1].transposeBlock[1], configuration.size[0] / localFFTPlan.transpose[1].transposeBlock[2]);
+									VkFFTDispatch(commandBuffer, &localFFTPlan.transpose[1], configuration.size[1] / localFFTPlan.transpose[1].transposeBlock[0], configuration.size[2] / localFFTPlan.transpose[1].transposeBlock[1], configuration.size[0] / localFFTPlan.transpose[1].transposeBlock[2]);
 								else
-									vkCmdDispatch(commandBuffer, configuration.size[2] / localFFTPlan.transpose[1].transposeBlock[0], configuration.size[1] / localFFTPlan.transpose[1].transposeBlock[1], configuration.size[0] / localFFTPlan.transpose[1].transposeBlock[2]);
+									VkFFTDispatch(commandBuffer, &localFFTPlan.transpose[1], configuration.size[2] / localFFTPlan.transpose[1].transposeBlock[0], configuration.size[1] / localFFTPlan.transpose[1].transposeBlock[1], configuration.size[0] / localFFTPlan.transpose[1].transposeBlock[2]);
 
 							}
 							vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
@@ -1969,15 +2807,15 @@ namespace VkFFT
 
 					//FFT axis 1
 					if (configuration.performTranspose[0]) {
-						for (uint32_t i = 0; i < configuration.vectorDimension; i++) {
+						for (uint32_t i = 0; (i < configuration.vectorDimension) && (!configuration.omitDimension[1]); i++) {
 							localFFTPlan.axes[1].pushConstants.coordinate = i;
 							vkCmdPushConstants(commandBuffer, localFFTPlan.axes[1].pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(VkFFTPushConstantsLayout), &localFFTPlan.axes[1].pushConstants);
 							vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan.axes[1].pipeline);
 							vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan.axes[1].pipelineLayout, 0, 1, &localFFTPlan.axes[1].descriptorSet, 0, NULL);
 							if (configuration.performR2C == true)
-								vkCmdDispatch(commandBuffer, 1, configuration.size[0] / 2 / localFFTPlan.axes[1].axisBlock[1] + 1, configuration.size[2] / localFFTPlan.axes[1].axisBlock[2]);
+								VkFFTDispatch(commandBuffer, &localFFTPlan.axes[1], 1, configuration.size[0] / 2 / localFFTPlan.axes[1].axisBlock[1] + 1, configuration.size[2] / localFFTPlan.axes[1].axisBlock[2]);
 							else
-								vkCmdDispatch(commandBuffer, 1, configuration.size[0] / localFFTPlan.axes[1].axisBlock[1], configuration.size[2] / localFFTPlan.axes[1].axisBlock[2]);
+								VkFFTDispatch(commandBuffer, &localFFTPlan.axes[1], 1, configuration.size[0] / localFFTPlan.axes[1].axisBlock[1], configuration.size[2] / localFFTPlan.axes[1].axisBlock[2]);
 							vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
 
 						}
@@ -1991,19 +2829,19 @@ namespace VkFFT
 								vkCmdPushConstants(commandBuffer, localFFTPlan.supportAxes[0].pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(VkFFTPushConstantsLayout), &localFFTPlan.supportAxes[0].pushConstants);
 								vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan.supportAxes[0].pipeline);
 								vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan.supportAxes[0].pipelineLayout, 0, 1, &localFFTPlan.supportAxes[0].descriptorSet, 0, NULL);
-								vkCmdDispatch(commandBuffer, 1, 1, configuration.size[2]);
+								VkFFTDispatch(commandBuffer, &localFFTPlan.supportAxes[0], 1, 1, configuration.size[2]);
 								vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
 							}
 						}
-						for (uint32_t i = 0; i < configuration.vectorDimension; i++) {
+						for (uint32_t i = 0; (i < configuration.vectorDimension) && (!configuration.omitDimension[1]); i++) {
 							localFFTPlan.axes[1].pushConstants.coordinate = i;
 							vkCmdPushConstants(commandBuffer, localFFTPlan.axes[1].pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(VkFFTPushConstantsLayout), &localFFTPlan.axes[1].pushConstants);
 							vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan.axes[1].pipeline);
 							vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan.axes[1].pipelineLayout, 0, 1, &localFFTPlan.axes[1].descriptorSet, 0, NULL);
 							if (configuration.performR2C == true)
-								vkCmdDispatch(commandBuffer, configuration.size[0] / 2 / localFFTPlan.axes[1].axisBlock[0], 1, configuration.size[2] / localFFTPlan.axes[1].axisBlock[2]);
+								VkFFTDispatch(commandBuffer, &localFFTPlan.axes[1], configuration.size[0] / 2 / localFFTPlan.axes[1].axisBlock[0], 1, configuration.size[2] / localFFTPlan.axes[1].axisBlock[2]);
 							else
-								vkCmdDispatch(commandBuffer, configuration.size[0] / localFFTPlan.axes[1].axisBlock[0], 1, configuration.size[2] / localFFTPlan.axes[1].axisBlock[2]);
+								VkFFTDispatch(commandBuffer, &localFFTPlan.axes[1], configuration.size[0] / localFFTPlan.axes[1].axisBlock[0], 1, configuration.size[2] / localFFTPlan.axes[1].axisBlock[2]);
 							vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
 						}
 					}
@@ -2017,16 +2855,16 @@ namespace VkFFT
 							vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan.transpose[0].pipelineLayout, 0, 1, &localFFTPlan.transpose[0].descriptorSet, 0, NULL);
 							if (configuration.performR2C == true) {
 								if (localFFTPlan.transpose[0].pushConstants.ratioDirection)
-									vkCmdDispatch(commandBuffer, configuration.size[0] / 2 / localFFTPlan.transpose[0].transposeBlock[0], configuration.size[1] / localFFTPlan.transpose[0].transposeBlock[1], configuration.size[2] / localFFTPlan.transpose[0].transposeBlock[2]);
+									VkFFTDispatch(commandBuffer, &localFFTPlan.transpose[0], configuration.size[0] / 2 / localFFTPlan.transpose[0].transposeBlock[0], configuration.size[1] / localFFTPlan.transpose[0].transposeBlock[1], configuration.size[2] / localFFTPlan.transpose[0].transposeBlock[2]);
 								else
-									vkCmdDispatch(commandBuffer, configuration.size[1] / localFFTPlan.transpose[0].transposeBlock[0], configuration.size[0] / 2 / localFFTPlan.transpose[0].transposeBlock[1], configuration.size[2] / localFFTPlan.transpose[0].transposeBlock[2]);
+									VkFFTDispatch(commandBuffer, &localFFTPlan.transpose[0], configuration.size[1] / localFFTPlan.transpose[0].transposeBlock[0], configuration.size[0] / 2 / localFFTPlan.transpose[0].transposeBlock[1], configuration.size[2] / localFFTPlan.transpose[0].transposeBlock[2]);
 
 							}
 							else {
 								if (localFFTPlan.transpose[0].pushConstants.ratioDirection)
-									vkCmdDispatch(commandBuffer, configuration.size[0] / localFFTPlan.transpose[0].transposeBlock[0], configuration.size[1] / localFFTPlan.transpose[0].transposeBlock[1], configuration.size[2] / localFFTPlan.transpose[0].transposeBlock[2]);
+									VkFFTDispatch(commandBuffer, &localFFTPlan.transpose[0], configuration.size[0] / localFFTPlan.transpose[0].transposeBlock[0], configuration.size[1] / localFFTPlan.transpose[0].transposeBlock[1], configuration.size[2] / localFFTPlan.transpose[0].transposeBlock[2]);
 								else
-									vkCmdDispatch(commandBuffer, configuration.size[1] / localFFTPlan.transpose[0].transposeBlock[0], configuration.size[0] / localFFTPlan.transpose[0].transposeBlock[1], configuration.size[2] / localFFTPlan.transpose[0].transposeBlock[2]);
+									VkFFTDispatch(commandBuffer, &localFFTPlan.transpose[0], configuration.size[1] / localFFTPlan.transpose[0].transposeBlock[0], configuration.size[0] / localFFTPlan.transpose[0].transposeBlock[1], configuration.size[2] / localFFTPlan.transpose[0].transposeBlock[2]);
 
 							}
 							vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
@@ -2035,15 +2873,15 @@ namespace VkFFT
 
 				}
 				//FFT axis 0
-				for (uint32_t i = 0; i < configuration.vectorDimension; i++) {
+				for (uint32_t i = 0; (i < configuration.vectorDimension) && (!configuration.omitDimension[0]); i++) {
 					localFFTPlan.axes[0].pushConstants.coordinate = i;
 					vkCmdPushConstants(commandBuffer, localFFTPlan.axes[0].pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(VkFFTPushConstantsLayout), &localFFTPlan.axes[0].pushConstants);
 					vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan.axes[0].pipeline);
 					vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, localFFTPlan.axes[0].pipelineLayout, 0, 1, &localFFTPlan.axes[0].descriptorSet, 0, NULL);
 					if (configuration.performR2C == true)
-						vkCmdDispatch(commandBuffer, 1, configuration.size[1] / 2 / localFFTPlan.axes[0].axisBlock[1], configuration.size[2] / localFFTPlan.axes[0].axisBlock[2]);
+						VkFFTDispatch(commandBuffer, &localFFTPlan.axes[0], 1, configuration.size[1] / 2 / localFFTPlan.axes[0].axisBlock[1], configuration.size[2] / localFFTPlan.axes[0].axisBlock[2]);
 					else
-						vkCmdDispatch(commandBuffer, 1, configuration.size[1] / localFFTPlan.axes[0].axisBlock[1], configuration.size[2] / localFFTPlan.axes[0].axisBlock[2]);
+						VkFFTDispatch(commandBuffer, &localFFTPlan.axes[0], 1, configuration.size[1] / localFFTPlan.axes[0].axisBlock[1], configuration.size[2] / localFFTPlan.axes[0].axisBlock[2]);
 					vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
 
 				}
@@ -2054,4 +2892,69 @@ namespace VkFFT
 		}
 
 	};
+
+	inline bool VkFFTExportWisdom(VkFFTWisdom* wisdom, const char* filename) {
+		//one line per entry: device UUID, driver version, configuration key, plan parameters
+		FILE* fp = fopen(filename, "w");
+		if (fp == NULL) {
+			printf("Could not open file for writing: %s\n", filename);
+			return false;
+		}
+		fprintf(fp, "VkFFT_wisdom 2 %d\n", (int)wisdom->entries.size());
+		for (uint32_t i = 0; i < wisdom->entries.size(); i++) {
+			VkFFTWisdomEntry* entry = &wisdom->entries[i];
+			for (uint32_t j = 0; j < VK_UUID_SIZE; j++)
+				fprintf(fp, "%02x", entry->deviceUUID[j]);
+			fprintf(fp, " %u %u %u %u %u %u %d %d %d %u %d %d %u %u %u %u %u %u %u %d %d %d %u %u %d %u\n", entry->driverVersion, entry->size[0], entry->size[1], entry->size[2], entry->FFTdim, entry->vectorDimension, entry->performR2C, entry->performConvolution, entry->inverse, entry->radix, entry->performTranspose[0], entry->performTranspose[1], entry->groupedBatch[0], entry->groupedBatch[1], entry->groupedBatch[2], entry->transposeBlock[0][0], entry->transposeBlock[0][1], entry->transposeBlock[1][0], entry->transposeBlock[1][1], entry->fused2D, entry->performZeropadding, entry->symmetricKernel, entry->inputChannels, entry->outputChannels, entry->analyticKernel, entry->filterBankSize);
+		}
+		fclose(fp);
+		return true;
+	}
+
+	inline bool VkFFTImportWisdom(VkFFTWisdom* wisdom, const char* filename) {
+		FILE* fp = fopen(filename, "r");
+		if (fp == NULL) {
+			printf("Could not find or open file: %s\n", filename);
+			return false;
+		}
+		int version = 0;
+		int numEntries = 0;
+		if ((fscanf(fp, "VkFFT_wisdom %d %d", &version, &numEntries) != 2) || (version != 2)) {
+			printf("Unsupported wisdom file: %s\n", filename);
+			fclose(fp);
+			return false;
+		}
+		for (int i = 0; i < numEntries; i++) {
+			VkFFTWisdomEntry entry = {};
+			char uuid[2 * VK_UUID_SIZE + 1];
+			int flags[9] = { 0 };
+			if ((fscanf(fp, "%32s %u %u %u %u %u %u %d %d %d %u %d %d %u %u %u %u %u %u %u", uuid, &entry.driverVersion, &entry.size[0], &entry.size[1], &entry.size[2], &entry.FFTdim, &entry.vectorDimension, &flags[0], &flags[1], &flags[2], &entry.radix, &flags[3], &flags[4], &entry.groupedBatch[0], &entry.groupedBatch[1], &entry.groupedBatch[2], &entry.transposeBlock[0][0], &entry.transposeBlock[0][1], &entry.transposeBlock[1][0], &entry.transposeBlock[1][1]) != 20) || (fscanf(fp, "%d %d %d %u %u %d %u", &flags[5], &flags[6], &flags[7], &entry.inputChannels, &entry.outputChannels, &flags[8], &entry.filterBankSize) != 7)) {
+				printf("Corrupted wisdom file: %s\n", filename);
+				fclose(fp);
+				return false;
+			}
+			for (uint32_t j = 0; j < VK_UUID_SIZE; j++) {
+				unsigned int byte = 0;
+				sscanf(uuid + 2 * j, "%2x", &byte);
+				entry.deviceUUID[j] = (uint8_t)byte;
+			}
+			entry.performR2C = flags[0];
+			entry.performConvolution = flags[1];
+			entry.inverse = flags[2];
+			entry.performTranspose[0] = flags[3];
+			entry.performTranspose[1] = flags[4];
+			entry.fused2D = flags[5];
+			entry.performZeropadding = flags[6];
+			entry.symmetricKernel = flags[7];
+			entry.analyticKernel = flags[8];
+			//edited or damaged entries are dropped, their plans are chosen without wisdom
+			if (!VkFFTCheckWisdomEntry(&entry)) {
+				printf("Invalid entry %d in wisdom file %s is skipped\n", i, filename);
+				continue;
+			}
+			wisdom->entries.push_back(entry);
+		}
+		fclose(fp);
+		return true;
+	}
 }
\ No newline at end of file
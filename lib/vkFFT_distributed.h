@@ -0,0 +1,523 @@
+#pragma once
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include "vkFFT.h"
+#include "vkFFT_staging.h"
+#ifdef VKFFT_USE_MPI
+#include <mpi.h>
+#endif
+
+namespace VkFFT
+{
+	//Communication between the ranks of a distributed FFT. Every rank owns one device and one transport object.
+	class VkFFTTransport {
+	public:
+		virtual ~VkFFTTransport() {}
+		virtual uint32_t getRank() = 0;
+		virtual uint32_t getSize() = 0;
+		//Collective. Ranks with equal color form a new transport, ranks in it are ordered by key. Returned object is owned by the caller.
+		virtual VkFFTTransport* split(uint32_t color, uint32_t key) = 0;
+		//Collective. Sends blockSize bytes at sendBuffer + i * blockSize to rank i and receives blockSize bytes from rank i to recvBuffer + i * blockSize.
+		virtual bool allToAll(const void* sendBuffer, void* recvBuffer, uint64_t blockSize) = 0;
+	};
+
+	//State shared by all ranks of an in-process loopback transport.
+	class VkFFTLoopbackHub {
+	public:
+		uint32_t size;
+		std::mutex mutex;
+		std::condition_variable condition;
+		uint32_t arrived = 0;
+		uint64_t generation = 0;
+		std::vector<const void*> sendBuffers;
+		std::vector<uint32_t> colors;
+		std::vector<uint32_t> keys;
+		std::vector<std::shared_ptr<VkFFTLoopbackHub>> children;
+		VkFFTLoopbackHub(uint32_t ranks) : size(ranks), sendBuffers(ranks), colors(ranks), keys(ranks), children(ranks) {}
+		void barrier() {
+			std::unique_lock<std::mutex> lock(mutex);
+			uint64_t currentGeneration = generation;
+			arrived++;
+			if (arrived == size) {
+				arrived = 0;
+				generation++;
+				condition.notify_all();
+			}
+			else
+				condition.wait(lock, [this, currentGeneration]() { return generation != currentGeneration; });
+		}
+	};
+
+	//Transport between threads of one process, each thread runs one rank. Used for testing distributed plans on a single machine
+	//and for several devices driven by one process.
+	class VkFFTLoopbackTransport : public VkFFTTransport {
+	private:
+		std::shared_ptr<VkFFTLoopbackHub> hub;
+		uint32_t rank;
+	public:
+		VkFFTLoopbackTransport(std::shared_ptr<VkFFTLoopbackHub> inputHub, uint32_t inputRank) : hub(inputHub), rank(inputRank) {}
+		//transports for ranks 0..ranks-1, hand one to each thread
+		static std::vector<VkFFTLoopbackTransport*> create(uint32_t ranks) {
+			std::shared_ptr<VkFFTLoopbackHub> hub = std::make_shared<VkFFTLoopbackHub>(ranks);
+			std::vector<VkFFTLoopbackTransport*> transports;
+			for (uint32_t i = 0; i < ranks; i++)
+				transports.push_back(new VkFFTLoopbackTransport(hub, i));
+			return transports;
+		}
+		uint32_t getRank() { return rank; }
+		uint32_t getSize() { return hub->size; }
+		VkFFTTransport* split(uint32_t color, uint32_t key) {
+			hub->colors[rank] = color;
+			hub->keys[rank] = key;
+			hub->barrier();
+			//group members ordered by key, first of them creates the shared state
+			std::vector<uint32_t> members;
+			for (uint32_t i = 0; i < hub->size; i++) {
+				if (hub->colors[i] == color) members.push_back(i);
+			}
+			for (uint32_t i = 1; i < members.size(); i++) {
+				for (uint32_t j = i; (j > 0) && (hub->keys[members[j - 1]] > hub->keys[members[j]]); j--)
+					std::swap(members[j - 1], members[j]);
+			}
+			uint32_t newRank = 0;
+			for (uint32_t i = 0; i < members.size(); i++) {
+				if (members[i] == rank) newRank = i;
+			}
+			if (newRank == 0)
+				hub->children[rank] = std::make_shared<VkFFTLoopbackHub>(members.size());
+			hub->barrier();
+			std::shared_ptr<VkFFTLoopbackHub> child = hub->children[members[0]];
+			hub->barrier();
+			hub->children[rank].reset();
+			return new VkFFTLoopbackTransport(child, newRank);
+		}
+		bool allToAll(const void* sendBuffer, void* recvBuffer, uint64_t blockSize) {
+			hub->sendBuffers[rank] = sendBuffer;
+			hub->barrier();
+			for (uint32_t i = 0; i < hub->size; i++)
+				memcpy((char*)recvBuffer + i * blockSize, (const char*)hub->sendBuffers[i] + rank * blockSize, blockSize);
+			//send buffers stay untouched until every rank has read its block
+			hub->barrier();
+			return true;
+		}
+	};
+
+#ifdef VKFFT_USE_MPI
+	//MPI transport, one rank per process. Exchanges are issued from a communication thread while the calling thread drives the GPU,
+	//so MPI has to be initialized with at least MPI_THREAD_SERIALIZED.
+	class VkFFTMPITransport : public VkFFTTransport {
+	private:
+		MPI_Comm comm;
+		bool ownsComm;
+		MPI_Datatype complexType;//blocks are complex numbers, counted in 8 byte elements to stay within int range
+	public:
+		VkFFTMPITransport(MPI_Comm inputComm = MPI_COMM_WORLD, bool inputOwnsComm = false) : comm(inputComm), ownsComm(inputOwnsComm) {
+			MPI_Type_contiguous(8, MPI_BYTE, &complexType);
+			MPI_Type_commit(&complexType);
+		}
+		~VkFFTMPITransport() {
+			MPI_Type_free(&complexType);
+			if (ownsComm) MPI_Comm_free(&comm);
+		}
+		uint32_t getRank() {
+			int rank;
+			MPI_Comm_rank(comm, &rank);
+			return rank;
+		}
+		uint32_t getSize() {
+			int size;
+			MPI_Comm_size(comm, &size);
+			return size;
+		}
+		VkFFTTransport* split(uint32_t color, uint32_t key) {
+			MPI_Comm newComm;
+			MPI_Comm_split(comm, color, key, &newComm);
+			return new VkFFTMPITransport(newComm, true);
+		}
+		bool allToAll(const void* sendBuffer, void* recvBuffer, uint64_t blockSize) {
+			if ((blockSize % 8) || (blockSize / 8 > INT32_MAX)) {
+				printf("VkFFT MPI transport can't exchange blocks of %llu bytes\n", (unsigned long long)blockSize);
+				return false;
+			}
+			return MPI_Alltoall(sendBuffer, (int)(blockSize / 8), complexType, recvBuffer, (int)(blockSize / 8), complexType, comm) == MPI_SUCCESS;
+		}
+	};
+#endif
+
+	typedef struct {
+		uint32_t size[3] = { 1,1,1 };//C2C 3D system
+		uint32_t processGrid[2] = { 1,1 };//Pr x Pc ranks, rank = r + c * Pr. size[0] and size[1] have to be divisible by Pr, size[1] and size[2] by Pc
+		bool inverse = false;
+		uint32_t batchCount = 4;//pencil batches per stage, exchange of one batch overlaps computation of the next
+		char shaderPath[256] = "shaders/";
+		VkPhysicalDevice* physicalDevice;
+		VkDevice* device;
+		VkQueue* queue;
+		uint32_t queueFamilyIndex = 0;
+		VkFFTTransport* transport;//all Pr * Pc ranks
+		VkDeviceSize stagingChunkSize = 1 << 24;
+	} VkFFTPencilConfiguration;
+
+	//3D C2C FFT with 2D pencil decomposition. Rank (r, c) holds:
+	//forward input / inverse output - x pencil: all x, y block r of size[1]/Pr, z block c of size[2]/Pc, layout [z][y][x]
+	//forward output / inverse input - z pencil: x block r of size[0]/Pr, y block c of size[1]/Pc, all z, layout [x][y][z]
+	//Local 1D FFTs alternate with all-to-all exchanges inside process rows (x <-> y) and columns (y <-> z).
+	//Every stage is split in batches - while the GPU transforms batch k, a communication thread exchanges batch k - 1.
+	class VkFFTPencilApplication {
+	private:
+		VkFFTPencilConfiguration configuration = {};
+		VkFFTTransport* rowTransport = 0;//ranks with equal c, exchanges x and y
+		VkFFTTransport* columnTransport = 0;//ranks with equal r, exchanges y and z
+		uint32_t r = 0, c = 0;
+		uint32_t ny = 0, nz = 0, nx = 0, ny2 = 0;//y block of x pencil, z block, x block and y block of z pencil
+		uint32_t zBatches = 1, xBatches = 1;
+		uint64_t localElements = 0;
+
+		VkBuffer buffer = VK_NULL_HANDLE;
+		VkDeviceMemory bufferDeviceMemory = VK_NULL_HANDLE;
+		VkDeviceSize stageBufferSize[3] = { 0,0,0 };
+		VkFFTStagingPool stagingPool;
+		VkFFTApplication apps[3];//batched 1D plans along x, y and z
+		VkCommandPool commandPool = VK_NULL_HANDLE;
+		VkCommandBuffer commandBuffers[3];
+		VkFence fence = VK_NULL_HANDLE;
+		std::vector<float> batchData, sendData, recvData, yPencils;
+
+		//exchanges run on a communication thread in order, ready/done count the batches handed over and finished
+		std::mutex exchangeMutex;
+		std::condition_variable exchangeCondition;
+		uint32_t exchangeReady = 0;
+		uint32_t exchangeDone = 0;
+		bool exchangeFailed = false;
+
+		uint32_t batchesOf(uint32_t n) {
+			uint32_t batches = (configuration.batchCount > 0) ? configuration.batchCount : 1;
+			while (n % batches) batches--;
+			return batches;
+		}
+		VkResult runStage(uint32_t stage, float* data) {
+			VkResult res = stagingPool.upload(data, buffer, stageBufferSize[stage]);
+			if (res != VK_SUCCESS) return res;
+			VkSubmitInfo submitInfo = { VK_STRUCTURE_TYPE_SUBMIT_INFO };
+			submitInfo.commandBufferCount = 1;
+			submitInfo.pCommandBuffers = &commandBuffers[stage];
+			res = vkQueueSubmit(configuration.queue[0], 1, &submitInfo, fence);
+			if (res != VK_SUCCESS) return res;
+			res = vkWaitForFences(configuration.device[0], 1, &fence, VK_TRUE, UINT64_MAX);
+			if (res != VK_SUCCESS) return res;
+			res = vkResetFences(configuration.device[0], 1, &fence);
+			if (res != VK_SUCCESS) return res;
+			return stagingPool.download(data, buffer, stageBufferSize[stage]);
+		}
+		void startExchanges(VkFFTTransport* transport, uint32_t batches, uint64_t batchElements, uint32_t ready, std::thread* thread) {
+			exchangeReady = ready;
+			exchangeDone = 0;
+			exchangeFailed = false;
+			uint64_t blockSize = 2 * sizeof(float) * batchElements / transport->getSize();
+			thread[0] = std::thread([this, transport, batches, batchElements, blockSize]() {
+				for (uint32_t k = 0; k < batches; k++) {
+					{
+						std::unique_lock<std::mutex> lock(exchangeMutex);
+						exchangeCondition.wait(lock, [this, k]() { return exchangeReady > k; });
+					}
+					bool success = transport->allToAll(sendData.data() + 2 * k * batchElements, recvData.data() + 2 * k * batchElements, blockSize);
+					std::unique_lock<std::mutex> lock(exchangeMutex);
+					if (!success) exchangeFailed = true;
+					exchangeDone = k + 1;
+					exchangeCondition.notify_all();
+				}
+			});
+		}
+		void markReady(uint32_t k) {
+			std::unique_lock<std::mutex> lock(exchangeMutex);
+			exchangeReady = k + 1;
+			exchangeCondition.notify_all();
+		}
+		bool waitDone(uint32_t k) {
+			std::unique_lock<std::mutex> lock(exchangeMutex);
+			exchangeCondition.wait(lock, [this, k]() { return exchangeDone > k; });
+			return !exchangeFailed;
+		}
+		//x pencil batch [z][y][x] <-> row exchange blocks [r'][z][y][x of block r']
+		void packRow(float* pencil, float* send, uint32_t nzBatch, bool toPencil) {
+			uint32_t Nx = configuration.size[0];
+			for (uint64_t p = 0; p < configuration.processGrid[0]; p++)
+				for (uint64_t z = 0; z < nzBatch; z++)
+					for (uint64_t y = 0; y < ny; y++)
+						for (uint64_t x = 0; x < nx; x++) {
+							uint64_t pencilId = 2 * ((z * ny + y) * Nx + p * nx + x);
+							uint64_t blockId = 2 * (((p * nzBatch + z) * ny + y) * nx + x);
+							if (toPencil) {
+								pencil[pencilId] = send[blockId];
+								pencil[pencilId + 1] = send[blockId + 1];
+							}
+							else {
+								send[blockId] = pencil[pencilId];
+								send[blockId + 1] = pencil[pencilId + 1];
+							}
+						}
+		}
+		//y pencil batch [z][x][y] <-> row exchange blocks [r'][z][y of block r'][x]
+		void unpackRow(float* pencil, float* recv, uint32_t nzBatch, bool toPencil) {
+			uint32_t Ny = configuration.size[1];
+			for (uint64_t p = 0; p < configuration.processGrid[0]; p++)
+				for (uint64_t z = 0; z < nzBatch; z++)
+					for (uint64_t y = 0; y < ny; y++)
+						for (uint64_t x = 0; x < nx; x++) {
+							uint64_t pencilId = 2 * ((z * nx + x) * Ny + p * ny + y);
+							uint64_t blockId = 2 * (((p * nzBatch + z) * ny + y) * nx + x);
+							if (toPencil) {
+								pencil[pencilId] = recv[blockId];
+								pencil[pencilId + 1] = recv[blockId + 1];
+							}
+							else {
+								recv[blockId] = pencil[pencilId];
+								recv[blockId + 1] = pencil[pencilId + 1];
+							}
+						}
+		}
+		//y pencils [z][x][y], x batch j <-> column exchange blocks [c'][z][x][y of block c']
+		void packColumn(uint32_t j, float* send, bool toPencil) {
+			uint32_t Ny = configuration.size[1];
+			uint32_t nxBatch = nx / xBatches;
+			for (uint64_t p = 0; p < configuration.processGrid[1]; p++)
+				for (uint64_t z = 0; z < nz; z++)
+					for (uint64_t x = 0; x < nxBatch; x++)
+						for (uint64_t y = 0; y < ny2; y++) {
+							uint64_t pencilId = 2 * ((z * nx + j * nxBatch + x) * Ny + p * ny2 + y);
+							uint64_t blockId = 2 * (((p * nz + z) * nxBatch + x) * ny2 + y);
+							if (toPencil) {
+								yPencils[pencilId] = send[blockId];
+								yPencils[pencilId + 1] = send[blockId + 1];
+							}
+							else {
+								send[blockId] = yPencils[pencilId];
+								send[blockId + 1] = yPencils[pencilId + 1];
+							}
+						}
+		}
+		//z pencil batch [x][y][z] <-> column exchange blocks [c'][z of block c'][x][y]
+		void unpackColumn(float* pencil, float* recv, bool toPencil) {
+			uint32_t Nz = configuration.size[2];
+			uint32_t nxBatch = nx / xBatches;
+			for (uint64_t p = 0; p < configuration.processGrid[1]; p++)
+				for (uint64_t z = 0; z < nz; z++)
+					for (uint64_t x = 0; x < nxBatch; x++)
+						for (uint64_t y = 0; y < ny2; y++) {
+							uint64_t pencilId = 2 * ((x * ny2 + y) * Nz + p * nz + z);
+							uint64_t blockId = 2 * (((p * nz + z) * nxBatch + x) * ny2 + y);
+							if (toPencil) {
+								pencil[pencilId] = recv[blockId];
+								pencil[pencilId + 1] = recv[blockId + 1];
+							}
+							else {
+								recv[blockId] = pencil[pencilId];
+								recv[blockId + 1] = pencil[pencilId + 1];
+							}
+						}
+		}
+		VkResult forward(float* data) {
+			uint32_t nzBatch = nz / zBatches;
+			uint32_t nxBatch = nx / xBatches;
+			uint64_t zBatchElements = localElements / zBatches;
+			uint64_t xBatchElements = localElements / xBatches;
+			VkResult res = VK_SUCCESS;
+			std::thread exchangeThread;
+			//axis 0 on x pencils, row exchange of batch k runs during axis 0 of batch k + 1
+			startExchanges(rowTransport, zBatches, zBatchElements, 0, &exchangeThread);
+			for (uint32_t k = 0; (k < zBatches) && (res == VK_SUCCESS); k++) {
+				memcpy(batchData.data(), data + 2 * k * zBatchElements, 2 * sizeof(float) * zBatchElements);
+				res = runStage(0, batchData.data());
+				packRow(batchData.data(), sendData.data() + 2 * k * zBatchElements, nzBatch, false);
+				markReady(k);
+			}
+			//axis 1 on y pencils
+			for (uint32_t k = 0; (k < zBatches) && (res == VK_SUCCESS); k++) {
+				if (!waitDone(k)) res = VK_ERROR_INITIALIZATION_FAILED;
+				unpackRow(yPencils.data() + 2 * k * zBatchElements, recvData.data() + 2 * k * zBatchElements, nzBatch, true);
+				if (res == VK_SUCCESS) res = runStage(1, yPencils.data() + 2 * k * zBatchElements);
+			}
+			markReady(zBatches);
+			exchangeThread.join();
+			if (res != VK_SUCCESS) return res;
+			//column exchange of x batch j runs during axis 2 of batch j - 1
+			for (uint32_t j = 0; j < xBatches; j++)
+				packColumn(j, sendData.data() + 2 * j * xBatchElements, false);
+			startExchanges(columnTransport, xBatches, xBatchElements, xBatches, &exchangeThread);
+			for (uint32_t j = 0; (j < xBatches) && (res == VK_SUCCESS); j++) {
+				if (!waitDone(j)) res = VK_ERROR_INITIALIZATION_FAILED;
+				float* zPencils = data + 2 * j * nxBatch * ny2 * configuration.size[2];
+				unpackColumn(zPencils, recvData.data() + 2 * j * xBatchElements, true);
+				if (res == VK_SUCCESS) res = runStage(2, zPencils);
+			}
+			exchangeThread.join();
+			return res;
+		}
+		VkResult inverse(float* data) {
+			uint32_t nzBatch = nz / zBatches;
+			uint32_t nxBatch = nx / xBatches;
+			uint64_t zBatchElements = localElements / zBatches;
+			uint64_t xBatchElements = localElements / xBatches;
+			VkResult res = VK_SUCCESS;
+			std::thread exchangeThread;
+			//axis 2 on z pencils
+			startExchanges(columnTransport, xBatches, xBatchElements, 0, &exchangeThread);
+			for (uint32_t j = 0; (j < xBatches) && (res == VK_SUCCESS); j++) {
+				float* zPencils = data + 2 * j * nxBatch * ny2 * configuration.size[2];
+				res = runStage(2, zPencils);
+				unpackColumn(zPencils, sendData.data() + 2 * j * xBatchElements, false);
+				markReady(j);
+			}
+			for (uint32_t j = 0; (j < xBatches) && (res == VK_SUCCESS); j++) {
+				if (!waitDone(j)) res = VK_ERROR_INITIALIZATION_FAILED;
+				packColumn(j, recvData.data() + 2 * j * xBatchElements, true);
+			}
+			markReady(xBatches);
+			exchangeThread.join();
+			if (res != VK_SUCCESS) return res;
+			//axis 1 on y pencils, then row exchange back to x pencils for axis 0
+			startExchanges(rowTransport, zBatches, zBatchElements, 0, &exchangeThread);
+			for (uint32_t k = 0; (k < zBatches) && (res == VK_SUCCESS); k++) {
+				res = runStage(1, yPencils.data() + 2 * k * zBatchElements);
+				unpackRow(yPencils.data() + 2 * k * zBatchElements, sendData.data() + 2 * k * zBatchElements, nzBatch, false);
+				markReady(k);
+			}
+			for (uint32_t k = 0; (k < zBatches) && (res == VK_SUCCESS); k++) {
+				if (!waitDone(k)) res = VK_ERROR_INITIALIZATION_FAILED;
+				packRow(data + 2 * k * zBatchElements, recvData.data() + 2 * k * zBatchElements, nzBatch, true);
+				if (res == VK_SUCCESS) res = runStage(0, data + 2 * k * zBatchElements);
+			}
+			markReady(zBatches);
+			exchangeThread.join();
+			return res;
+		}
+		//returns at the first failure and leaves the cleanup to deleteVulkanFFTPencil
+		VkResult createPencil() {
+			VkResult res = VK_SUCCESS;
+			stageBufferSize[0] = 2 * sizeof(float) * localElements / zBatches;
+			stageBufferSize[1] = stageBufferSize[0];
+			stageBufferSize[2] = 2 * sizeof(float) * localElements / xBatches;
+			VkDeviceSize bufferSize = (stageBufferSize[0] > stageBufferSize[2]) ? stageBufferSize[0] : stageBufferSize[2];
+			VkBufferCreateInfo bufferCreateInfo = { VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
+			bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+			bufferCreateInfo.queueFamilyIndexCount = 1;
+			bufferCreateInfo.pQueueFamilyIndices = &configuration.queueFamilyIndex;
+			bufferCreateInfo.size = bufferSize;
+			bufferCreateInfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+			res = VkFFTAllocateBuffer(configuration.physicalDevice[0], configuration.device[0], &bufferCreateInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &buffer, &bufferDeviceMemory);
+			if (res != VK_SUCCESS) return res;
+
+			VkFFTStagingPoolConfiguration stagingPoolConfiguration = {};
+			stagingPoolConfiguration.physicalDevice = configuration.physicalDevice;
+			stagingPoolConfiguration.device = configuration.device;
+			stagingPoolConfiguration.queue = configuration.queue;
+			stagingPoolConfiguration.queueFamilyIndex = configuration.queueFamilyIndex;
+			stagingPoolConfiguration.chunkSize = (configuration.stagingChunkSize < bufferSize) ? configuration.stagingChunkSize : bufferSize;
+			res = stagingPool.initializeStagingPool(stagingPoolConfiguration);
+			if (res != VK_SUCCESS) return res;
+
+			VkCommandPoolCreateInfo commandPoolCreateInfo = { VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO };
+			commandPoolCreateInfo.queueFamilyIndex = configuration.queueFamilyIndex;
+			res = vkCreateCommandPool(configuration.device[0], &commandPoolCreateInfo, NULL, &commandPool);
+			if (res != VK_SUCCESS) return res;
+			VkCommandBufferAllocateInfo commandBufferAllocateInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
+			commandBufferAllocateInfo.commandPool = commandPool;
+			commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+			commandBufferAllocateInfo.commandBufferCount = 3;
+			res = vkAllocateCommandBuffers(configuration.device[0], &commandBufferAllocateInfo, commandBuffers);
+			if (res != VK_SUCCESS) return res;
+			VkFenceCreateInfo fenceCreateInfo = { VK_STRUCTURE_TYPE_FENCE_CREATE_INFO };
+			res = vkCreateFence(configuration.device[0], &fenceCreateInfo, NULL, &fence);
+			if (res != VK_SUCCESS) return res;
+
+			//batches: x pencil [z][y][x], y pencil [z][x][y], z pencil [x][y][z]
+			uint32_t localSizes[3][3] = {
+				{ configuration.size[0], ny, nz / zBatches },
+				{ configuration.size[1], nx, nz / zBatches },
+				{ configuration.size[2], ny2, nx / xBatches } };
+			for (uint32_t i = 0; i < 3; i++) {
+				VkFFTConfiguration axisConfiguration = {};
+				axisConfiguration.FFTdim = 1;
+				for (uint32_t j = 0; j < 3; j++)
+					axisConfiguration.size[j] = localSizes[i][j];
+				axisConfiguration.inverse = configuration.inverse;
+				strcpy(axisConfiguration.shaderPath, configuration.shaderPath);
+				axisConfiguration.physicalDevice = configuration.physicalDevice;
+				axisConfiguration.device = configuration.device;
+				axisConfiguration.buffer = &buffer;
+				axisConfiguration.bufferSize = &stageBufferSize[i];
+				axisConfiguration.bufferDeviceMemory = &bufferDeviceMemory;
+				res = apps[i].initializeVulkanFFT(axisConfiguration);
+				if (res != VK_SUCCESS) return res;
+
+				VkCommandBuffer commandBuffer = commandBuffers[i];
+				VkCommandBufferBeginInfo commandBufferBeginInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+				res = vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo);
+				if (res != VK_SUCCESS) return res;
+				VkMemoryBarrier memory_barrier = { VK_STRUCTURE_TYPE_MEMORY_BARRIER, nullptr, VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT };
+				vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
+				apps[i].VkFFTAppend(commandBuffer);
+				memory_barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+				memory_barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+				vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
+				res = vkEndCommandBuffer(commandBuffer);
+				if (res != VK_SUCCESS) return res;
+			}
+			batchData.resize(2 * localElements / zBatches);
+			sendData.resize(2 * localElements);
+			recvData.resize(2 * localElements);
+			yPencils.resize(2 * localElements);
+			return res;
+		}
+	public:
+		//returns VK_SUCCESS or the error that stopped initialization, everything created before it is released
+		VkResult initializeVulkanFFTPencil(VkFFTPencilConfiguration inputConfiguration) {
+			configuration = inputConfiguration;
+			uint32_t Pr = configuration.processGrid[0];
+			uint32_t Pc = configuration.processGrid[1];
+			if ((Pr * Pc != configuration.transport->getSize()) || (configuration.size[0] % Pr) || (configuration.size[1] % Pr) || (configuration.size[1] % Pc) || (configuration.size[2] % Pc)) {
+				printf("VkFFT pencil decomposition needs Pr*Pc ranks, size[0] and size[1] divisible by Pr, size[1] and size[2] divisible by Pc\n");
+				return VK_ERROR_INITIALIZATION_FAILED;
+			}
+			uint32_t rank = configuration.transport->getRank();
+			r = rank % Pr;
+			c = rank / Pr;
+			rowTransport = configuration.transport->split(c, r);
+			columnTransport = configuration.transport->split(Pc + r, c);
+			ny = configuration.size[1] / Pr;
+			nz = configuration.size[2] / Pc;
+			nx = configuration.size[0] / Pr;
+			ny2 = configuration.size[1] / Pc;
+			zBatches = batchesOf(nz);
+			xBatches = batchesOf(nx);
+			localElements = (uint64_t)configuration.size[0] * configuration.size[1] * configuration.size[2] / (Pr * Pc);
+			VkResult res = createPencil();
+			//everything created before the failure is released, the application can be initialized again
+			if (res != VK_SUCCESS) deleteVulkanFFTPencil();
+			return res;
+		}
+		//In-place transform of the local part of the system: x pencil -> z pencil for forward, z pencil -> x pencil for inverse.
+		//Collective - all ranks have to call it.
+		VkResult performVulkanFFTPencil(float* data) {
+			if (configuration.inverse)
+				return inverse(data);
+			else
+				return forward(data);
+		}
+		void deleteVulkanFFTPencil() {
+			for (uint32_t i = 0; i < 3; i++)
+				apps[i].deleteVulkanFFT();
+			stagingPool.deleteStagingPool();
+			if (fence != VK_NULL_HANDLE) vkDestroyFence(configuration.device[0], fence, NULL);
+			if (commandPool != VK_NULL_HANDLE) vkDestroyCommandPool(configuration.device[0], commandPool, NULL);
+			VkFFTFreeBuffer(configuration.device[0], &buffer, &bufferDeviceMemory);
+			fence = VK_NULL_HANDLE;
+			commandPool = VK_NULL_HANDLE;
+			delete rowTransport;
+			delete columnTransport;
+			rowTransport = 0;
+			columnTransport = 0;
+		}
+	};
+}
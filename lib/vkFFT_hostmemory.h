@@ -0,0 +1,124 @@
+#pragma once
+#include "vkFFT.h"
+
+namespace VkFFT
+{
+	//Host allocation imported with VK_EXT_external_memory_host. Fields are laid out so they can be passed to VkFFTConfiguration directly:
+	//configuration.buffer = &hostBuffer.buffer; configuration.bufferSize = &hostBuffer.bufferSize; configuration.bufferDeviceMemory = &hostBuffer.deviceMemory;
+	typedef struct {
+		VkBuffer buffer = VK_NULL_HANDLE;
+		VkDeviceMemory deviceMemory = VK_NULL_HANDLE;
+		VkDeviceSize bufferSize = 0;
+		void* hostPointer = 0;
+	} VkFFTHostBuffer;
+
+	inline bool VkFFTHostMemorySupported(VkPhysicalDevice physicalDevice) {
+		uint32_t extensionCount = 0;
+		vkEnumerateDeviceExtensionProperties(physicalDevice, NULL, &extensionCount, NULL);
+		std::vector<VkExtensionProperties> extensions(extensionCount);
+		vkEnumerateDeviceExtensionProperties(physicalDevice, NULL, &extensionCount, extensions.data());
+		for (uint32_t i = 0; i < extensionCount; i++) {
+			if (!strcmp(extensions[i].extensionName, VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME)) return true;
+		}
+		return false;
+	}
+	//Host pointer and size of an import have to be multiples of this value (usually the page size).
+	inline VkDeviceSize VkFFTGetHostPointerAlignment(VkPhysicalDevice physicalDevice) {
+		VkPhysicalDeviceExternalMemoryHostPropertiesEXT hostProperties = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTERNAL_MEMORY_HOST_PROPERTIES_EXT };
+		VkPhysicalDeviceProperties2 properties = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2 };
+		properties.pNext = &hostProperties;
+		vkGetPhysicalDeviceProperties2(physicalDevice, &properties);
+		return hostProperties.minImportedHostPointerAlignment;
+	}
+	//Releases the Vulkan objects, host memory itself stays owned by the caller. Also cleans up a failed VkFFTImportHostMemory, null handles are skipped.
+	inline void VkFFTReleaseHostMemory(VkDevice device, VkFFTHostBuffer* hostBuffer) {
+		if (hostBuffer->buffer != VK_NULL_HANDLE) vkDestroyBuffer(device, hostBuffer->buffer, NULL);
+		if (hostBuffer->deviceMemory != VK_NULL_HANDLE) vkFreeMemory(device, hostBuffer->deviceMemory, NULL);
+		hostBuffer->buffer = VK_NULL_HANDLE;
+		hostBuffer->deviceMemory = VK_NULL_HANDLE;
+		hostBuffer->bufferSize = 0;
+		hostBuffer->hostPointer = 0;
+	}
+	//Wraps size bytes of host memory at hostPointer into a storage buffer without copying. Device must be created with VK_EXT_external_memory_host.
+	//Used as VkFFT buffer, the first axis reads the input directly from host memory and the last axis writes the result back to it, which removes
+	//staging copies on integrated and UMA devices. On discrete GPUs it can instead be the source/destination of a single vkCmdCopyBuffer to a device-local buffer.
+	//Memory must stay allocated until VkFFTReleaseHostMemory is called.
+	inline VkResult VkFFTImportHostMemory(VkPhysicalDevice physicalDevice, VkDevice device, void* hostPointer, VkDeviceSize size, VkFFTHostBuffer* hostBuffer) {
+		VkDeviceSize alignment = VkFFTGetHostPointerAlignment(physicalDevice);
+		if ((alignment == 0) || ((uint64_t)hostPointer % alignment) || (size % alignment)) {
+			printf("Host pointer %p and size %llu have to be aligned to %llu bytes\n", hostPointer, (unsigned long long)size, (unsigned long long)alignment);
+			return VK_ERROR_INVALID_EXTERNAL_HANDLE;
+		}
+		PFN_vkGetMemoryHostPointerPropertiesEXT getMemoryHostPointerProperties = (PFN_vkGetMemoryHostPointerPropertiesEXT)vkGetDeviceProcAddr(device, "vkGetMemoryHostPointerPropertiesEXT");
+		if (getMemoryHostPointerProperties == NULL) {
+			printf("VK_EXT_external_memory_host is not enabled on the device\n");
+			return VK_ERROR_EXTENSION_NOT_PRESENT;
+		}
+		VkMemoryHostPointerPropertiesEXT hostPointerProperties = { VK_STRUCTURE_TYPE_MEMORY_HOST_POINTER_PROPERTIES_EXT };
+		VkResult res = getMemoryHostPointerProperties(device, VK_EXTERNAL_MEMORY_HANDLE_TYPE_HOST_ALLOCATION_BIT_EXT, hostPointer, &hostPointerProperties);
+		if (res != VK_SUCCESS) return res;
+		hostBuffer->buffer = VK_NULL_HANDLE;
+		hostBuffer->deviceMemory = VK_NULL_HANDLE;
+
+		VkExternalMemoryBufferCreateInfo externalMemoryBufferCreateInfo = { VK_STRUCTURE_TYPE_EXTERNAL_MEMORY_BUFFER_CREATE_INFO };
+		externalMemoryBufferCreateInfo.handleTypes = VK_EXTERNAL_MEMORY_HANDLE_TYPE_HOST_ALLOCATION_BIT_EXT;
+		VkBufferCreateInfo bufferCreateInfo = { VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
+		bufferCreateInfo.pNext = &externalMemoryBufferCreateInfo;
+		bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+		bufferCreateInfo.size = size;
+		bufferCreateInfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+		res = vkCreateBuffer(device, &bufferCreateInfo, NULL, &hostBuffer->buffer);
+		if (res != VK_SUCCESS) {
+			hostBuffer->buffer = VK_NULL_HANDLE;
+			return res;
+		}
+		VkMemoryRequirements memoryRequirements = {};
+		vkGetBufferMemoryRequirements(device, hostBuffer->buffer, &memoryRequirements);
+
+		//prefer coherent memory, so no flushes are needed between host and GPU access
+		VkPhysicalDeviceMemoryProperties memoryProperties = {};
+		vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memoryProperties);
+		uint32_t memoryTypeBits = memoryRequirements.memoryTypeBits & hostPointerProperties.memoryTypeBits;
+		uint32_t memoryTypeIndex = UINT32_MAX;
+		for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; ++i) {
+			if (!(memoryTypeBits & (1 << i))) continue;
+			if (memoryTypeIndex == UINT32_MAX) memoryTypeIndex = i;
+			if (memoryProperties.memoryTypes[i].propertyFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) {
+				memoryTypeIndex = i;
+				break;
+			}
+		}
+		if (memoryTypeIndex == UINT32_MAX) {
+			printf("No memory type can import host pointer %p as a storage buffer\n", hostPointer);
+			VkFFTReleaseHostMemory(device, hostBuffer);
+			return VK_ERROR_INVALID_EXTERNAL_HANDLE;
+		}
+
+		VkImportMemoryHostPointerInfoEXT importMemoryHostPointerInfo = { VK_STRUCTURE_TYPE_IMPORT_MEMORY_HOST_POINTER_INFO_EXT };
+		importMemoryHostPointerInfo.handleType = VK_EXTERNAL_MEMORY_HANDLE_TYPE_HOST_ALLOCATION_BIT_EXT;
+		importMemoryHostPointerInfo.pHostPointer = hostPointer;
+		VkMemoryAllocateInfo memoryAllocateInfo = { VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO };
+		memoryAllocateInfo.pNext = &importMemoryHostPointerInfo;
+		memoryAllocateInfo.allocationSize = size;
+		memoryAllocateInfo.memoryTypeIndex = memoryTypeIndex;
+		res = vkAllocateMemory(device, &memoryAllocateInfo, NULL, &hostBuffer->deviceMemory);
+		if (res != VK_SUCCESS) {
+			hostBuffer->deviceMemory = VK_NULL_HANDLE;
+			VkFFTReleaseHostMemory(device, hostBuffer);
+			return res;
+		}
+		res = vkBindBufferMemory(device, hostBuffer->buffer, hostBuffer->deviceMemory, 0);
+		if (res != VK_SUCCESS) {
+			VkFFTReleaseHostMemory(device, hostBuffer);
+			return res;
+		}
+		hostBuffer->bufferSize = size;
+		hostBuffer->hostPointer = hostPointer;
+		return res;
+	}
+	//Makes shader writes to the imported memory visible to the host. Record after VkFFTAppend, before the fence the host waits on.
+	inline void VkFFTHostMemoryBarrier(VkCommandBuffer commandBuffer) {
+		VkMemoryBarrier memory_barrier = { VK_STRUCTURE_TYPE_MEMORY_BARRIER, nullptr, VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_HOST_READ_BIT };
+		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
+	}
+}
@@ -0,0 +1,231 @@
+#pragma once
+#include "vkFFT.h"
+#include "vkFFT_staging.h"
+
+namespace VkFFT
+{
+	typedef struct {
+		VkFFTConfiguration configuration;//convolution plan the kernel is made for: size, FFTdim, performR2C, vectorDimension, symmetricKernel, inputChannels, outputChannels. Buffer and kernel fields are not used
+		uint32_t kernelSize[3] = { 0,0,0 };//size of the spatial kernel, 0 - same as configuration.size. Smaller kernels are zero padded to the system size
+		bool centered = false;//kernel center (kernelSize/2) is moved to the origin with wrap-around, so the convolution doesn't shift the data
+		VkQueue* queue;//queue used for the upload and the kernel FFT
+		uint32_t queueFamilyIndex = 0;
+		VkFFTStagingPool* stagingPool = 0;//optional, a temporary pool is created for the upload if not set
+	} VkFFTKernelConfiguration;
+
+	//Frequency-domain convolution kernel. The spatial kernel is padded and transformed once in initializeKernel, the result can be attached to any number of convolution plans of the same shape.
+	//Kernel is stored compressed where possible: half spectrum for R2C systems and upper triangle (xx, xy, yy or xx, xy, xz, yy, yz, zz) for symmetric 2x2 and 3x3 kernels.
+	class VkFFTKernel {
+	private:
+		VkFFTKernelConfiguration configuration = {};
+		VkDevice device = VK_NULL_HANDLE;
+		VkBuffer kernel = VK_NULL_HANDLE;
+		VkDeviceMemory kernelDeviceMemory = VK_NULL_HANDLE;
+		VkDeviceSize kernelBufferSize = 0;
+		uint32_t storedComponents = 0;
+
+		//spatial component of stored component c: upper triangle of the matrix for symmetric kernels, all entries otherwise
+		uint32_t sourceComponent(uint32_t c) {
+			uint32_t n = configuration.configuration.vectorDimension;
+			if (storedComponents == kernelComponents(&configuration.configuration, false))
+				return c;
+			for (uint32_t a = 0; a < n; a++) {
+				if (c < n - a)
+					return a * n + a + c;
+				c -= n - a;
+			}
+			return 0;
+		}
+		//zero padded, optionally centered kernel in VkFFT buffer layout, R2C systems are real and each z plane takes (size[0]+2)*size[1] floats
+		void padKernel(const float* spatialKernel, std::vector<float>* padded) {
+			VkFFTConfiguration* conf = &configuration.configuration;
+			uint32_t* kernelSize = configuration.kernelSize;
+			uint64_t kernelElements = (uint64_t)kernelSize[0] * kernelSize[1] * kernelSize[2];
+			uint32_t complexValues = (conf->performR2C) ? 1 : 2;
+			padded->assign(kernelBufferSize / sizeof(float), 0);
+			for (uint32_t c = 0; c < storedComponents; c++) {
+				const float* src = spatialKernel + (uint64_t)sourceComponent(c) * kernelElements * complexValues;
+				for (uint32_t k = 0; k < kernelSize[2]; k++) {
+					for (uint32_t j = 0; j < kernelSize[1]; j++) {
+						for (uint32_t i = 0; i < kernelSize[0]; i++) {
+							uint32_t x = (configuration.centered) ? (i + conf->size[0] - kernelSize[0] / 2) % conf->size[0] : i;
+							uint32_t y = (configuration.centered) ? (j + conf->size[1] - kernelSize[1] / 2) % conf->size[1] : j;
+							uint32_t z = (configuration.centered) ? (k + conf->size[2] - kernelSize[2] / 2) % conf->size[2] : k;
+							uint64_t srcId = i + j * kernelSize[0] + (uint64_t)k * kernelSize[0] * kernelSize[1];
+							if (conf->performR2C) {
+								uint64_t planeSize = (uint64_t)(conf->size[0] + 2) * conf->size[1];
+								(*padded)[x + y * conf->size[0] + z * planeSize + c * planeSize * conf->size[2]] = src[srcId];
+							}
+							else {
+								uint64_t dstId = x + y * conf->size[0] + (uint64_t)z * conf->size[0] * conf->size[1] + (uint64_t)c * conf->size[0] * conf->size[1] * conf->size[2];
+								(*padded)[2 * dstId] = src[2 * srcId];
+								(*padded)[2 * dstId + 1] = src[2 * srcId + 1];
+							}
+						}
+					}
+				}
+			}
+		}
+		VkResult transformKernel() {
+			VkFFTConfiguration kernelConfiguration = configuration.configuration;
+			kernelConfiguration.performConvolution = false;
+			kernelConfiguration.performCorrelation = false;
+			kernelConfiguration.inverse = false;
+			kernelConfiguration.inputChannels = 0;
+			kernelConfiguration.outputChannels = 0;
+			kernelConfiguration.filterBankSize = 0;
+			kernelConfiguration.vectorDimension = storedComponents;
+			kernelConfiguration.buffer = &kernel;
+			kernelConfiguration.bufferSize = &kernelBufferSize;
+			kernelConfiguration.bufferDeviceMemory = &kernelDeviceMemory;
+			VkFFTApplication app;
+			VkResult res = app.initializeVulkanFFT(kernelConfiguration);
+			if (res != VK_SUCCESS) return res;
+
+			VkCommandPool commandPool = VK_NULL_HANDLE;
+			VkCommandPoolCreateInfo commandPoolCreateInfo = { VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO };
+			commandPoolCreateInfo.queueFamilyIndex = configuration.queueFamilyIndex;
+			res = vkCreateCommandPool(device, &commandPoolCreateInfo, NULL, &commandPool);
+			if (res != VK_SUCCESS) {
+				app.deleteVulkanFFT();
+				return res;
+			}
+			VkCommandBufferAllocateInfo commandBufferAllocateInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
+			commandBufferAllocateInfo.commandPool = commandPool;
+			commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+			commandBufferAllocateInfo.commandBufferCount = 1;
+			VkCommandBuffer commandBuffer = {};
+			VkFence fence = VK_NULL_HANDLE;
+			VkFenceCreateInfo fenceCreateInfo = { VK_STRUCTURE_TYPE_FENCE_CREATE_INFO };
+			res = vkAllocateCommandBuffers(device, &commandBufferAllocateInfo, &commandBuffer);
+			if (res == VK_SUCCESS) res = vkCreateFence(device, &fenceCreateInfo, NULL, &fence);
+			VkCommandBufferBeginInfo commandBufferBeginInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+			commandBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+			if (res == VK_SUCCESS) res = vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo);
+			if (res == VK_SUCCESS) {
+				//make the staging copies visible to the FFT
+				VkMemoryBarrier memory_barrier = { VK_STRUCTURE_TYPE_MEMORY_BARRIER, nullptr, VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT };
+				vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
+				app.VkFFTAppend(commandBuffer);
+				res = vkEndCommandBuffer(commandBuffer);
+			}
+			if (res == VK_SUCCESS) {
+				VkSubmitInfo submitInfo = { VK_STRUCTURE_TYPE_SUBMIT_INFO };
+				submitInfo.commandBufferCount = 1;
+				submitInfo.pCommandBuffers = &commandBuffer;
+				res = vkQueueSubmit(configuration.queue[0], 1, &submitInfo, fence);
+			}
+			if (res == VK_SUCCESS) res = vkWaitForFences(device, 1, &fence, VK_TRUE, UINT64_MAX);
+			if (fence != VK_NULL_HANDLE) vkDestroyFence(device, fence, NULL);
+			vkDestroyCommandPool(device, commandPool, NULL);
+			app.deleteVulkanFFT();
+			return res;
+		}
+		//returns at the first failure and leaves the cleanup to deleteKernel
+		VkResult createKernel(const float* spatialKernel) {
+			VkFFTConfiguration* conf = &configuration.configuration;
+			storedComponents = kernelComponents(conf, true);
+			uint32_t sizeX = (conf->performR2C) ? conf->size[0] / 2 + 1 : conf->size[0];
+			kernelBufferSize = (VkDeviceSize)storedComponents * sizeof(float) * 2 * sizeX * conf->size[1] * conf->size[2];
+
+			VkBufferCreateInfo bufferCreateInfo = { VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
+			bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+			bufferCreateInfo.queueFamilyIndexCount = 1;
+			bufferCreateInfo.pQueueFamilyIndices = &configuration.queueFamilyIndex;
+			bufferCreateInfo.size = kernelBufferSize;
+			bufferCreateInfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+			VkResult res = VkFFTAllocateBuffer(conf->physicalDevice[0], device, &bufferCreateInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &kernel, &kernelDeviceMemory);
+			if (res != VK_SUCCESS) return res;
+
+			std::vector<float> padded;
+			padKernel(spatialKernel, &padded);
+			VkFFTStagingPool temporaryPool;
+			VkFFTStagingPool* stagingPool = configuration.stagingPool;
+			if (stagingPool == 0) {
+				VkFFTStagingPoolConfiguration stagingPoolConfiguration = {};
+				stagingPoolConfiguration.physicalDevice = conf->physicalDevice;
+				stagingPoolConfiguration.device = conf->device;
+				stagingPoolConfiguration.queue = configuration.queue;
+				stagingPoolConfiguration.queueFamilyIndex = configuration.queueFamilyIndex;
+				stagingPoolConfiguration.chunkSize = 1 << 24;
+				res = temporaryPool.initializeStagingPool(stagingPoolConfiguration);
+				if (res != VK_SUCCESS) return res;
+				stagingPool = &temporaryPool;
+			}
+			res = stagingPool->upload(padded.data(), kernel, kernelBufferSize);
+			if (configuration.stagingPool == 0)
+				temporaryPool.deleteStagingPool();
+			if (res != VK_SUCCESS) return res;
+			return transformKernel();
+		}
+	public:
+		//Number of kernel systems a convolution plan reads (stored = true) or the full matrix the spatial kernel is given as (stored = false).
+		//1 for 1x1, n*n for nxn, outputChannels*inputChannels for kernel matrix convolutions and filterBankSize for filter banks. Symmetric 2x2 and 3x3 kernels store n*(n+1)/2 systems.
+		static uint32_t kernelComponents(VkFFTConfiguration* convolutionConfiguration, bool stored) {
+			uint32_t n = convolutionConfiguration->vectorDimension;
+			if (convolutionConfiguration->filterBankSize > 0)
+				return convolutionConfiguration->filterBankSize;
+			if ((convolutionConfiguration->inputChannels > 0) || (convolutionConfiguration->outputChannels > 0) || (n > 3)) {
+				uint32_t inputChannels = (convolutionConfiguration->inputChannels > 0) ? convolutionConfiguration->inputChannels : n;
+				uint32_t outputChannels = (convolutionConfiguration->outputChannels > 0) ? convolutionConfiguration->outputChannels : inputChannels;
+				return inputChannels * outputChannels;
+			}
+			if ((stored) && (convolutionConfiguration->symmetricKernel) && (n > 1))
+				return n * (n + 1) / 2;
+			return n * n;
+		}
+		//spatialKernel holds kernelComponents(&configuration, false) systems of kernelSize, entry (a, b) of the kernel matrix is system a*n+b (a*inputChannels+b for kernel matrix convolutions).
+		//Values are real for R2C systems and interleaved complex otherwise. Returns when the frequency-domain kernel is on the device.
+		VkResult initializeKernel(VkFFTKernelConfiguration inputConfiguration, const float* spatialKernel) {
+			configuration = inputConfiguration;
+			VkFFTConfiguration* conf = &configuration.configuration;
+			if ((conf->physicalDevice == 0) || (configuration.queue == 0)) {
+				printf("VkFFT kernel requires physicalDevice and queue\n");
+				return VK_ERROR_INITIALIZATION_FAILED;
+			}
+			for (uint32_t i = 0; i < 3; i++) {
+				if (configuration.kernelSize[i] == 0) configuration.kernelSize[i] = conf->size[i];
+				if (configuration.kernelSize[i] > conf->size[i]) {
+					printf("VkFFT kernel size %d along axis %d is larger than the system size %d\n", configuration.kernelSize[i], i, conf->size[i]);
+					return VK_ERROR_INITIALIZATION_FAILED;
+				}
+			}
+			device = conf->device[0];
+			//everything created before the failure is released, the kernel can be initialized again
+			VkResult res = createKernel(spatialKernel);
+			if (res != VK_SUCCESS) deleteKernel();
+			return res;
+		}
+		//Points the kernel fields of a convolution configuration to this kernel. Plans of the same size, dimensionality, R2C mode, transposes and kernel components can share it.
+		VkResult attach(VkFFTConfiguration* convolutionConfiguration) {
+			VkFFTConfiguration* conf = &configuration.configuration;
+			bool match = (convolutionConfiguration->FFTdim == conf->FFTdim) && (convolutionConfiguration->performR2C == conf->performR2C) && (convolutionConfiguration->performZeropadding == conf->performZeropadding);
+			for (uint32_t i = 0; i < 3; i++)
+				match = match && (convolutionConfiguration->size[i] == conf->size[i]);
+			for (uint32_t i = 0; i < 2; i++)
+				match = match && (convolutionConfiguration->performTranspose[i] == conf->performTranspose[i]);
+			match = match && (kernelComponents(convolutionConfiguration, true) == storedComponents) && (kernelComponents(convolutionConfiguration, false) == kernelComponents(conf, false));
+			if (!match) {
+				printf("VkFFT kernel was made for a different convolution shape\n");
+				return VK_ERROR_FORMAT_NOT_SUPPORTED;
+			}
+			convolutionConfiguration->kernel = &kernel;
+			convolutionConfiguration->kernelSize = &kernelBufferSize;
+			convolutionConfiguration->kernelDeviceMemory = &kernelDeviceMemory;
+			return VK_SUCCESS;
+		}
+		uint32_t getStoredComponents() {
+			return storedComponents;
+		}
+		VkDeviceSize getKernelBufferSize() {
+			return kernelBufferSize;
+		}
+		//plans the kernel is attached to have to be deleted first
+		void deleteKernel() {
+			if (kernel != VK_NULL_HANDLE) vkDestroyBuffer(device, kernel, NULL);
+			if (kernelDeviceMemory != VK_NULL_HANDLE) vkFreeMemory(device, kernelDeviceMemory, NULL);
+			kernel = VK_NULL_HANDLE;
+			kernelDeviceMemory = VK_NULL_HANDLE;
+		}
+	};
+}
@@ -0,0 +1,259 @@
+#pragma once
+#include "vkFFT.h"
+#include "vkFFT_staging.h"
+
+namespace VkFFT
+{
+	typedef struct {
+		uint32_t size[3] = { 1,1,1 };//C2C 3D system, size[1] and size[2] have to be divisible by deviceCount
+		bool inverse = false;
+		char shaderPath[256] = "shaders/";
+		uint32_t deviceCount = 1;
+		VkPhysicalDevice* physicalDevices;//deviceCount entries, logical devices may share one physical device
+		VkDevice* devices;
+		VkQueue* queues;//compute queue of each device
+		uint32_t* queueFamilyIndices;
+		VkDeviceSize stagingChunkSize = 1 << 24;
+	} VkFFTSlabConfiguration;
+
+	typedef struct {
+		VkBuffer buffer = VK_NULL_HANDLE;//z slab [z_local][y][x], after the exchange y slab [z][y_local][x]
+		VkDeviceMemory bufferDeviceMemory = VK_NULL_HANDLE;
+		VkBuffer exchangeBuffer = VK_NULL_HANDLE;//z slab packed in blocks [destination][z_local][y_local][x]
+		VkDeviceMemory exchangeBufferDeviceMemory = VK_NULL_HANDLE;
+		VkDeviceSize bufferSize = 0;
+		VkFFTStagingPool stagingPool;
+		VkFFTApplication apps[2];//axes 0 and 1 of the z slab, axis 2 of the y slab. Both omit the other axes and keep the natural layout
+		VkCommandPool commandPool = VK_NULL_HANDLE;
+		VkCommandBuffer commandBuffers[2] = { VK_NULL_HANDLE, VK_NULL_HANDLE };
+		VkFence fence = VK_NULL_HANDLE;
+	} VkFFTSlabDevice;
+
+	//3D C2C FFT of a system that is split between several devices.
+	//Each device gets a z slab of size[0]*size[1]*size[2]/deviceCount complex numbers and transforms axes 0 and 1 of it with one plan.
+	//The slab is packed on the device in one block per device (its z planes, y block of the destination), the blocks go through host
+	//in deviceCount - 1 rounds of the all-to-all and form y slabs [z][y_local][x], which are transformed along axis 2 and written back
+	//to host rows in natural layout. Every device holds two slabs, host holds one slab worth of blocks in flight.
+	class VkFFTSlabApplication {
+	private:
+		VkFFTSlabConfiguration configuration = {};
+		std::vector<VkFFTSlabDevice> slabDevices;
+		std::vector<float> hostBlocks;//block sent by each device in the current round
+		uint64_t slabElements = 0;
+		uint64_t blockElements = 0;
+
+		//returns at the first failure and leaves the cleanup to deleteVulkanFFTSlab
+		VkResult createSlabDevice(uint32_t device_id) {
+			VkFFTSlabDevice* slabDevice = &slabDevices[device_id];
+			VkDevice device = configuration.devices[device_id];
+			uint32_t Nx = configuration.size[0];
+			uint32_t Ny = configuration.size[1];
+			uint32_t Nz = configuration.size[2];
+			uint32_t ny = Ny / configuration.deviceCount;
+			uint32_t nz = Nz / configuration.deviceCount;
+			VkResult res = VK_SUCCESS;
+			slabDevice->bufferSize = 2 * sizeof(float) * slabElements;
+			VkBufferCreateInfo bufferCreateInfo = { VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
+			bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+			bufferCreateInfo.queueFamilyIndexCount = 1;
+			bufferCreateInfo.pQueueFamilyIndices = &configuration.queueFamilyIndices[device_id];
+			bufferCreateInfo.size = slabDevice->bufferSize;
+			bufferCreateInfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+			res = VkFFTAllocateBuffer(configuration.physicalDevices[device_id], device, &bufferCreateInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &slabDevice->buffer, &slabDevice->bufferDeviceMemory);
+			if (res != VK_SUCCESS) return res;
+			bufferCreateInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+			res = VkFFTAllocateBuffer(configuration.physicalDevices[device_id], device, &bufferCreateInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &slabDevice->exchangeBuffer, &slabDevice->exchangeBufferDeviceMemory);
+			if (res != VK_SUCCESS) return res;
+
+			VkDeviceSize blockSize = 2 * sizeof(float) * blockElements;
+			VkFFTStagingPoolConfiguration stagingPoolConfiguration = {};
+			stagingPoolConfiguration.physicalDevice = &configuration.physicalDevices[device_id];
+			stagingPoolConfiguration.device = &configuration.devices[device_id];
+			stagingPoolConfiguration.queue = &configuration.queues[device_id];
+			stagingPoolConfiguration.queueFamilyIndex = configuration.queueFamilyIndices[device_id];
+			stagingPoolConfiguration.chunkSize = (configuration.stagingChunkSize < blockSize) ? configuration.stagingChunkSize : blockSize;
+			res = slabDevice->stagingPool.initializeStagingPool(stagingPoolConfiguration);
+			if (res != VK_SUCCESS) return res;
+
+			VkCommandPoolCreateInfo commandPoolCreateInfo = { VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO };
+			commandPoolCreateInfo.queueFamilyIndex = configuration.queueFamilyIndices[device_id];
+			res = vkCreateCommandPool(device, &commandPoolCreateInfo, NULL, &slabDevice->commandPool);
+			if (res != VK_SUCCESS) return res;
+			VkCommandBufferAllocateInfo commandBufferAllocateInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
+			commandBufferAllocateInfo.commandPool = slabDevice->commandPool;
+			commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+			commandBufferAllocateInfo.commandBufferCount = 2;
+			res = vkAllocateCommandBuffers(device, &commandBufferAllocateInfo, slabDevice->commandBuffers);
+			if (res != VK_SUCCESS) return res;
+			VkFenceCreateInfo fenceCreateInfo = { VK_STRUCTURE_TYPE_FENCE_CREATE_INFO };
+			res = vkCreateFence(device, &fenceCreateInfo, NULL, &slabDevice->fence);
+			if (res != VK_SUCCESS) return res;
+
+			//z slab [z_local][y][x] - axes 0 and 1, y slab [z][y_local][x] - axis 2
+			uint32_t localSizes[2][3] = { { Nx, Ny, nz }, { Nx, ny, Nz } };
+			for (uint32_t i = 0; i < 2; i++) {
+				VkFFTConfiguration axisConfiguration = {};
+				axisConfiguration.FFTdim = 3;
+				for (uint32_t j = 0; j < 3; j++) {
+					axisConfiguration.size[j] = localSizes[i][j];
+					axisConfiguration.omitDimension[j] = (i == 0) ? (j == 2) : (j < 2);
+				}
+				axisConfiguration.inverse = configuration.inverse;
+				strcpy(axisConfiguration.shaderPath, configuration.shaderPath);
+				axisConfiguration.physicalDevice = &configuration.physicalDevices[device_id];
+				axisConfiguration.device = &configuration.devices[device_id];
+				axisConfiguration.buffer = &slabDevice->buffer;
+				axisConfiguration.bufferSize = &slabDevice->bufferSize;
+				axisConfiguration.bufferDeviceMemory = &slabDevice->bufferDeviceMemory;
+				res = slabDevice->apps[i].initializeVulkanFFT(axisConfiguration);
+				if (res != VK_SUCCESS) return res;
+			}
+
+			//data arrives and leaves with transfers, command buffers are reused for every call
+			VkCommandBufferBeginInfo commandBufferBeginInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+			VkMemoryBarrier memory_barrier = { VK_STRUCTURE_TYPE_MEMORY_BARRIER, nullptr, VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT };
+			for (uint32_t i = 0; i < 2; i++) {
+				VkCommandBuffer commandBuffer = slabDevice->commandBuffers[i];
+				res = vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo);
+				if (res != VK_SUCCESS) return res;
+				memory_barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+				memory_barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+				vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
+				slabDevice->apps[i].VkFFTAppend(commandBuffer);
+				memory_barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+				memory_barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+				vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
+				if (i == 0) {
+					//[z_local][y][x] -> [destination][z_local][y_local][x], one row block per plane and destination
+					std::vector<VkBufferCopy> regions(configuration.deviceCount * nz);
+					for (uint32_t d = 0; d < configuration.deviceCount; d++) {
+						for (uint32_t z = 0; z < nz; z++) {
+							regions[d * nz + z].srcOffset = 2 * sizeof(float) * ((uint64_t)z * Ny + (uint64_t)d * ny) * Nx;
+							regions[d * nz + z].dstOffset = 2 * sizeof(float) * ((uint64_t)d * nz + z) * ny * Nx;
+							regions[d * nz + z].size = 2 * sizeof(float) * (uint64_t)ny * Nx;
+						}
+					}
+					vkCmdCopyBuffer(commandBuffer, slabDevice->buffer, slabDevice->exchangeBuffer, (uint32_t)regions.size(), regions.data());
+					//own block stays on the device, the other ones are written by the exchange
+					memory_barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+					memory_barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+					vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
+					VkBufferCopy ownBlock = {};
+					ownBlock.srcOffset = blockSize * device_id;
+					ownBlock.dstOffset = blockSize * device_id;
+					ownBlock.size = blockSize;
+					vkCmdCopyBuffer(commandBuffer, slabDevice->exchangeBuffer, slabDevice->buffer, 1, &ownBlock);
+					vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
+				}
+				res = vkEndCommandBuffer(commandBuffer);
+				if (res != VK_SUCCESS) return res;
+			}
+			return res;
+		}
+		VkResult runStage(uint32_t device_id, uint32_t stage) {
+			VkFFTSlabDevice* slabDevice = &slabDevices[device_id];
+			VkSubmitInfo submitInfo = { VK_STRUCTURE_TYPE_SUBMIT_INFO };
+			submitInfo.commandBufferCount = 1;
+			submitInfo.pCommandBuffers = &slabDevice->commandBuffers[stage];
+			VkResult res = vkQueueSubmit(configuration.queues[device_id], 1, &submitInfo, slabDevice->fence);
+			if (res != VK_SUCCESS) return res;
+			res = vkWaitForFences(configuration.devices[device_id], 1, &slabDevice->fence, VK_TRUE, UINT64_MAX);
+			if (res != VK_SUCCESS) return res;
+			return vkResetFences(configuration.devices[device_id], 1, &slabDevice->fence);
+		}
+		//z slab device_id of data is uploaded, transformed along axes 0 and 1 and packed in blocks
+		VkResult localAxes(uint32_t device_id, float* data) {
+			VkFFTSlabDevice* slabDevice = &slabDevices[device_id];
+			VkResult res = slabDevice->stagingPool.upload(data + 2 * device_id * slabElements, slabDevice->buffer, slabDevice->bufferSize);
+			if (res != VK_SUCCESS) return res;
+			return runStage(device_id, 0);
+		}
+		//round of the all-to-all: device device_id sends its block to device_id + round and receives the block of device_id - round
+		VkResult sendBlock(uint32_t device_id, uint32_t round) {
+			VkFFTSlabDevice* slabDevice = &slabDevices[device_id];
+			VkDeviceSize blockSize = 2 * sizeof(float) * blockElements;
+			uint32_t destination = (device_id + round) % configuration.deviceCount;
+			return slabDevice->stagingPool.download(hostBlocks.data() + 2 * device_id * blockElements, slabDevice->exchangeBuffer, blockSize, blockSize * destination);
+		}
+		VkResult receiveBlock(uint32_t device_id, uint32_t round) {
+			VkFFTSlabDevice* slabDevice = &slabDevices[device_id];
+			VkDeviceSize blockSize = 2 * sizeof(float) * blockElements;
+			uint32_t source = (device_id + configuration.deviceCount - round) % configuration.deviceCount;
+			return slabDevice->stagingPool.upload(hostBlocks.data() + 2 * source * blockElements, slabDevice->buffer, blockSize, blockSize * source);
+		}
+		//axis 2 of y slab device_id, its rows are written to data in natural layout
+		VkResult distributedAxis(uint32_t device_id, float* data) {
+			VkFFTSlabDevice* slabDevice = &slabDevices[device_id];
+			uint64_t Nx = configuration.size[0];
+			uint64_t Ny = configuration.size[1];
+			uint64_t ny = Ny / configuration.deviceCount;
+			VkResult res = runStage(device_id, 1);
+			if (res != VK_SUCCESS) return res;
+			for (uint64_t z = 0; z < configuration.size[2]; z++) {
+				res = slabDevice->stagingPool.download(data + 2 * (z * Ny + device_id * ny) * Nx, slabDevice->buffer, 2 * sizeof(float) * ny * Nx, 2 * sizeof(float) * z * ny * Nx);
+				if (res != VK_SUCCESS) return res;
+			}
+			return res;
+		}
+		//runs stage(device_id) on every device concurrently
+		template <typename Stage>
+		VkResult runDevices(Stage stage) {
+			std::vector<VkResult> results(configuration.deviceCount, VK_SUCCESS);
+			std::vector<std::thread> threads;
+			for (uint32_t i = 0; i < configuration.deviceCount; i++)
+				threads.push_back(std::thread([i, &stage, &results]() { results[i] = stage(i); }));
+			for (uint32_t i = 0; i < configuration.deviceCount; i++)
+				threads[i].join();
+			for (uint32_t i = 0; i < configuration.deviceCount; i++)
+				if (results[i] != VK_SUCCESS) return results[i];
+			return VK_SUCCESS;
+		}
+	public:
+		//returns VK_SUCCESS or the error that stopped initialization, everything created before it is released
+		VkResult initializeVulkanFFTSlab(VkFFTSlabConfiguration inputConfiguration) {
+			configuration = inputConfiguration;
+			if ((configuration.deviceCount == 0) || (configuration.size[1] % configuration.deviceCount) || (configuration.size[2] % configuration.deviceCount)) {
+				printf("VkFFT slab decomposition needs size[1] and size[2] divisible by the number of devices\n");
+				return VK_ERROR_INITIALIZATION_FAILED;
+			}
+			slabElements = (uint64_t)configuration.size[0] * configuration.size[1] * configuration.size[2] / configuration.deviceCount;
+			blockElements = slabElements / configuration.deviceCount;
+			hostBlocks.resize(2 * slabElements);
+			slabDevices.resize(configuration.deviceCount);
+			VkResult res = VK_SUCCESS;
+			for (uint32_t i = 0; (i < configuration.deviceCount) && (res == VK_SUCCESS); i++)
+				res = createSlabDevice(i);
+			//everything created before the failure is released, the application can be initialized again
+			if (res != VK_SUCCESS) deleteVulkanFFTSlab();
+			return res;
+		}
+		//In-place transform of a host system of size[0]*size[1]*size[2] interleaved complex numbers in natural layout. Devices work concurrently.
+		//Separable axes commute, so forward and inverse transforms take the same path.
+		VkResult performVulkanFFTSlab(float* data) {
+			VkResult res = runDevices([this, data](uint32_t i) { return localAxes(i, data); });
+			if (res != VK_SUCCESS) return res;
+			for (uint32_t round = 1; round < configuration.deviceCount; round++) {
+				res = runDevices([this, round](uint32_t i) { return sendBlock(i, round); });
+				if (res != VK_SUCCESS) return res;
+				res = runDevices([this, round](uint32_t i) { return receiveBlock(i, round); });
+				if (res != VK_SUCCESS) return res;
+			}
+			return runDevices([this, data](uint32_t i) { return distributedAxis(i, data); });
+		}
+		void deleteVulkanFFTSlab() {
+			for (uint32_t i = 0; i < slabDevices.size(); i++) {
+				VkDevice device = configuration.devices[i];
+				VkFFTSlabDevice* slabDevice = &slabDevices[i];
+				for (uint32_t j = 0; j < 2; j++)
+					slabDevice->apps[j].deleteVulkanFFT();
+				slabDevice->stagingPool.deleteStagingPool();
+				if (slabDevice->fence != VK_NULL_HANDLE) vkDestroyFence(device, slabDevice->fence, NULL);
+				if (slabDevice->commandPool != VK_NULL_HANDLE) vkDestroyCommandPool(device, slabDevice->commandPool, NULL);
+				VkFFTFreeBuffer(device, &slabDevice->buffer, &slabDevice->bufferDeviceMemory);
+				VkFFTFreeBuffer(device, &slabDevice->exchangeBuffer, &slabDevice->exchangeBufferDeviceMemory);
+			}
+			slabDevices.clear();
+			hostBlocks.clear();
+		}
+	};
+}
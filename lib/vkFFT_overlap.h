@@ -0,0 +1,615 @@
+#pragma once
+#include "vkFFT.h"
+#include "vkFFT_staging.h"
+
+namespace VkFFT
+{
+	typedef struct {
+		VkFFTConfiguration configuration;//device, physicalDevice and shaderPath are used, size[0] is the FFT size of a block (power of 2). Other fields are set by the convolver
+		uint32_t kernelLength = 0;//taps of the FIR filter, less than size[0]. Each block gives size[0]-kernelLength+1 output samples
+		uint32_t maxBlocks = 16;//blocks filtered in one batch (power of 2, at least 2), input of one push beyond that is done in several batches
+		bool overlapAdd = false;//overlap-add: blocks of new samples are zero padded and the filtered blocks are summed. Otherwise overlap-save: blocks overlap by kernelLength-1 input samples and the wrapped part is dropped
+		VkQueue* queue = 0;
+		uint32_t queueFamilyIndex = 0;
+	} VkFFTOverlapConfiguration;
+
+	typedef struct {
+		VkFFTConfiguration configuration;//device, physicalDevice and shaderPath are used, other fields are set by the convolver
+		uint32_t blockLength = 256;//audio block (power of 2): latency of the convolution, FFT size is 2*blockLength
+		uint32_t impulseLength = 0;//length of the impulse response, it is split into ceil(impulseLength/blockLength) partitions
+		VkBuffer* inputBuffer = 0;//blockLength floats of new input read by every appended block
+		VkBuffer* outputBuffer = 0;//blockLength floats of filtered output written by every appended block
+		VkQueue* queue = 0;//used once to transform the partitions
+		uint32_t queueFamilyIndex = 0;
+	} VkFFTPartitionedConfiguration;
+
+	typedef struct {
+		VkShaderModule shaderModule;
+		VkDescriptorSetLayout descriptorSetLayout;
+		VkDescriptorPool descriptorPool;
+		VkDescriptorSet descriptorSet;
+		VkPipelineLayout pipelineLayout;
+		VkPipeline pipeline;
+	} VkFFTHelperPipeline;
+
+	//compute pipeline of a helper shader with up to 4 storage buffers at bindings 0.. and pushConstantsSize bytes of push constants
+	inline VkResult VkFFTCreateHelperPipeline(VkDevice device, const char* shaderPath, const char* shaderName, uint32_t bufferCount, const VkBuffer* buffers, const VkDeviceSize* bufferSizes, uint32_t pushConstantsSize, VkFFTHelperPipeline* pipeline) {
+		if (bufferCount > 4) {
+			printf("VkFFT helper shader %s has %d buffers, at most 4 are supported\n", shaderName, bufferCount);
+			return VK_ERROR_INITIALIZATION_FAILED;
+		}
+		VkDescriptorPoolSize descriptorPoolSize = { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER };
+		descriptorPoolSize.descriptorCount = bufferCount;
+		VkDescriptorPoolCreateInfo descriptorPoolCreateInfo = { VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO };
+		descriptorPoolCreateInfo.poolSizeCount = 1;
+		descriptorPoolCreateInfo.pPoolSizes = &descriptorPoolSize;
+		descriptorPoolCreateInfo.maxSets = 1;
+		VkResult res = vkCreateDescriptorPool(device, &descriptorPoolCreateInfo, NULL, &pipeline->descriptorPool);
+		if (res != VK_SUCCESS) return res;
+		VkDescriptorSetLayoutBinding descriptorSetLayoutBindings[4] = {};
+		for (uint32_t i = 0; i < bufferCount; ++i) {
+			descriptorSetLayoutBindings[i].binding = i;
+			descriptorSetLayoutBindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+			descriptorSetLayoutBindings[i].descriptorCount = 1;
+			descriptorSetLayoutBindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+		}
+		VkDescriptorSetLayoutCreateInfo descriptorSetLayoutCreateInfo = { VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO };
+		descriptorSetLayoutCreateInfo.bindingCount = bufferCount;
+		descriptorSetLayoutCreateInfo.pBindings = descriptorSetLayoutBindings;
+		res = vkCreateDescriptorSetLayout(device, &descriptorSetLayoutCreateInfo, NULL, &pipeline->descriptorSetLayout);
+		if (res != VK_SUCCESS) return res;
+		VkDescriptorSetAllocateInfo descriptorSetAllocateInfo = { VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO };
+		descriptorSetAllocateInfo.descriptorPool = pipeline->descriptorPool;
+		descriptorSetAllocateInfo.descriptorSetCount = 1;
+		descriptorSetAllocateInfo.pSetLayouts = &pipeline->descriptorSetLayout;
+		res = vkAllocateDescriptorSets(device, &descriptorSetAllocateInfo, &pipeline->descriptorSet);
+		if (res != VK_SUCCESS) return res;
+		for (uint32_t i = 0; i < bufferCount; ++i) {
+			VkDescriptorBufferInfo descriptorBufferInfo = {};
+			descriptorBufferInfo.buffer = buffers[i];
+			descriptorBufferInfo.offset = 0;
+			descriptorBufferInfo.range = bufferSizes[i];
+			VkWriteDescriptorSet writeDescriptorSet = { VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET };
+			writeDescriptorSet.dstSet = pipeline->descriptorSet;
+			writeDescriptorSet.dstBinding = i;
+			writeDescriptorSet.dstArrayElement = 0;
+			writeDescriptorSet.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+			writeDescriptorSet.descriptorCount = 1;
+			writeDescriptorSet.pBufferInfo = &descriptorBufferInfo;
+			vkUpdateDescriptorSets(device, 1, &writeDescriptorSet, 0, NULL);
+		}
+
+		res = VkFFTCreateShaderModule(device, shaderPath, shaderName, &pipeline->shaderModule);
+		if (res != VK_SUCCESS) return res;
+
+		VkPushConstantRange pushConstantRange = { VK_SHADER_STAGE_COMPUTE_BIT };
+		pushConstantRange.offset = 0;
+		pushConstantRange.size = pushConstantsSize;
+		VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo = { VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO };
+		pipelineLayoutCreateInfo.setLayoutCount = 1;
+		pipelineLayoutCreateInfo.pSetLayouts = &pipeline->descriptorSetLayout;
+		pipelineLayoutCreateInfo.pushConstantRangeCount = 1;
+		pipelineLayoutCreateInfo.pPushConstantRanges = &pushConstantRange;
+		res = vkCreatePipelineLayout(device, &pipelineLayoutCreateInfo, NULL, &pipeline->pipelineLayout);
+		if (res != VK_SUCCESS) return res;
+		VkPipelineShaderStageCreateInfo pipelineShaderStageCreateInfo = { VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO };
+		pipelineShaderStageCreateInfo.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+		pipelineShaderStageCreateInfo.module = pipeline->shaderModule;
+		pipelineShaderStageCreateInfo.pName = "main";
+		VkComputePipelineCreateInfo computePipelineCreateInfo = { VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO };
+		computePipelineCreateInfo.stage = pipelineShaderStageCreateInfo;
+		computePipelineCreateInfo.layout = pipeline->pipelineLayout;
+		return vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &computePipelineCreateInfo, NULL, &pipeline->pipeline);
+	}
+	inline void VkFFTDeleteHelperPipeline(VkDevice device, VkFFTHelperPipeline* pipeline) {
+		if (pipeline->pipeline != VK_NULL_HANDLE) vkDestroyPipeline(device, pipeline->pipeline, NULL);
+		if (pipeline->pipelineLayout != VK_NULL_HANDLE) vkDestroyPipelineLayout(device, pipeline->pipelineLayout, NULL);
+		if (pipeline->shaderModule != VK_NULL_HANDLE) vkDestroyShaderModule(device, pipeline->shaderModule, NULL);
+		if (pipeline->descriptorSetLayout != VK_NULL_HANDLE) vkDestroyDescriptorSetLayout(device, pipeline->descriptorSetLayout, NULL);
+		if (pipeline->descriptorPool != VK_NULL_HANDLE) vkDestroyDescriptorPool(device, pipeline->descriptorPool, NULL);
+		*pipeline = {};
+	}
+	//Streaming convolution of an unbounded real 1D signal with a FIR filter. Kernel spectrum stays on the device, input blocks of any length are appended to a device-resident signal.
+	//Complete blocks are cut from it, transformed by a batched 1D R2C plan, multiplied by the kernel spectrum and transformed back. Block overlaps and the carried history (overlap-save) or tail (overlap-add) are handled by device copies and shaders, host only uploads new samples and reads filtered ones.
+	class VkFFTOverlapConvolution {
+	private:
+		VkFFTOverlapConfiguration configuration = {};
+		VkDevice device = VK_NULL_HANDLE;
+		uint32_t fftSize = 0;
+		uint32_t blockLength = 0;//new samples per block
+		uint32_t overlap = 0;//kernelLength-1
+		uint32_t historyLength = 0;//input samples kept before the pending ones: overlap for overlap-save, 0 for overlap-add
+		uint64_t pending = 0;//samples after the history that don't make a full block yet
+		uint32_t currentSignal = 0;
+		VkFFTApplication forwardApp;
+		VkFFTApplication inverseApp;
+		VkFFTHelperPipeline multiplyPipeline = {};
+		VkFFTHelperPipeline addPipeline = {};
+		//0 - blocks, 1 - kernel spectrum, 2 and 3 - signal ping-pong, 4 - output, 5 - overlap-add tail, 6 - upload, 7 - download
+		VkBuffer buffers[8] = {};
+		VkDeviceMemory bufferMemory[8] = {};
+		VkDeviceSize bufferSizes[8] = {};
+		void* uploadData = 0;
+		void* downloadData = 0;
+		VkCommandPool commandPool = VK_NULL_HANDLE;
+		VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+		VkFence fence = VK_NULL_HANDLE;
+
+		VkResult allocateBuffer(uint32_t id, VkBufferUsageFlags usageFlags, VkMemoryPropertyFlags propertyFlags, VkDeviceSize size) {
+			bufferSizes[id] = size;
+			VkBufferCreateInfo bufferCreateInfo = { VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
+			bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+			bufferCreateInfo.queueFamilyIndexCount = 1;
+			bufferCreateInfo.pQueueFamilyIndices = &configuration.queueFamilyIndex;
+			bufferCreateInfo.size = size;
+			bufferCreateInfo.usage = usageFlags;
+			return VkFFTAllocateBuffer(configuration.configuration.physicalDevice[0], device, &bufferCreateInfo, propertyFlags, &buffers[id], &bufferMemory[id]);
+		}
+		void barrier(VkPipelineStageFlags srcStage, VkAccessFlags srcAccess, VkPipelineStageFlags dstStage, VkAccessFlags dstAccess) {
+			VkMemoryBarrier memory_barrier = { VK_STRUCTURE_TYPE_MEMORY_BARRIER, nullptr, srcAccess, dstAccess };
+			vkCmdPipelineBarrier(commandBuffer, srcStage, dstStage, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
+		}
+		void copy(uint32_t srcId, uint64_t srcOffset, uint32_t dstId, uint64_t dstOffset, uint64_t count) {
+			VkBufferCopy copyRegion = {};
+			copyRegion.srcOffset = srcOffset * sizeof(float);
+			copyRegion.dstOffset = dstOffset * sizeof(float);
+			copyRegion.size = count * sizeof(float);
+			vkCmdCopyBuffer(commandBuffer, buffers[srcId], buffers[dstId], 1, &copyRegion);
+		}
+		VkFFTConfiguration blockConfiguration(uint32_t bufferId, bool inverse) {
+			VkFFTConfiguration conf = configuration.configuration;
+			conf.FFTdim = 1;
+			conf.size[0] = fftSize;
+			conf.size[1] = configuration.maxBlocks;
+			conf.size[2] = 1;
+			conf.performR2C = true;
+			conf.performConvolution = false;
+			conf.inverse = inverse;
+			conf.vectorDimension = 1;
+			conf.buffer = &buffers[bufferId];
+			conf.bufferSize = &bufferSizes[bufferId];
+			conf.bufferDeviceMemory = &bufferMemory[bufferId];
+			return conf;
+		}
+		VkResult submitAndWait() {
+			VkResult res = vkEndCommandBuffer(commandBuffer);
+			if (res != VK_SUCCESS) return res;
+			VkSubmitInfo submitInfo = { VK_STRUCTURE_TYPE_SUBMIT_INFO };
+			submitInfo.commandBufferCount = 1;
+			submitInfo.pCommandBuffers = &commandBuffer;
+			res = vkQueueSubmit(configuration.queue[0], 1, &submitInfo, fence);
+			if (res != VK_SUCCESS) return res;
+			res = vkWaitForFences(device, 1, &fence, VK_TRUE, UINT64_MAX);
+			if (res != VK_SUCCESS) return res;
+			return vkResetFences(device, 1, &fence);
+		}
+		VkResult beginCommandBuffer() {
+			VkResult res = vkResetCommandBuffer(commandBuffer, 0);
+			if (res != VK_SUCCESS) return res;
+			VkCommandBufferBeginInfo commandBufferBeginInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+			commandBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+			return vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo);
+		}
+		//one batch: count new samples (count <= free space of the signal buffer) are appended, complete blocks are filtered and their output is copied to output
+		VkResult processBatch(const float* input, uint64_t count, float* output, uint64_t* outputCount) {
+			uint64_t available = pending + count;
+			uint32_t blockCount = (uint32_t)(available / blockLength);
+			uint32_t signal = 2 + currentSignal;
+			memcpy(uploadData, input, count * sizeof(float));
+			VkResult res = beginCommandBuffer();
+			if (res != VK_SUCCESS) return res;
+			copy(6, 0, signal, historyLength + pending, count);
+			if (blockCount > 0) {
+				barrier(VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT);
+				//real rows of the r2c buffer are fftSize floats apart
+				if (configuration.overlapAdd) {
+					vkCmdFillBuffer(commandBuffer, buffers[0], 0, (VkDeviceSize)blockCount * fftSize * sizeof(float), 0);
+					barrier(VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT);
+					for (uint32_t b = 0; b < blockCount; b++)
+						copy(signal, (uint64_t)b * blockLength, 0, (uint64_t)b * fftSize, blockLength);
+				}
+				else {
+					for (uint32_t b = 0; b < blockCount; b++)
+						copy(signal, (uint64_t)b * blockLength, 0, (uint64_t)b * fftSize, fftSize);
+				}
+				barrier(VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+				forwardApp.VkFFTAppend(commandBuffer);
+				barrier(VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+				uint32_t spectrumSize = (fftSize / 2 + 1) * configuration.maxBlocks;
+				vkCmdPushConstants(commandBuffer, multiplyPipeline.pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(uint32_t), &spectrumSize);
+				vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, multiplyPipeline.pipeline);
+				vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, multiplyPipeline.pipelineLayout, 0, 1, &multiplyPipeline.descriptorSet, 0, NULL);
+				vkCmdDispatch(commandBuffer, (spectrumSize + 63) / 64, 1, 1);
+				barrier(VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+				inverseApp.VkFFTAppend(commandBuffer);
+				if (configuration.overlapAdd) {
+					barrier(VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+					uint32_t addConstants[4] = { fftSize, blockLength, blockCount, overlap };
+					uint32_t outputSize = blockCount * blockLength + overlap;
+					vkCmdPushConstants(commandBuffer, addPipeline.pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(addConstants), addConstants);
+					vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, addPipeline.pipeline);
+					vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, addPipeline.pipelineLayout, 0, 1, &addPipeline.descriptorSet, 0, NULL);
+					vkCmdDispatch(commandBuffer, (outputSize + 63) / 64, 1, 1);
+					barrier(VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT);
+					//samples past the last block are the tail added to the next call
+					if (overlap > 0) copy(4, (uint64_t)blockCount * blockLength, 5, 0, overlap);
+				}
+				else {
+					barrier(VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT);
+					//first overlap samples of a block are wrapped around by the circular convolution
+					for (uint32_t b = 0; b < blockCount; b++)
+						copy(0, (uint64_t)b * fftSize + overlap, 4, (uint64_t)b * blockLength, blockLength);
+				}
+				//history and pending samples move to the front of the other signal buffer
+				uint64_t rest = historyLength + available - (uint64_t)blockCount * blockLength;
+				if (rest > 0) copy(signal, (uint64_t)blockCount * blockLength, 2 + (1 - currentSignal), 0, rest);
+				currentSignal = 1 - currentSignal;
+				barrier(VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT);
+				copy(4, 0, 7, 0, (uint64_t)blockCount * blockLength);
+				barrier(VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_HOST_BIT, VK_ACCESS_HOST_READ_BIT);
+			}
+			res = submitAndWait();
+			if (res != VK_SUCCESS) return res;
+			pending = available - (uint64_t)blockCount * blockLength;
+			memcpy(output, downloadData, (uint64_t)blockCount * blockLength * sizeof(float));
+			outputCount[0] = (uint64_t)blockCount * blockLength;
+			return VK_SUCCESS;
+		}
+		//returns at the first failure and leaves the cleanup to deleteOverlapConvolution
+		VkResult createOverlapConvolution(const float* kernel) {
+			VkFFTConfiguration* conf = &configuration.configuration;
+			VkBufferUsageFlags usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+			VkDeviceSize batchSize = (VkDeviceSize)configuration.maxBlocks * blockLength * sizeof(float);
+			VkDeviceSize r2cSize = (VkDeviceSize)configuration.maxBlocks * (fftSize + 2) * sizeof(float);
+			VkDeviceSize sizes[8] = { r2cSize, r2cSize, batchSize + historyLength * sizeof(float), batchSize + historyLength * sizeof(float), batchSize + overlap * sizeof(float), (overlap + 1) * sizeof(float), batchSize, batchSize };
+			VkResult res = VK_SUCCESS;
+			for (uint32_t i = 0; i < 6; i++) {
+				res = allocateBuffer(i, usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, sizes[i]);
+				if (res != VK_SUCCESS) return res;
+			}
+			res = allocateBuffer(6, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, sizes[6]);
+			if (res != VK_SUCCESS) return res;
+			res = allocateBuffer(7, VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, sizes[7]);
+			if (res != VK_SUCCESS) return res;
+			res = vkMapMemory(device, bufferMemory[6], 0, sizes[6], 0, &uploadData);
+			if (res != VK_SUCCESS) return res;
+			res = vkMapMemory(device, bufferMemory[7], 0, sizes[7], 0, &downloadData);
+			if (res != VK_SUCCESS) return res;
+
+			VkCommandPoolCreateInfo commandPoolCreateInfo = { VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO };
+			commandPoolCreateInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+			commandPoolCreateInfo.queueFamilyIndex = configuration.queueFamilyIndex;
+			res = vkCreateCommandPool(device, &commandPoolCreateInfo, NULL, &commandPool);
+			if (res != VK_SUCCESS) return res;
+			VkCommandBufferAllocateInfo commandBufferAllocateInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
+			commandBufferAllocateInfo.commandPool = commandPool;
+			commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+			commandBufferAllocateInfo.commandBufferCount = 1;
+			res = vkAllocateCommandBuffers(device, &commandBufferAllocateInfo, &commandBuffer);
+			if (res != VK_SUCCESS) return res;
+			VkFenceCreateInfo fenceCreateInfo = { VK_STRUCTURE_TYPE_FENCE_CREATE_INFO };
+			res = vkCreateFence(device, &fenceCreateInfo, NULL, &fence);
+			if (res != VK_SUCCESS) return res;
+
+			//every block row of the kernel buffer holds the filter, so the kernel spectrum has the layout of the block spectra
+			std::vector<float> kernelRows(r2cSize / sizeof(float), 0);
+			for (uint32_t b = 0; b < configuration.maxBlocks; b++)
+				memcpy(&kernelRows[(uint64_t)b * fftSize], kernel, configuration.kernelLength * sizeof(float));
+			VkFFTStagingPoolConfiguration stagingPoolConfiguration = {};
+			stagingPoolConfiguration.physicalDevice = conf->physicalDevice;
+			stagingPoolConfiguration.device = conf->device;
+			stagingPoolConfiguration.queue = configuration.queue;
+			stagingPoolConfiguration.queueFamilyIndex = configuration.queueFamilyIndex;
+			stagingPoolConfiguration.chunkSize = 1 << 24;
+			VkFFTStagingPool stagingPool;
+			res = stagingPool.initializeStagingPool(stagingPoolConfiguration);
+			if (res != VK_SUCCESS) return res;
+			res = stagingPool.upload(kernelRows.data(), buffers[1], r2cSize);
+			stagingPool.deleteStagingPool();
+			if (res != VK_SUCCESS) return res;
+
+			VkFFTApplication kernelApp;
+			res = kernelApp.initializeVulkanFFT(blockConfiguration(1, false));
+			if (res != VK_SUCCESS) return res;
+			res = forwardApp.initializeVulkanFFT(blockConfiguration(0, false));
+			if (res == VK_SUCCESS) res = inverseApp.initializeVulkanFFT(blockConfiguration(0, true));
+			if (res != VK_SUCCESS) {
+				kernelApp.deleteVulkanFFT();
+				return res;
+			}
+			res = VkFFTCreateHelperPipeline(device, conf->shaderPath, "vkFFT_overlap_multiply.spv", 2, buffers, bufferSizes, sizeof(uint32_t), &multiplyPipeline);
+			if ((res == VK_SUCCESS) && (configuration.overlapAdd)) {
+				const VkBuffer addBuffers[3] = { buffers[0], buffers[5], buffers[4] };
+				const VkDeviceSize addBufferSizes[3] = { bufferSizes[0], bufferSizes[5], bufferSizes[4] };
+				res = VkFFTCreateHelperPipeline(device, conf->shaderPath, "vkFFT_overlap_add.spv", 3, addBuffers, addBufferSizes, 4 * sizeof(uint32_t), &addPipeline);
+			}
+			if (res != VK_SUCCESS) {
+				kernelApp.deleteVulkanFFT();
+				return res;
+			}
+			//kernel spectrum, zero history and tail
+			res = beginCommandBuffer();
+			if (res != VK_SUCCESS) {
+				kernelApp.deleteVulkanFFT();
+				return res;
+			}
+			vkCmdFillBuffer(commandBuffer, buffers[2], 0, VK_WHOLE_SIZE, 0);
+			vkCmdFillBuffer(commandBuffer, buffers[5], 0, VK_WHOLE_SIZE, 0);
+			barrier(VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+			kernelApp.VkFFTAppend(commandBuffer);
+			res = submitAndWait();
+			kernelApp.deleteVulkanFFT();
+			return res;
+		}
+	public:
+		//kernel holds kernelLength filter taps
+		VkResult initializeOverlapConvolution(VkFFTOverlapConfiguration inputConfiguration, const float* kernel) {
+			configuration = inputConfiguration;
+			VkFFTConfiguration* conf = &configuration.configuration;
+			fftSize = conf->size[0];
+			if ((conf->physicalDevice == 0) || (configuration.queue == 0)) {
+				printf("VkFFT overlap convolution requires physicalDevice and queue\n");
+				return VK_ERROR_INITIALIZATION_FAILED;
+			}
+			if ((fftSize < 2) || (fftSize & (fftSize - 1)) || (configuration.maxBlocks < 2) || (configuration.maxBlocks & (configuration.maxBlocks - 1))) {
+				printf("VkFFT overlap convolution needs power of 2 block size and maxBlocks, got %d and %d\n", fftSize, configuration.maxBlocks);
+				return VK_ERROR_INITIALIZATION_FAILED;
+			}
+			if ((configuration.kernelLength == 0) || (configuration.kernelLength >= fftSize)) {
+				printf("VkFFT overlap convolution kernel length %d has to be between 1 and block size %d\n", configuration.kernelLength, fftSize - 1);
+				return VK_ERROR_INITIALIZATION_FAILED;
+			}
+			device = conf->device[0];
+			overlap = configuration.kernelLength - 1;
+			blockLength = fftSize - overlap;
+			historyLength = (configuration.overlapAdd) ? 0 : overlap;
+			pending = 0;
+			currentSignal = 0;
+
+			//everything created before the failure is released, the convolver can be initialized again
+			VkResult res = createOverlapConvolution(kernel);
+			if (res != VK_SUCCESS) deleteOverlapConvolution();
+			return res;
+		}
+		//Appends count samples of the signal and writes the filtered samples of all blocks completed so far, output[i] is y[n+i] where n counts all samples returned before.
+		//Up to blockLength-1 samples wait for the next call, so output has to hold count+blockLength-1 floats. outputCount returns the number of samples written.
+		VkResult push(const float* input, uint64_t count, float* output, uint64_t* outputCount) {
+			outputCount[0] = 0;
+			uint64_t capacity = (uint64_t)configuration.maxBlocks * blockLength;
+			while (count > 0) {
+				uint64_t batchCount = (count < capacity - pending) ? count : capacity - pending;
+				uint64_t batchOutput = 0;
+				VkResult res = processBatch(input, batchCount, output + outputCount[0], &batchOutput);
+				if (res != VK_SUCCESS) return res;
+				input += batchCount;
+				count -= batchCount;
+				outputCount[0] += batchOutput;
+			}
+			return VK_SUCCESS;
+		}
+		//new samples per block, output is returned in multiples of it
+		uint32_t getBlockLength() {
+			return blockLength;
+		}
+		void deleteOverlapConvolution() {
+			if (device == VK_NULL_HANDLE) return;
+			forwardApp.deleteVulkanFFT();
+			inverseApp.deleteVulkanFFT();
+			VkFFTDeleteHelperPipeline(device, &multiplyPipeline);
+			VkFFTDeleteHelperPipeline(device, &addPipeline);
+			if (uploadData != 0) vkUnmapMemory(device, bufferMemory[6]);
+			if (downloadData != 0) vkUnmapMemory(device, bufferMemory[7]);
+			uploadData = 0;
+			downloadData = 0;
+			for (uint32_t i = 0; i < 8; i++)
+				VkFFTFreeBuffer(device, &buffers[i], &bufferMemory[i]);
+			if (fence != VK_NULL_HANDLE) vkDestroyFence(device, fence, NULL);
+			if (commandPool != VK_NULL_HANDLE) vkDestroyCommandPool(device, commandPool, NULL);
+			fence = VK_NULL_HANDLE;
+			commandPool = VK_NULL_HANDLE;
+			commandBuffer = VK_NULL_HANDLE;
+			device = VK_NULL_HANDLE;
+		}
+	};
+
+	//Uniformly partitioned overlap-save convolution for long impulse responses at the latency of one short block. Partitions of the impulse response are transformed once,
+	//spectra of the last ceil(impulseLength/blockLength) input frames are kept in a frequency-domain delay line on the device. Each block is one R2C and one C2R of size 2*blockLength
+	//around a single multiply-accumulate dispatch over all partitions. VkFFTAppend records a block into a user command buffer, the recording has no per-block state and can be resubmitted for every block.
+	class VkFFTPartitionedConvolution {
+	private:
+		VkFFTPartitionedConfiguration configuration = {};
+		VkDevice device = VK_NULL_HANDLE;
+		uint32_t partitionCount = 0;
+		uint32_t spectrumSize = 0;//complex numbers of the r2c buffer of one frame
+		VkFFTApplication forwardApp;
+		VkFFTApplication inverseApp;
+		VkFFTHelperPipeline macPipeline = {};
+		//0 - frame, 1 - partition spectra, 2 - delay line, 3 - head slot, 4 - last two input blocks
+		VkBuffer buffers[5] = {};
+		VkDeviceMemory bufferMemory[5] = {};
+		VkDeviceSize bufferSizes[5] = {};
+
+		VkResult allocateBuffer(uint32_t id, VkDeviceSize size) {
+			bufferSizes[id] = size;
+			VkBufferCreateInfo bufferCreateInfo = { VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
+			bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+			bufferCreateInfo.queueFamilyIndexCount = 1;
+			bufferCreateInfo.pQueueFamilyIndices = &configuration.queueFamilyIndex;
+			bufferCreateInfo.size = size;
+			bufferCreateInfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+			return VkFFTAllocateBuffer(configuration.configuration.physicalDevice[0], device, &bufferCreateInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &buffers[id], &bufferMemory[id]);
+		}
+		//frames are one real row of a two-row r2c system (r2c transforms rows in pairs), the second row stays zero. Partitions are batched along z
+		VkFFTConfiguration frameConfiguration(uint32_t bufferId, uint32_t batch, bool inverse) {
+			VkFFTConfiguration conf = configuration.configuration;
+			conf.FFTdim = 1;
+			conf.size[0] = 2 * configuration.blockLength;
+			conf.size[1] = 2;
+			conf.size[2] = batch;
+			conf.performR2C = true;
+			conf.performConvolution = false;
+			conf.inverse = inverse;
+			conf.vectorDimension = 1;
+			conf.buffer = &buffers[bufferId];
+			conf.bufferSize = &bufferSizes[bufferId];
+			conf.bufferDeviceMemory = &bufferMemory[bufferId];
+			return conf;
+		}
+		void barrier(VkCommandBuffer commandBuffer, VkPipelineStageFlags srcStage, VkAccessFlags srcAccess, VkPipelineStageFlags dstStage, VkAccessFlags dstAccess) {
+			VkMemoryBarrier memory_barrier = { VK_STRUCTURE_TYPE_MEMORY_BARRIER, nullptr, srcAccess, dstAccess };
+			vkCmdPipelineBarrier(commandBuffer, srcStage, dstStage, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
+		}
+		void copy(VkCommandBuffer commandBuffer, VkBuffer srcBuffer, uint64_t srcOffset, VkBuffer dstBuffer, uint64_t dstOffset, uint64_t count) {
+			VkBufferCopy copyRegion = {};
+			copyRegion.srcOffset = srcOffset * sizeof(float);
+			copyRegion.dstOffset = dstOffset * sizeof(float);
+			copyRegion.size = count * sizeof(float);
+			vkCmdCopyBuffer(commandBuffer, srcBuffer, dstBuffer, 1, &copyRegion);
+		}
+		//returns at the first failure and leaves the cleanup to deletePartitionedConvolution
+		VkResult createPartitionedConvolution(const float* impulseResponse) {
+			VkFFTConfiguration* conf = &configuration.configuration;
+			uint32_t blockLength = configuration.blockLength;
+			VkDeviceSize frameSize = (VkDeviceSize)spectrumSize * 2 * sizeof(float);
+			VkDeviceSize sizes[5] = { frameSize, frameSize * partitionCount, frameSize * partitionCount, sizeof(uint32_t), 2 * blockLength * sizeof(float) };
+			VkResult res = VK_SUCCESS;
+			for (uint32_t i = 0; i < 5; i++) {
+				res = allocateBuffer(i, sizes[i]);
+				if (res != VK_SUCCESS) return res;
+			}
+
+			//partition p: impulse response samples [p*blockLength, (p+1)*blockLength) zero padded to 2*blockLength in the first row of plane p
+			std::vector<float> partitions(frameSize * partitionCount / sizeof(float), 0);
+			for (uint32_t i = 0; i < configuration.impulseLength; i++)
+				partitions[(uint64_t)(i / blockLength) * spectrumSize * 2 + i % blockLength] = impulseResponse[i];
+			VkFFTStagingPoolConfiguration stagingPoolConfiguration = {};
+			stagingPoolConfiguration.physicalDevice = conf->physicalDevice;
+			stagingPoolConfiguration.device = conf->device;
+			stagingPoolConfiguration.queue = configuration.queue;
+			stagingPoolConfiguration.queueFamilyIndex = configuration.queueFamilyIndex;
+			stagingPoolConfiguration.chunkSize = 1 << 24;
+			VkFFTStagingPool stagingPool;
+			res = stagingPool.initializeStagingPool(stagingPoolConfiguration);
+			if (res != VK_SUCCESS) return res;
+			res = stagingPool.upload(partitions.data(), buffers[1], sizes[1]);
+			stagingPool.deleteStagingPool();
+			if (res != VK_SUCCESS) return res;
+
+			res = forwardApp.initializeVulkanFFT(frameConfiguration(0, 1, false));
+			if (res != VK_SUCCESS) return res;
+			res = inverseApp.initializeVulkanFFT(frameConfiguration(0, 1, true));
+			if (res != VK_SUCCESS) return res;
+			res = VkFFTCreateHelperPipeline(device, conf->shaderPath, "vkFFT_partitioned_mac.spv", 4, buffers, bufferSizes, 3 * sizeof(uint32_t), &macPipeline);
+			if (res != VK_SUCCESS) return res;
+
+			//partition spectra, empty delay line and input history
+			VkFFTApplication partitionApp;
+			res = partitionApp.initializeVulkanFFT(frameConfiguration(1, partitionCount, false));
+			if (res != VK_SUCCESS) return res;
+			VkCommandPool commandPool = VK_NULL_HANDLE;
+			VkCommandPoolCreateInfo commandPoolCreateInfo = { VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO };
+			commandPoolCreateInfo.queueFamilyIndex = configuration.queueFamilyIndex;
+			res = vkCreateCommandPool(device, &commandPoolCreateInfo, NULL, &commandPool);
+			if (res != VK_SUCCESS) {
+				partitionApp.deleteVulkanFFT();
+				return res;
+			}
+			VkCommandBufferAllocateInfo commandBufferAllocateInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
+			commandBufferAllocateInfo.commandPool = commandPool;
+			commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+			commandBufferAllocateInfo.commandBufferCount = 1;
+			VkCommandBuffer commandBuffer = {};
+			VkFence fence = VK_NULL_HANDLE;
+			VkFenceCreateInfo fenceCreateInfo = { VK_STRUCTURE_TYPE_FENCE_CREATE_INFO };
+			res = vkAllocateCommandBuffers(device, &commandBufferAllocateInfo, &commandBuffer);
+			if (res == VK_SUCCESS) res = vkCreateFence(device, &fenceCreateInfo, NULL, &fence);
+			VkCommandBufferBeginInfo commandBufferBeginInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+			commandBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+			if (res == VK_SUCCESS) res = vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo);
+			if (res == VK_SUCCESS) {
+				for (uint32_t i = 0; i < 5; i++) {
+					if (i != 1) vkCmdFillBuffer(commandBuffer, buffers[i], 0, VK_WHOLE_SIZE, 0);
+				}
+				barrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+				partitionApp.VkFFTAppend(commandBuffer);
+				res = vkEndCommandBuffer(commandBuffer);
+			}
+			if (res == VK_SUCCESS) {
+				VkSubmitInfo submitInfo = { VK_STRUCTURE_TYPE_SUBMIT_INFO };
+				submitInfo.commandBufferCount = 1;
+				submitInfo.pCommandBuffers = &commandBuffer;
+				res = vkQueueSubmit(configuration.queue[0], 1, &submitInfo, fence);
+			}
+			if (res == VK_SUCCESS) res = vkWaitForFences(device, 1, &fence, VK_TRUE, UINT64_MAX);
+			if (fence != VK_NULL_HANDLE) vkDestroyFence(device, fence, NULL);
+			vkDestroyCommandPool(device, commandPool, NULL);
+			partitionApp.deleteVulkanFFT();
+			return res;
+		}
+	public:
+		//impulseResponse holds impulseLength samples
+		VkResult initializePartitionedConvolution(VkFFTPartitionedConfiguration inputConfiguration, const float* impulseResponse) {
+			configuration = inputConfiguration;
+			VkFFTConfiguration* conf = &configuration.configuration;
+			uint32_t blockLength = configuration.blockLength;
+			if ((conf->physicalDevice == 0) || (configuration.queue == 0) || (configuration.inputBuffer == 0) || (configuration.outputBuffer == 0)) {
+				printf("VkFFT partitioned convolution requires physicalDevice, queue, inputBuffer and outputBuffer\n");
+				return VK_ERROR_INITIALIZATION_FAILED;
+			}
+			if ((blockLength < 2) || (blockLength & (blockLength - 1)) || (configuration.impulseLength == 0)) {
+				printf("VkFFT partitioned convolution needs power of 2 block length and non-empty impulse response, got %d and %d\n", blockLength, configuration.impulseLength);
+				return VK_ERROR_INITIALIZATION_FAILED;
+			}
+			device = conf->device[0];
+			partitionCount = (configuration.impulseLength + blockLength - 1) / blockLength;
+			spectrumSize = 2 * (blockLength + 1);
+			//everything created before the failure is released, the convolver can be initialized again
+			VkResult res = createPartitionedConvolution(impulseResponse);
+			if (res != VK_SUCCESS) deletePartitionedConvolution();
+			return res;
+		}
+		//Records filtering of one block: blockLength samples of inputBuffer in, filtered samples of the same block to outputBuffer, so latency is one block.
+		//Blocks have to be executed in order. Writes to inputBuffer before the block and reads of outputBuffer after it have to be synchronized by the user.
+		void VkFFTAppend(VkCommandBuffer commandBuffer) {
+			uint32_t blockLength = configuration.blockLength;
+			VkBuffer signal = buffers[4];
+			//previous block has finished with the frame, delay line and head slot
+			barrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT);
+			//frame is the previous input block followed by the new one
+			copy(commandBuffer, signal, blockLength, signal, 0, blockLength);
+			barrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT);
+			copy(commandBuffer, configuration.inputBuffer[0], 0, signal, blockLength, blockLength);
+			barrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT);
+			copy(commandBuffer, signal, 0, buffers[0], 0, 2 * blockLength);
+			vkCmdFillBuffer(commandBuffer, buffers[0], 2 * blockLength * sizeof(float), 2 * blockLength * sizeof(float), 0);
+			barrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+			forwardApp.VkFFTAppend(commandBuffer);
+			barrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+			uint32_t macConstants[3] = { spectrumSize, partitionCount, 0 };
+			vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, macPipeline.pipeline);
+			vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, macPipeline.pipelineLayout, 0, 1, &macPipeline.descriptorSet, 0, NULL);
+			vkCmdPushConstants(commandBuffer, macPipeline.pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(macConstants), macConstants);
+			vkCmdDispatch(commandBuffer, (spectrumSize + 63) / 64, 1, 1);
+			barrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+			macConstants[2] = 1;
+			vkCmdPushConstants(commandBuffer, macPipeline.pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(macConstants), macConstants);
+			vkCmdDispatch(commandBuffer, 1, 1, 1);
+			inverseApp.VkFFTAppend(commandBuffer);
+			barrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT);
+			//second half of the frame is free of circular wrap-around
+			copy(commandBuffer, buffers[0], blockLength, configuration.outputBuffer[0], 0, blockLength);
+		}
+		uint32_t getPartitionCount() {
+			return partitionCount;
+		}
+		void deletePartitionedConvolution() {
+			if (device == VK_NULL_HANDLE) return;
+			forwardApp.deleteVulkanFFT();
+			inverseApp.deleteVulkanFFT();
+			VkFFTDeleteHelperPipeline(device, &macPipeline);
+			for (uint32_t i = 0; i < 5; i++)
+				VkFFTFreeBuffer(device, &buffers[i], &bufferMemory[i]);
+			device = VK_NULL_HANDLE;
+		}
+	};
+}
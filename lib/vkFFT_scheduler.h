@@ -0,0 +1,198 @@
+#pragma once
+#include "vkFFT.h"
+
+namespace VkFFT
+{
+	typedef struct {
+		VkDevice* device;
+		VkQueue* queues;//queues of one family, created with queueCount > 1 in VkDeviceQueueCreateInfo
+		uint32_t queueCount = 1;
+		uint32_t queueFamilyIndex = 0;
+	} VkFFTSchedulerConfiguration;
+
+	//Runs independent VkFFTApplications concurrently. VkFFTAppend separates every stage with a global barrier, so plans recorded into one
+	//command buffer run one after another. The scheduler distributes plans between several compute queues of the same family, each queue
+	//gets its own command buffer and plans on different queues overlap on the device. Plans must not share buffers.
+	class VkFFTScheduler {
+	private:
+		VkFFTSchedulerConfiguration configuration = {};
+		std::vector<VkQueue> queues;
+		VkCommandPool commandPool = VK_NULL_HANDLE;
+		std::vector<VkCommandBuffer> commandBuffers;
+		std::vector<VkFence> fences;
+		std::vector<VkSemaphore> startSemaphores;//signaled once per submit with a wait semaphore, one for each queue with plans
+		std::vector<VkFFTApplication*> applications;
+		std::vector<uint32_t> applicationQueue;
+		std::vector<uint64_t> queueCost;
+		std::vector<bool> queueSubmitted;//fence of the queue is pending, plans added after a submit don't make wait() block on queues that were not submitted
+		bool recorded = false;
+		//returns at the first failure and leaves the cleanup to deleteScheduler
+		VkResult createScheduler() {
+			VkResult res = VK_SUCCESS;
+			VkCommandPoolCreateInfo commandPoolCreateInfo = { VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO };
+			commandPoolCreateInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+			commandPoolCreateInfo.queueFamilyIndex = configuration.queueFamilyIndex;
+			res = vkCreateCommandPool(configuration.device[0], &commandPoolCreateInfo, NULL, &commandPool);
+			if (res != VK_SUCCESS) {
+				commandPool = VK_NULL_HANDLE;
+				return res;
+			}
+			commandBuffers.resize(configuration.queueCount);
+			VkCommandBufferAllocateInfo commandBufferAllocateInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
+			commandBufferAllocateInfo.commandPool = commandPool;
+			commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+			commandBufferAllocateInfo.commandBufferCount = configuration.queueCount;
+			res = vkAllocateCommandBuffers(configuration.device[0], &commandBufferAllocateInfo, commandBuffers.data());
+			if (res != VK_SUCCESS) return res;
+			fences.assign(configuration.queueCount, VK_NULL_HANDLE);
+			startSemaphores.assign(configuration.queueCount, VK_NULL_HANDLE);
+			for (uint32_t i = 0; i < configuration.queueCount; i++) {
+				VkFenceCreateInfo fenceCreateInfo = { VK_STRUCTURE_TYPE_FENCE_CREATE_INFO };
+				res = vkCreateFence(configuration.device[0], &fenceCreateInfo, NULL, &fences[i]);
+				if (res != VK_SUCCESS) {
+					fences[i] = VK_NULL_HANDLE;
+					return res;
+				}
+				VkSemaphoreCreateInfo semaphoreCreateInfo = { VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO };
+				res = vkCreateSemaphore(configuration.device[0], &semaphoreCreateInfo, NULL, &startSemaphores[i]);
+				if (res != VK_SUCCESS) {
+					startSemaphores[i] = VK_NULL_HANDLE;
+					return res;
+				}
+			}
+			return res;
+		}
+	public:
+		VkResult initializeScheduler(VkFFTSchedulerConfiguration inputConfiguration) {
+			configuration = inputConfiguration;
+			if (configuration.queueCount == 0) configuration.queueCount = 1;
+			queues.assign(configuration.queues, configuration.queues + configuration.queueCount);
+			queueCost.assign(configuration.queueCount, 0);
+			queueSubmitted.assign(configuration.queueCount, false);
+			VkResult res = createScheduler();
+			//everything created before the failure is released, the scheduler can be initialized again
+			if (res != VK_SUCCESS) deleteScheduler();
+			return res;
+		}
+		//Adds an initialized application. cost is a relative estimate of its work (for example buffer size), the plan goes to the least loaded queue.
+		//Returns the queue index the plan was assigned to.
+		uint32_t addApplication(VkFFTApplication* app, uint64_t cost = 1) {
+			if (cost == 0) cost = 1;
+			uint32_t queue_id = 0;
+			for (uint32_t i = 1; i < configuration.queueCount; i++) {
+				if (queueCost[i] < queueCost[queue_id]) queue_id = i;
+			}
+			queueCost[queue_id] += cost;
+			applications.push_back(app);
+			applicationQueue.push_back(queue_id);
+			recorded = false;
+			return queue_id;
+		}
+		//Records one command buffer per queue. Called by submit if plans were added since the last recording.
+		VkResult record() {
+			VkResult res = wait();
+			if (res != VK_SUCCESS) return res;
+			for (uint32_t q = 0; q < configuration.queueCount; q++) {
+				vkResetCommandBuffer(commandBuffers[q], 0);
+				VkCommandBufferBeginInfo commandBufferBeginInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+				res = vkBeginCommandBuffer(commandBuffers[q], &commandBufferBeginInfo);
+				if (res != VK_SUCCESS) return res;
+				for (uint32_t i = 0; i < applications.size(); i++) {
+					if (applicationQueue[i] == q)
+						applications[i]->VkFFTAppend(commandBuffers[q]);
+				}
+				res = vkEndCommandBuffer(commandBuffers[q]);
+				if (res != VK_SUCCESS) return res;
+			}
+			recorded = true;
+			return res;
+		}
+		//Submits all queues without waiting. waitSemaphore (optional) is waited once, by an empty submit on the first queue with plans, which signals a start semaphore
+		//for every queue with plans - a binary semaphore can't be waited by several submits. signalSemaphores (optional, queueCount entries) are signaled by queues that have plans.
+		VkResult submit(VkSemaphore waitSemaphore = VK_NULL_HANDLE, VkSemaphore* signalSemaphores = 0) {
+			VkResult res = VK_SUCCESS;
+			if (!recorded) {
+				res = record();
+				if (res != VK_SUCCESS) return res;
+			}
+			res = wait();
+			if (res != VK_SUCCESS) return res;
+			VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+			if (waitSemaphore != VK_NULL_HANDLE) {
+				std::vector<VkSemaphore> activeStartSemaphores;
+				uint32_t firstQueue = configuration.queueCount;
+				for (uint32_t q = 0; q < configuration.queueCount; q++) {
+					if (queueCost[q] == 0) continue;
+					if (firstQueue == configuration.queueCount) firstQueue = q;
+					activeStartSemaphores.push_back(startSemaphores[q]);
+				}
+				if (firstQueue == configuration.queueCount) return res;
+				VkPipelineStageFlags allStages = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+				VkSubmitInfo submitInfo = { VK_STRUCTURE_TYPE_SUBMIT_INFO };
+				submitInfo.waitSemaphoreCount = 1;
+				submitInfo.pWaitSemaphores = &waitSemaphore;
+				submitInfo.pWaitDstStageMask = &allStages;
+				submitInfo.signalSemaphoreCount = (uint32_t)activeStartSemaphores.size();
+				submitInfo.pSignalSemaphores = activeStartSemaphores.data();
+				res = vkQueueSubmit(queues[firstQueue], 1, &submitInfo, VK_NULL_HANDLE);
+				if (res != VK_SUCCESS) return res;
+			}
+			for (uint32_t q = 0; q < configuration.queueCount; q++) {
+				if (queueCost[q] == 0) continue;
+				VkSubmitInfo submitInfo = { VK_STRUCTURE_TYPE_SUBMIT_INFO };
+				if (waitSemaphore != VK_NULL_HANDLE) {
+					submitInfo.waitSemaphoreCount = 1;
+					submitInfo.pWaitSemaphores = &startSemaphores[q];
+					submitInfo.pWaitDstStageMask = &waitStage;
+				}
+				if (signalSemaphores) {
+					submitInfo.signalSemaphoreCount = 1;
+					submitInfo.pSignalSemaphores = &signalSemaphores[q];
+				}
+				submitInfo.commandBufferCount = 1;
+				submitInfo.pCommandBuffers = &commandBuffers[q];
+				res = vkQueueSubmit(queues[q], 1, &submitInfo, fences[q]);
+				if (res != VK_SUCCESS) return res;
+				queueSubmitted[q] = true;
+			}
+			return res;
+		}
+		//Waits for the queues of the last submit. Only fences of queues that were submitted are waited, so a submit that failed part way doesn't block.
+		VkResult wait() {
+			VkResult res = VK_SUCCESS;
+			for (uint32_t q = 0; q < queueSubmitted.size(); q++) {
+				if (!queueSubmitted[q]) continue;
+				res = vkWaitForFences(configuration.device[0], 1, &fences[q], VK_TRUE, UINT64_MAX);
+				if (res != VK_SUCCESS) return res;
+				res = vkResetFences(configuration.device[0], 1, &fences[q]);
+				if (res != VK_SUCCESS) return res;
+				queueSubmitted[q] = false;
+			}
+			return res;
+		}
+		VkResult execute() {
+			VkResult res = submit();
+			if (res != VK_SUCCESS) return res;
+			return wait();
+		}
+		//also releases what a failed initializeScheduler created
+		void deleteScheduler() {
+			if (commandPool == VK_NULL_HANDLE) return;
+			wait();
+			for (uint32_t i = 0; i < fences.size(); i++)
+				if (fences[i] != VK_NULL_HANDLE) vkDestroyFence(configuration.device[0], fences[i], NULL);
+			fences.clear();
+			for (uint32_t i = 0; i < startSemaphores.size(); i++)
+				if (startSemaphores[i] != VK_NULL_HANDLE) vkDestroySemaphore(configuration.device[0], startSemaphores[i], NULL);
+			startSemaphores.clear();
+			vkDestroyCommandPool(configuration.device[0], commandPool, NULL);
+			commandPool = VK_NULL_HANDLE;
+			commandBuffers.clear();
+			applications.clear();
+			applicationQueue.clear();
+			queueCost.assign(configuration.queueCount, 0);
+			queueSubmitted.assign(configuration.queueCount, false);
+			recorded = false;
+		}
+	};
+}
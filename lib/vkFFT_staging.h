@@ -0,0 +1,179 @@
+#pragma once
+#include "vkFFT.h"
+
+namespace VkFFT
+{
+	typedef struct {
+		VkPhysicalDevice* physicalDevice;
+		VkDevice* device;
+		VkQueue* queue;//queue used for staging copies
+		uint32_t queueFamilyIndex = 0;
+		VkDeviceSize chunkSize = 1 << 26;//bytes per copy, host-visible memory of the pool is chunkSize*numChunks
+		uint32_t numChunks = 2;//while one chunk is copied on GPU, host fills or reads the next one
+	} VkFFTStagingPoolConfiguration;
+
+	//Transfers buffers of any size between host and device through a fixed-size, persistently mapped ring of host-visible chunks.
+	//Memory, command buffers and fences are created once in initializeStagingPool and reused by every transfer.
+	class VkFFTStagingPool {
+	private:
+		VkFFTStagingPoolConfiguration configuration = {};
+		VkDevice device = VK_NULL_HANDLE;
+		VkBuffer stagingBuffer = VK_NULL_HANDLE;
+		VkDeviceMemory stagingBufferMemory = VK_NULL_HANDLE;
+		char* stagingData = 0;
+		VkCommandPool commandPool = VK_NULL_HANDLE;
+		std::vector<VkCommandBuffer> commandBuffers;
+		std::vector<VkFence> fences;
+		std::vector<bool> chunkInUse;
+
+		VkResult waitChunk(uint32_t chunk) {
+			if (!chunkInUse[chunk]) return VK_SUCCESS;
+			VkResult res = vkWaitForFences(device, 1, &fences[chunk], VK_TRUE, UINT64_MAX);
+			if (res != VK_SUCCESS) return res;
+			chunkInUse[chunk] = false;
+			return vkResetFences(device, 1, &fences[chunk]);
+		}
+		VkResult submitChunk(uint32_t chunk, VkBuffer srcBuffer, VkDeviceSize srcOffset, VkBuffer dstBuffer, VkDeviceSize dstOffset, VkDeviceSize size, bool hostRead) {
+			VkCommandBuffer commandBuffer = commandBuffers[chunk];
+			vkResetCommandBuffer(commandBuffer, 0);
+			VkCommandBufferBeginInfo commandBufferBeginInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+			commandBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+			vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo);
+			VkBufferCopy copyRegion = {};
+			copyRegion.srcOffset = srcOffset;
+			copyRegion.dstOffset = dstOffset;
+			copyRegion.size = size;
+			vkCmdCopyBuffer(commandBuffer, srcBuffer, dstBuffer, 1, &copyRegion);
+			if (hostRead) {
+				VkMemoryBarrier memory_barrier = { VK_STRUCTURE_TYPE_MEMORY_BARRIER, nullptr, VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_HOST_READ_BIT };
+				vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
+			}
+			vkEndCommandBuffer(commandBuffer);
+			VkSubmitInfo submitInfo = { VK_STRUCTURE_TYPE_SUBMIT_INFO };
+			submitInfo.commandBufferCount = 1;
+			submitInfo.pCommandBuffers = &commandBuffer;
+			VkResult res = vkQueueSubmit(configuration.queue[0], 1, &submitInfo, fences[chunk]);
+			if (res == VK_SUCCESS) chunkInUse[chunk] = true;
+			return res;
+		}
+		//returns at the first failure and leaves the cleanup to deleteStagingPool
+		VkResult createStagingPool() {
+			VkResult res = VK_SUCCESS;
+			VkBufferCreateInfo bufferCreateInfo = { VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
+			bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+			bufferCreateInfo.queueFamilyIndexCount = 1;
+			bufferCreateInfo.pQueueFamilyIndices = &configuration.queueFamilyIndex;
+			bufferCreateInfo.size = configuration.chunkSize * configuration.numChunks;
+			bufferCreateInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+			res = VkFFTAllocateBuffer(configuration.physicalDevice[0], device, &bufferCreateInfo, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, &stagingBuffer, &stagingBufferMemory);
+			if (res != VK_SUCCESS) return res;
+			res = vkMapMemory(device, stagingBufferMemory, 0, bufferCreateInfo.size, 0, (void**)&stagingData);
+			if (res != VK_SUCCESS) {
+				stagingData = 0;
+				return res;
+			}
+
+			VkCommandPoolCreateInfo commandPoolCreateInfo = { VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO };
+			commandPoolCreateInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT | VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+			commandPoolCreateInfo.queueFamilyIndex = configuration.queueFamilyIndex;
+			res = vkCreateCommandPool(device, &commandPoolCreateInfo, NULL, &commandPool);
+			if (res != VK_SUCCESS) return res;
+			commandBuffers.resize(configuration.numChunks);
+			VkCommandBufferAllocateInfo commandBufferAllocateInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
+			commandBufferAllocateInfo.commandPool = commandPool;
+			commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+			commandBufferAllocateInfo.commandBufferCount = configuration.numChunks;
+			res = vkAllocateCommandBuffers(device, &commandBufferAllocateInfo, commandBuffers.data());
+			if (res != VK_SUCCESS) return res;
+			fences.assign(configuration.numChunks, VK_NULL_HANDLE);
+			chunkInUse.assign(configuration.numChunks, false);
+			for (uint32_t i = 0; i < configuration.numChunks; i++) {
+				VkFenceCreateInfo fenceCreateInfo = { VK_STRUCTURE_TYPE_FENCE_CREATE_INFO };
+				res = vkCreateFence(device, &fenceCreateInfo, NULL, &fences[i]);
+				if (res != VK_SUCCESS) {
+					fences[i] = VK_NULL_HANDLE;
+					return res;
+				}
+			}
+			return res;
+		}
+	public:
+		VkResult initializeStagingPool(VkFFTStagingPoolConfiguration inputConfiguration) {
+			configuration = inputConfiguration;
+			if (configuration.numChunks == 0) configuration.numChunks = 1;
+			if ((configuration.physicalDevice == 0) || (configuration.device == 0) || (configuration.queue == 0) || (configuration.chunkSize == 0)) {
+				printf("VkFFT staging pool requires physicalDevice, device, queue and a non-zero chunkSize\n");
+				return VK_ERROR_INITIALIZATION_FAILED;
+			}
+			device = configuration.device[0];
+			VkResult res = createStagingPool();
+			//everything created before the failure is released, the pool can be initialized again
+			if (res != VK_SUCCESS) deleteStagingPool();
+			return res;
+		}
+		//Copies size bytes from host memory to buffer at dstOffset. Returns when the data is on the device.
+		VkResult upload(const void* src, VkBuffer dstBuffer, VkDeviceSize size, VkDeviceSize dstOffset = 0) {
+			VkResult res = VK_SUCCESS;
+			uint32_t chunk = 0;
+			for (VkDeviceSize offset = 0; offset < size; offset += configuration.chunkSize) {
+				VkDeviceSize copySize = (size - offset < configuration.chunkSize) ? size - offset : configuration.chunkSize;
+				res = waitChunk(chunk);
+				if (res != VK_SUCCESS) return res;
+				memcpy(stagingData + chunk * configuration.chunkSize, (const char*)src + offset, copySize);
+				res = submitChunk(chunk, stagingBuffer, chunk * configuration.chunkSize, dstBuffer, dstOffset + offset, copySize, false);
+				if (res != VK_SUCCESS) return res;
+				chunk = (chunk + 1) % configuration.numChunks;
+			}
+			for (uint32_t i = 0; i < configuration.numChunks; i++) {
+				res = waitChunk(i);
+				if (res != VK_SUCCESS) return res;
+			}
+			return res;
+		}
+		//Copies size bytes from buffer at srcOffset to host memory.
+		VkResult download(void* dst, VkBuffer srcBuffer, VkDeviceSize size, VkDeviceSize srcOffset = 0) {
+			VkResult res = VK_SUCCESS;
+			uint64_t numCopies = (size + configuration.chunkSize - 1) / configuration.chunkSize;
+			//keep all chunks busy: copy i is read back on host after copy i+numChunks-1 was submitted
+			for (uint64_t i = 0; i < numCopies + configuration.numChunks - 1; i++) {
+				if (i < numCopies) {
+					uint32_t chunk = i % configuration.numChunks;
+					VkDeviceSize offset = i * configuration.chunkSize;
+					VkDeviceSize copySize = (size - offset < configuration.chunkSize) ? size - offset : configuration.chunkSize;
+					res = submitChunk(chunk, srcBuffer, srcOffset + offset, stagingBuffer, chunk * configuration.chunkSize, copySize, true);
+					if (res != VK_SUCCESS) return res;
+				}
+				if (i + 1 >= configuration.numChunks) {
+					uint64_t readCopy = i + 1 - configuration.numChunks;
+					if (readCopy >= numCopies) continue;
+					uint32_t chunk = readCopy % configuration.numChunks;
+					VkDeviceSize offset = readCopy * configuration.chunkSize;
+					VkDeviceSize copySize = (size - offset < configuration.chunkSize) ? size - offset : configuration.chunkSize;
+					res = waitChunk(chunk);
+					if (res != VK_SUCCESS) return res;
+					memcpy((char*)dst + offset, stagingData + chunk * configuration.chunkSize, copySize);
+				}
+			}
+			return res;
+		}
+		//also releases what a failed initializeStagingPool created
+		void deleteStagingPool() {
+			if (device == VK_NULL_HANDLE) return;
+			for (uint32_t i = 0; i < fences.size(); i++) {
+				if (fences[i] == VK_NULL_HANDLE) continue;
+				waitChunk(i);
+				vkDestroyFence(device, fences[i], NULL);
+			}
+			fences.clear();
+			chunkInUse.clear();
+			//command buffers are freed with the pool
+			if (commandPool != VK_NULL_HANDLE) vkDestroyCommandPool(device, commandPool, NULL);
+			commandPool = VK_NULL_HANDLE;
+			commandBuffers.clear();
+			if (stagingData) vkUnmapMemory(device, stagingBufferMemory);
+			stagingData = 0;
+			VkFFTFreeBuffer(device, &stagingBuffer, &stagingBufferMemory);
+			device = VK_NULL_HANDLE;
+		}
+	};
+}
@@ -0,0 +1,241 @@
+#pragma once
+#include "vkFFT.h"
+
+namespace VkFFT
+{
+	typedef struct {
+		VkFFTConfiguration configuration;//plan template, buffer fields are filled by the stream for each slot
+		VkDeviceSize bufferSize = 0;//size of one batch in bytes, as passed to configuration.bufferSize
+		uint32_t numSlots = 3;//batches in flight: upload of N+1, FFT of N and download of N-1 overlap with 3 slots
+		VkQueue* computeQueue = 0;
+		uint32_t computeQueueFamilyIndex = 0;
+		VkQueue* transferQueue = 0;//optional dedicated transfer queue, compute queue is used if not set
+		uint32_t transferQueueFamilyIndex = 0;
+	} VkFFTStreamConfiguration;
+
+	typedef struct {
+		VkBuffer buffer = VK_NULL_HANDLE;
+		VkDeviceMemory bufferDeviceMemory = VK_NULL_HANDLE;
+		VkBuffer uploadBuffer = VK_NULL_HANDLE;
+		VkDeviceMemory uploadBufferMemory = VK_NULL_HANDLE;
+		void* uploadData = 0;
+		VkBuffer downloadBuffer = VK_NULL_HANDLE;
+		VkDeviceMemory downloadBufferMemory = VK_NULL_HANDLE;
+		void* downloadData = 0;
+		VkCommandBuffer uploadCommandBuffer = VK_NULL_HANDLE;
+		VkCommandBuffer computeCommandBuffer = VK_NULL_HANDLE;
+		VkCommandBuffer downloadCommandBuffer = VK_NULL_HANDLE;
+		VkFFTApplication app;
+	} VkFFTStreamSlot;
+
+	//Streams batches through a ring of device buffers with persistently mapped staging buffers. Each batch is uploaded, transformed with VkFFTAppend and downloaded on its own slot.
+	//Stages are ordered with three timeline semaphores (upload, compute, download) counting finished batches, so different batches overlap on the device.
+	//Requires Vulkan 1.2 or VK_KHR_timeline_semaphore with timelineSemaphore feature enabled on the device.
+	class VkFFTStream {
+	private:
+		VkFFTStreamConfiguration configuration = {};
+		VkDevice device = VK_NULL_HANDLE;
+		std::vector<VkFFTStreamSlot> slots;
+		VkCommandPool computeCommandPool = VK_NULL_HANDLE;
+		VkCommandPool transferCommandPool = VK_NULL_HANDLE;
+		VkSemaphore uploadSemaphore = VK_NULL_HANDLE;
+		VkSemaphore computeSemaphore = VK_NULL_HANDLE;
+		VkSemaphore downloadSemaphore = VK_NULL_HANDLE;
+		uint64_t pushed = 0;//batches submitted
+		uint64_t popped = 0;//batches returned to the user
+
+		VkResult allocateBuffer(VkBuffer* buffer, VkDeviceMemory* deviceMemory, VkBufferUsageFlags usageFlags, VkMemoryPropertyFlags propertyFlags, VkDeviceSize size) {
+			uint32_t queueFamilyIndices[2] = { configuration.computeQueueFamilyIndex, configuration.transferQueueFamilyIndex };
+			VkBufferCreateInfo bufferCreateInfo = { VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
+			//buffers are shared between compute and transfer queue families without ownership transfers
+			bufferCreateInfo.sharingMode = (queueFamilyIndices[0] != queueFamilyIndices[1]) ? VK_SHARING_MODE_CONCURRENT : VK_SHARING_MODE_EXCLUSIVE;
+			bufferCreateInfo.queueFamilyIndexCount = (queueFamilyIndices[0] != queueFamilyIndices[1]) ? 2 : 1;
+			bufferCreateInfo.pQueueFamilyIndices = queueFamilyIndices;
+			bufferCreateInfo.size = size;
+			bufferCreateInfo.usage = usageFlags;
+			return VkFFTAllocateBuffer(configuration.configuration.physicalDevice[0], device, &bufferCreateInfo, propertyFlags, buffer, deviceMemory);
+		}
+		VkResult createTimelineSemaphore(VkSemaphore* semaphore) {
+			VkSemaphoreTypeCreateInfo semaphoreTypeCreateInfo = { VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO };
+			semaphoreTypeCreateInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+			semaphoreTypeCreateInfo.initialValue = 0;
+			VkSemaphoreCreateInfo semaphoreCreateInfo = { VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO };
+			semaphoreCreateInfo.pNext = &semaphoreTypeCreateInfo;
+			return vkCreateSemaphore(device, &semaphoreCreateInfo, NULL, semaphore);
+		}
+		void recordCopy(VkCommandBuffer commandBuffer, VkBuffer srcBuffer, VkBuffer dstBuffer, bool hostRead) {
+			VkCommandBufferBeginInfo commandBufferBeginInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+			vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo);
+			VkBufferCopy copyRegion = {};
+			copyRegion.size = configuration.bufferSize;
+			vkCmdCopyBuffer(commandBuffer, srcBuffer, dstBuffer, 1, &copyRegion);
+			if (hostRead) {
+				VkMemoryBarrier memory_barrier = { VK_STRUCTURE_TYPE_MEMORY_BARRIER, nullptr, VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_HOST_READ_BIT };
+				vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
+			}
+			vkEndCommandBuffer(commandBuffer);
+		}
+		VkResult submit(VkQueue queue, VkCommandBuffer commandBuffer, VkSemaphore waitSemaphore, uint64_t waitValue, VkPipelineStageFlags waitStage, VkSemaphore signalSemaphore, uint64_t signalValue) {
+			VkTimelineSemaphoreSubmitInfo timelineSubmitInfo = { VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO };
+			timelineSubmitInfo.waitSemaphoreValueCount = (waitValue > 0) ? 1 : 0;
+			timelineSubmitInfo.pWaitSemaphoreValues = &waitValue;
+			timelineSubmitInfo.signalSemaphoreValueCount = 1;
+			timelineSubmitInfo.pSignalSemaphoreValues = &signalValue;
+			VkSubmitInfo submitInfo = { VK_STRUCTURE_TYPE_SUBMIT_INFO };
+			submitInfo.pNext = &timelineSubmitInfo;
+			submitInfo.waitSemaphoreCount = (waitValue > 0) ? 1 : 0;
+			submitInfo.pWaitSemaphores = &waitSemaphore;
+			submitInfo.pWaitDstStageMask = &waitStage;
+			submitInfo.commandBufferCount = 1;
+			submitInfo.pCommandBuffers = &commandBuffer;
+			submitInfo.signalSemaphoreCount = 1;
+			submitInfo.pSignalSemaphores = &signalSemaphore;
+			return vkQueueSubmit(queue, 1, &submitInfo, VK_NULL_HANDLE);
+		}
+		VkResult waitSemaphore(VkSemaphore semaphore, uint64_t value) {
+			VkSemaphoreWaitInfo waitInfo = { VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO };
+			waitInfo.semaphoreCount = 1;
+			waitInfo.pSemaphores = &semaphore;
+			waitInfo.pValues = &value;
+			return vkWaitSemaphores(device, &waitInfo, UINT64_MAX);
+		}
+		//creates pools, semaphores and slots, returns at the first failure and leaves the cleanup to deleteVulkanFFTStream
+		VkResult createStream() {
+			VkResult res = VK_SUCCESS;
+			VkCommandPoolCreateInfo commandPoolCreateInfo = { VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO };
+			commandPoolCreateInfo.queueFamilyIndex = configuration.computeQueueFamilyIndex;
+			res = vkCreateCommandPool(device, &commandPoolCreateInfo, NULL, &computeCommandPool);
+			if (res != VK_SUCCESS) return res;
+			commandPoolCreateInfo.queueFamilyIndex = configuration.transferQueueFamilyIndex;
+			res = vkCreateCommandPool(device, &commandPoolCreateInfo, NULL, &transferCommandPool);
+			if (res != VK_SUCCESS) return res;
+			res = createTimelineSemaphore(&uploadSemaphore);
+			if (res != VK_SUCCESS) return res;
+			res = createTimelineSemaphore(&computeSemaphore);
+			if (res != VK_SUCCESS) return res;
+			res = createTimelineSemaphore(&downloadSemaphore);
+			if (res != VK_SUCCESS) return res;
+
+			slots.resize(configuration.numSlots);
+			for (uint32_t i = 0; i < configuration.numSlots; i++) {
+				VkFFTStreamSlot* slot = &slots[i];
+				res = allocateBuffer(&slot->buffer, &slot->bufferDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, configuration.bufferSize);
+				if (res != VK_SUCCESS) return res;
+				res = allocateBuffer(&slot->uploadBuffer, &slot->uploadBufferMemory, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, configuration.bufferSize);
+				if (res != VK_SUCCESS) return res;
+				res = allocateBuffer(&slot->downloadBuffer, &slot->downloadBufferMemory, VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, configuration.bufferSize);
+				if (res != VK_SUCCESS) return res;
+				res = vkMapMemory(device, slot->uploadBufferMemory, 0, configuration.bufferSize, 0, &slot->uploadData);
+				if (res != VK_SUCCESS) return res;
+				res = vkMapMemory(device, slot->downloadBufferMemory, 0, configuration.bufferSize, 0, &slot->downloadData);
+				if (res != VK_SUCCESS) return res;
+
+				VkFFTConfiguration slotConfiguration = configuration.configuration;
+				slotConfiguration.buffer = &slot->buffer;
+				slotConfiguration.bufferSize = &configuration.bufferSize;
+				slotConfiguration.bufferDeviceMemory = &slot->bufferDeviceMemory;
+				res = slot->app.initializeVulkanFFT(slotConfiguration);
+				if (res != VK_SUCCESS) return res;
+
+				//command buffers are recorded once and resubmitted for every batch that uses the slot
+				VkCommandBufferAllocateInfo commandBufferAllocateInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
+				commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+				commandBufferAllocateInfo.commandBufferCount = 1;
+				commandBufferAllocateInfo.commandPool = transferCommandPool;
+				res = vkAllocateCommandBuffers(device, &commandBufferAllocateInfo, &slot->uploadCommandBuffer);
+				if (res != VK_SUCCESS) return res;
+				res = vkAllocateCommandBuffers(device, &commandBufferAllocateInfo, &slot->downloadCommandBuffer);
+				if (res != VK_SUCCESS) return res;
+				commandBufferAllocateInfo.commandPool = computeCommandPool;
+				res = vkAllocateCommandBuffers(device, &commandBufferAllocateInfo, &slot->computeCommandBuffer);
+				if (res != VK_SUCCESS) return res;
+				recordCopy(slot->uploadCommandBuffer, slot->uploadBuffer, slot->buffer, false);
+				recordCopy(slot->downloadCommandBuffer, slot->buffer, slot->downloadBuffer, true);
+				VkCommandBufferBeginInfo commandBufferBeginInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+				vkBeginCommandBuffer(slot->computeCommandBuffer, &commandBufferBeginInfo);
+				slot->app.VkFFTAppend(slot->computeCommandBuffer);
+				vkEndCommandBuffer(slot->computeCommandBuffer);
+			}
+			return res;
+		}
+	public:
+		VkResult initializeVulkanFFTStream(VkFFTStreamConfiguration inputStreamConfiguration) {
+			configuration = inputStreamConfiguration;
+			if ((configuration.configuration.physicalDevice == 0) || (configuration.computeQueue == 0) || (configuration.numSlots == 0)) {
+				printf("VkFFT stream requires physicalDevice, computeQueue and at least one slot\n");
+				return VK_ERROR_INITIALIZATION_FAILED;
+			}
+			if (configuration.transferQueue == 0) {
+				configuration.transferQueue = configuration.computeQueue;
+				configuration.transferQueueFamilyIndex = configuration.computeQueueFamilyIndex;
+			}
+			device = configuration.configuration.device[0];
+			pushed = 0;
+			popped = 0;
+			VkResult res = createStream();
+			//everything created before the failure is released, the stream can be initialized again
+			if (res != VK_SUCCESS) deleteVulkanFFTStream();
+			return res;
+		}
+		uint32_t inFlight() {
+			return (uint32_t)(pushed - popped);
+		}
+		//Copies one batch to the staging buffer of the next slot and submits its upload, FFT and download. Returns VK_NOT_READY if all slots hold batches that were not popped yet.
+		VkResult push(const void* input) {
+			if (inFlight() == configuration.numSlots) return VK_NOT_READY;
+			VkFFTStreamSlot* slot = &slots[pushed % configuration.numSlots];
+			//previous upload from this slot staging buffer has finished, as its batch was popped
+			memcpy(slot->uploadData, input, configuration.bufferSize);
+			uint64_t batch = pushed + 1;
+			//device buffer of the slot is free once the batch that used it before was downloaded
+			uint64_t previousBatch = (batch > configuration.numSlots) ? batch - configuration.numSlots : 0;
+			VkResult res = submit(configuration.transferQueue[0], slot->uploadCommandBuffer, downloadSemaphore, previousBatch, VK_PIPELINE_STAGE_TRANSFER_BIT, uploadSemaphore, batch);
+			if (res != VK_SUCCESS) return res;
+			res = submit(configuration.computeQueue[0], slot->computeCommandBuffer, uploadSemaphore, batch, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, computeSemaphore, batch);
+			if (res != VK_SUCCESS) return res;
+			res = submit(configuration.transferQueue[0], slot->downloadCommandBuffer, computeSemaphore, batch, VK_PIPELINE_STAGE_TRANSFER_BIT, downloadSemaphore, batch);
+			if (res != VK_SUCCESS) return res;
+			pushed++;
+			return VK_SUCCESS;
+		}
+		//Waits for the oldest batch in flight and copies its result. Batches are returned in the order they were pushed.
+		VkResult pop(void* output) {
+			if (inFlight() == 0) return VK_NOT_READY;
+			VkFFTStreamSlot* slot = &slots[popped % configuration.numSlots];
+			VkResult res = waitSemaphore(downloadSemaphore, popped + 1);
+			if (res != VK_SUCCESS) return res;
+			memcpy(output, slot->downloadData, configuration.bufferSize);
+			popped++;
+			return VK_SUCCESS;
+		}
+		//also releases what a failed initializeVulkanFFTStream created, handles that were never created are null
+		void deleteVulkanFFTStream() {
+			if (device == VK_NULL_HANDLE) return;
+			if ((pushed > 0) && (downloadSemaphore != VK_NULL_HANDLE)) waitSemaphore(downloadSemaphore, pushed);
+			for (uint32_t i = 0; i < slots.size(); i++) {
+				VkFFTStreamSlot* slot = &slots[i];
+				slot->app.deleteVulkanFFT();
+				if (slot->uploadData) vkUnmapMemory(device, slot->uploadBufferMemory);
+				if (slot->downloadData) vkUnmapMemory(device, slot->downloadBufferMemory);
+				VkFFTFreeBuffer(device, &slot->buffer, &slot->bufferDeviceMemory);
+				VkFFTFreeBuffer(device, &slot->uploadBuffer, &slot->uploadBufferMemory);
+				VkFFTFreeBuffer(device, &slot->downloadBuffer, &slot->downloadBufferMemory);
+			}
+			slots.clear();
+			if (uploadSemaphore != VK_NULL_HANDLE) vkDestroySemaphore(device, uploadSemaphore, NULL);
+			if (computeSemaphore != VK_NULL_HANDLE) vkDestroySemaphore(device, computeSemaphore, NULL);
+			if (downloadSemaphore != VK_NULL_HANDLE) vkDestroySemaphore(device, downloadSemaphore, NULL);
+			//command buffers are freed with their pools
+			if (computeCommandPool != VK_NULL_HANDLE) vkDestroyCommandPool(device, computeCommandPool, NULL);
+			if (transferCommandPool != VK_NULL_HANDLE) vkDestroyCommandPool(device, transferCommandPool, NULL);
+			uploadSemaphore = VK_NULL_HANDLE;
+			computeSemaphore = VK_NULL_HANDLE;
+			downloadSemaphore = VK_NULL_HANDLE;
+			computeCommandPool = VK_NULL_HANDLE;
+			transferCommandPool = VK_NULL_HANDLE;
+			pushed = 0;
+			popped = 0;
+			device = VK_NULL_HANDLE;
+		}
+	};
+}
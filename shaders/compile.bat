@@ -19,4 +19,14 @@ glslangvalidator -V vkFFT_single_convolution_symmetric_3x3.comp -o vkFFT_single_
 glslangvalidator -V vkFFT_single_convolution_afterR2C_symmetric_3x3.comp -o vkFFT_single_convolution_afterR2C_symmetric_3x3.spv --target-env spirv1.3
 glslangvalidator -V vkFFT_grouped_convolution_nonsymmetric_3x3.comp -o vkFFT_grouped_convolution_nonsymmetric_3x3.spv --target-env spirv1.3
 glslangvalidator -V vkFFT_single_convolution_nonsymmetric_3x3.comp -o vkFFT_single_convolution_nonsymmetric_3x3.spv --target-env spirv1.3
-glslangvalidator -V vkFFT_single_convolution_afterR2C_nonsymmetric_3x3.comp -o vkFFT_single_convolution_afterR2C_nonsymmetric_3x3.spv --target-env spirv1.3
\ No newline at end of file
+glslangvalidator -V vkFFT_single_convolution_afterR2C_nonsymmetric_3x3.comp -o vkFFT_single_convolution_afterR2C_nonsymmetric_3x3.spv --target-env spirv1.3
+glslangvalidator -V vkFFT_fused_2d_c2c.comp -o vkFFT_fused_2d_c2c.spv --target-env spirv1.3
+glslangvalidator -V vkFFT_convolution_matrix.comp -o vkFFT_convolution_matrix.spv --target-env spirv1.3
+glslangvalidator -V -DANALYTIC_KERNEL vkFFT_convolution_matrix.comp -o vkFFT_convolution_analytic.spv --target-env spirv1.3
+glslangvalidator -V vkFFT_overlap_multiply.comp -o vkFFT_overlap_multiply.spv --target-env spirv1.3
+glslangvalidator -V vkFFT_overlap_add.comp -o vkFFT_overlap_add.spv --target-env spirv1.3
+glslangvalidator -V vkFFT_partitioned_mac.comp -o vkFFT_partitioned_mac.spv --target-env spirv1.3
+glslangvalidator -V -DINPUT_BITS=8 vkFFT_single_c2c.comp -o vkFFT_single_c2c_int8.spv --target-env spirv1.3
+glslangvalidator -V -DINPUT_BITS=16 vkFFT_single_c2c.comp -o vkFFT_single_c2c_int16.spv --target-env spirv1.3
+glslangvalidator -V -DINPUT_BITS=8 vkFFT_single_r2c.comp -o vkFFT_single_r2c_int8.spv --target-env spirv1.3
+glslangvalidator -V -DINPUT_BITS=16 vkFFT_single_r2c.comp -o vkFFT_single_r2c_int16.spv --target-env spirv1.3
\ No newline at end of file
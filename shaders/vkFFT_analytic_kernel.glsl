@@ -0,0 +1,11 @@
+//Kernel spectrum for analytic convolutions, included by vkFFT_convolution_matrix.comp when it is compiled with -DANALYTIC_KERNEL (vkFFT_convolution_analytic.spv, one kernel per shader directory).
+//k - signed frequency indices (k.z = 0 for 2D systems), systemSizeX/Y/Z - system size. Returned value multiplies the unnormalized forward FFT of the data,
+//so it is the FFT of the spatial kernel, not its continuous transform. The kernel[] buffer, if bound, can hold parameters.
+//Default: normalized Gaussian blur of each channel with sigma in grid points.
+const float gaussianSigma = 2.0;
+
+vec2 analyticKernel(ivec3 k, uint outputChannel, uint inputChannel) {
+	if (outputChannel != inputChannel) return vec2(0, 0);
+	vec3 f = vec3(k) / vec3(systemSizeX, systemSizeY, systemSizeZ);
+	return vec2(exp(-2.0 * M_PI * M_PI * gaussianSigma * gaussianSigma * dot(f, f)), 0);
+}
@@ -0,0 +1,42 @@
+//User callbacks, included by the FFT shaders. They are compiled in and called only when configuration.loadCallback/storeCallback is set:
+//loadCallback is applied to every value read by the first pass of VkFFTAppend, storeCallback to every value written by the last one.
+//position - element index in the buffer, in complex numbers, or in real numbers for the real side of r2c/c2r (the *Real versions).
+//consts (strides, offsets, coordinate of the system) are visible here. Values are in the layout of the buffer: with transposes enabled
+//spectra are kept in VkFFT's internal order, so position-dependent spectrum callbacks need performTranspose disabled.
+//The functions are compiled into the FFT shaders, so one shader directory holds one set of callbacks: edit them and rebuild the VkFFT_shaders target,
+//pass run-time parameters through consts or build other callbacks into separate directories and point shaderPath of each plan to one of them.
+//Default: identity. VkFFT_accuracy builds a second set with VKFFT_TEST_CALLBACKS: load doubles the values, store conjugates them.
+
+#ifdef VKFFT_TEST_CALLBACKS
+vec2 loadCallback(vec2 value, uint position) {
+	return 2.0 * value;
+}
+
+vec2 storeCallback(vec2 value, uint position) {
+	return vec2(value.x, -value.y);
+}
+
+float loadCallbackReal(float value, uint position) {
+	return 2.0 * value;
+}
+
+float storeCallbackReal(float value, uint position) {
+	return value;
+}
+#else
+vec2 loadCallback(vec2 value, uint position) {
+	return value;
+}
+
+vec2 storeCallback(vec2 value, uint position) {
+	return value;
+}
+
+float loadCallbackReal(float value, uint position) {
+	return value;
+}
+
+float storeCallbackReal(float value, uint position) {
+	return value;
+}
+#endif
@@ -0,0 +1,20 @@
+//integer input of the forward transform, compiled into the _int8 and _int16 variants of the shaders of its first pass (-DINPUT_BITS=8 or 16).
+//Samples are read as 8 or 16-bit storage, the only traffic of the input, and converted to float and scaled in registers.
+layout (constant_id = 21) const uint inputType = 1;//1 - uint8, 2 - uint16, 3 - int16
+layout (constant_id = 22) const float inputScale = 1.0;
+
+layout(std430, binding = 0) buffer Data {
+#if INPUT_BITS == 8
+    uint8_t inputs[];
+#else
+    uint16_t inputs[];
+#endif
+};
+
+float inputSample(uint position) {
+	uint value = uint(inputs[position]);
+	//sign extension of int16 with 32-bit shifts, no 16-bit arithmetic is needed
+	if (inputType == 3)
+		return inputScale * float(int(value << 16) >> 16);
+	return inputScale * float(value);
+}
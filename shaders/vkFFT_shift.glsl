@@ -0,0 +1,9 @@
+//fftshift of the spectrum as modulation of the spatial side: for even N, X[(k+N/2)%N] is the transform of x[n]*(-1)^n, so the first pass of a forward
+//transform multiplies the input and the last pass of an inverse one the output by (-1) to the sum of coordinates of the shifted axes.
+//shiftX, shiftY and shiftZ are specialization constants of the including shader, all false - no cost.
+//z is the global coordinate, gl_GlobalInvocationID.z plus consts.zOffset of split dispatches.
+
+float shiftSign(uint x, uint y, uint z) {
+	uint n = ((shiftX) ? x : 0) + ((shiftY) ? y : 0) + ((shiftZ) ? z : 0);
+	return ((n & 1) == 0) ? 1.0 : -1.0;
+}
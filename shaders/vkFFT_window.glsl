@@ -0,0 +1,32 @@
+//Window functions for spectral analysis, included by shaders that window their real input. Windows are periodic (DFT-even): sample n of N,
+//so the window of N points is the first N of a symmetric window of N+1 points. Types: 0 - none, 1 - Hann, 2 - Hamming, 3 - Blackman-Harris (4 term), 4 - Kaiser.
+//Coefficients are computed in registers, the type is a specialization constant in the callers, so unused branches are removed.
+
+//modified Bessel function of the first kind, order 0, power series converges for Kaiser beta up to ~30 in 32 terms
+float besselI0(float x) {
+	float term = 1.0;
+	float sum = 1.0;
+	float halfSquare = 0.25 * x * x;
+	for (uint k = 1; k < 32; k++) {
+		term *= halfSquare / float(k * k);
+		sum += term;
+	}
+	return sum;
+}
+
+float windowCoefficient(uint type, uint n, uint N, float kaiserBeta) {
+	float phase = 2.0 * M_PI * float(n) / float(N);
+	switch (type) {
+	case 1:
+		return 0.5 - 0.5 * cos(phase);
+	case 2:
+		return 0.54 - 0.46 * cos(phase);
+	case 3:
+		return 0.35875 - 0.48829 * cos(phase) + 0.14128 * cos(2.0 * phase) - 0.01168 * cos(3.0 * phase);
+	case 4: {
+		float x = 2.0 * float(n) / float(N) - 1.0;
+		return besselI0(kaiserBeta * sqrt(max(1.0 - x * x, 0.0))) / besselI0(kaiserBeta);
+	}
+	}
+	return 1.0;
+}